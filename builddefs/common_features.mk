@@ -135,6 +135,8 @@ ifeq ($(strip $(POINTING_DEVICE_ENABLE)), yes)
         VPATH += $(QUANTUM_DIR)/pointing_device
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device.c
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_auto_mouse.c
+        SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_accumulator.c
+        SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_fusion.c
         ifneq ($(strip $(POINTING_DEVICE_DRIVER)), custom)
             SRC += drivers/sensors/$(strip $(POINTING_DEVICE_DRIVER)).c
             OPT_DEFS += -DPOINTING_DEVICE_DRIVER_$(strip $(shell echo $(POINTING_DEVICE_DRIVER) | tr '[:lower:]' '[:upper:]'))
@@ -640,6 +642,10 @@ ifeq ($(strip $(VIA_ENABLE)), yes)
     ifeq ($(strip $(VIA_INSECURE)), yes)
         OPT_DEFS += -DVIA_INSECURE
     endif
+    ifeq ($(strip $(VIA_BULK_ENABLE)), yes)
+        OPT_DEFS += -DVIA_BULK_ENABLE
+        SRC += $(QUANTUM_DIR)/via_bulk.c
+    endif
 endif
 
 ifeq ($(strip $(RAW_ENABLE)), yes)
@@ -651,6 +657,10 @@ ifeq ($(strip $(DYNAMIC_KEYMAP_ENABLE)), yes)
     SEND_STRING_ENABLE := yes
 endif
 
+ifeq ($(strip $(TASK_SCHEDULER_ENABLE)), yes)
+    DEFERRED_EXEC_ENABLE := yes
+endif
+
 VALID_CUSTOM_MATRIX_TYPES:= yes lite no
 
 CUSTOM_MATRIX ?= no
@@ -694,6 +704,8 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
     # Determine which (if any) transport files are required
     ifneq ($(strip $(SPLIT_TRANSPORT)), custom)
         QUANTUM_SRC += $(QUANTUM_DIR)/split_common/transport.c \
+                       $(QUANTUM_DIR)/split_common/transaction_codec.c \
+                       $(QUANTUM_DIR)/split_common/split_link.c \
                        $(QUANTUM_DIR)/split_common/transactions.c
 
         OPT_DEFS += -DSPLIT_COMMON_TRANSACTIONS
@@ -37,8 +37,10 @@ GENERIC_FEATURES = \
     GRAVE_ESC \
     HAPTIC \
     KEYCODE_STRING \
+    KEYEVENT_QUEUE \
     KEY_LOCK \
     KEY_OVERRIDE \
+    LATENCY_STATS \
     LAYER_LOCK \
     LEADER \
     MAGIC \
@@ -47,12 +49,14 @@ GENERIC_FEATURES = \
     OS_DETECTION \
     PROGRAMMABLE_BUTTON \
     REPEAT_KEY \
+    REPORT_COALESCING \
     SECURE \
     SEND_STRING \
     SEQUENCER \
     SPACE_CADET \
     SWAP_HANDS \
     TAP_DANCE \
+    TASK_SCHEDULER \
     TRI_LAYER \
     VIA \
     VIRTSER \
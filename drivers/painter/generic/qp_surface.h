@@ -21,6 +21,22 @@
 #    define SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef SURFACE_DIRTY_TILE_SIZE
+/**
+ * @def The size in pixels of the square tiles used to track which parts of a surface have been drawn to. Smaller tiles
+ *      track changes more precisely, at the cost of more viewport changes when transferring to the display.
+ */
+#    define SURFACE_DIRTY_TILE_SIZE 16
+#endif
+
+#ifndef SURFACE_DIRTY_TILE_ROWS
+/**
+ * @def The maximum number of rows of dirty tiles tracked per surface. Each row is tracked as a 32-bit mask of columns, so
+ *      up to 32 tiles are tracked horizontally. Pixels beyond the last row or column are tracked by the last tile.
+ */
+#    define SURFACE_DIRTY_TILE_ROWS 32
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -47,6 +47,26 @@ void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y
         dirty->b        = y;
         dirty->is_dirty = true;
     }
+
+    // Maintain dirty tiles, anything past the last row or column belongs to the last tile
+    uint16_t col = MIN(x / SURFACE_DIRTY_TILE_SIZE, SURFACE_DIRTY_TILE_COLS - 1);
+    uint16_t row = MIN(y / SURFACE_DIRTY_TILE_SIZE, SURFACE_DIRTY_TILE_ROWS - 1);
+    dirty->tiles[row] |= (uint32_t)1 << col;
+}
+
+// Number of tile columns or rows needed to cover the given panel dimension
+static uint16_t qp_surface_tile_count(uint16_t panel_size, uint16_t max_tiles) {
+    return MIN((panel_size + SURFACE_DIRTY_TILE_SIZE - 1) / SURFACE_DIRTY_TILE_SIZE, max_tiles);
+}
+
+// First pixel covered by a tile
+static uint16_t qp_surface_tile_start(uint16_t index) {
+    return index * SURFACE_DIRTY_TILE_SIZE;
+}
+
+// Last pixel covered by a tile -- the last tile extends to the edge of the panel
+static uint16_t qp_surface_tile_end(uint16_t index, uint16_t tile_count, uint16_t panel_size) {
+    return (index == tile_count - 1) ? (panel_size - 1) : ((index + 1) * SURFACE_DIRTY_TILE_SIZE - 1);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -62,6 +82,7 @@ bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
     surface->dirty.r        = surface->base.panel_width - 1;
     surface->dirty.b        = surface->base.panel_height - 1;
     surface->dirty.is_dirty = true;
+    memset(surface->dirty.tiles, 0xFF, sizeof(surface->dirty.tiles));
 
     return true;
 }
@@ -83,6 +104,7 @@ bool qp_surface_flush(painter_device_t device) {
     surface->dirty.l = surface->dirty.t = UINT16_MAX;
     surface->dirty.r = surface->dirty.b = 0;
     surface->dirty.is_dirty             = false;
+    memset(surface->dirty.tiles, 0, sizeof(surface->dirty.tiles));
     return true;
 }
 
@@ -105,6 +127,58 @@ bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, u
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Drawing routine to copy out the dirty region and send it to another device
 
+static bool qp_surface_transfer_rect(surface_painter_device_t *surface, painter_driver_t *target_driver, uint16_t x, uint16_t y, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    surface_painter_driver_vtable_t *vtable = (surface_painter_driver_vtable_t *)surface->base.driver_vtable;
+    return vtable->target_pixdata_transfer(&surface->base, target_driver, x, y, l, t, r, b);
+}
+
+// Sends each run of adjacent dirty tiles in a row as a single rectangle, extended downwards over rows with an identical
+// run, so that every transfer pays for only one viewport change
+static bool qp_surface_transfer_dirty_tiles(surface_painter_device_t *surface, painter_driver_t *target_driver, uint16_t x, uint16_t y) {
+    surface_dirty_data_t *dirty     = &surface->dirty;
+    uint16_t              tile_cols = qp_surface_tile_count(surface->base.panel_width, SURFACE_DIRTY_TILE_COLS);
+    uint16_t              tile_rows = qp_surface_tile_count(surface->base.panel_height, SURFACE_DIRTY_TILE_ROWS);
+
+    uint32_t tiles[SURFACE_DIRTY_TILE_ROWS];
+    uint32_t valid = tile_cols == SURFACE_DIRTY_TILE_COLS ? UINT32_MAX : (((uint32_t)1 << tile_cols) - 1);
+    for (uint16_t row = 0; row < tile_rows; ++row) {
+        tiles[row] = dirty->tiles[row] & valid;
+    }
+
+    for (uint16_t row = 0; row < tile_rows; ++row) {
+        while (tiles[row]) {
+            // Find the next run of dirty tiles in this row
+            uint8_t  first = __builtin_ctz(tiles[row]);
+            uint32_t rest  = ~(tiles[row] >> first);
+            uint8_t  count = rest ? __builtin_ctz(rest) : (SURFACE_DIRTY_TILE_COLS - first);
+            uint32_t run   = (count == SURFACE_DIRTY_TILE_COLS ? UINT32_MAX : (((uint32_t)1 << count) - 1)) << first;
+            uint32_t edges = ((run << 1) | (run >> 1)) & ~run;
+            tiles[row] &= ~run;
+
+            // Take the same run from the rows below, as long as it starts and ends in the same place
+            uint16_t last_row = row;
+            while (last_row + 1 < tile_rows && (tiles[last_row + 1] & run) == run && (tiles[last_row + 1] & edges) == 0) {
+                tiles[++last_row] &= ~run;
+            }
+
+            // Tiles only ever cover the dirty region, so clip to it
+            uint16_t l = MAX(qp_surface_tile_start(first), dirty->l);
+            uint16_t t = MAX(qp_surface_tile_start(row), dirty->t);
+            uint16_t r = MIN(qp_surface_tile_end(first + count - 1, tile_cols, surface->base.panel_width), dirty->r);
+            uint16_t b = MIN(qp_surface_tile_end(last_row, tile_rows, surface->base.panel_height), dirty->b);
+            if (l > r || t > b) {
+                continue;
+            }
+
+            if (!qp_surface_transfer_rect(surface, target_driver, x, y, l, t, r, b)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y, bool entire_surface) {
     painter_driver_t         *surface_driver = (painter_driver_t *)surface;
     surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
@@ -123,8 +197,7 @@ bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t
     }
 
     // Offload to the pixdata transfer function
-    surface_painter_driver_vtable_t *vtable = (surface_painter_driver_vtable_t *)surface_driver->driver_vtable;
-    bool                             ok     = vtable->target_pixdata_transfer(surface_driver, target_driver, x, y, entire_surface);
+    bool ok = entire_surface ? qp_surface_transfer_rect(surface_handle, target_driver, x, y, 0, 0, surface_driver->panel_width - 1, surface_driver->panel_height - 1) : qp_surface_transfer_dirty_tiles(surface_handle, target_driver, x, y);
     if (!ok) {
         qp_dprintf("qp_surface_draw: fail (could not transfer pixel data)\n");
         return false;
@@ -13,15 +13,21 @@
 typedef struct surface_painter_driver_vtable_t {
     painter_driver_vtable_t base; // must be first, so it can be cast to/from the painter_driver_vtable_t* type
 
-    bool (*target_pixdata_transfer)(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface);
+    // Transfers the surface region (l,t)-(r,b) inclusive to the target, with the surface's origin at (x,y) on the target
+    bool (*target_pixdata_transfer)(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
 } surface_painter_driver_vtable_t;
 
+#    define SURFACE_DIRTY_TILE_COLS 32
+
 typedef struct surface_dirty_data_t {
     bool     is_dirty;
     uint16_t l;
     uint16_t t;
     uint16_t r;
     uint16_t b;
+
+    // One bit per tile column, for each row of tiles
+    uint32_t tiles[SURFACE_DIRTY_TILE_ROWS];
 } surface_dirty_data_t;
 
 typedef struct surface_viewport_data_t {
@@ -42,6 +42,14 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+uint32_t backing_store_sector_count(void) {
+    return (WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT);
+}
+
+bool backing_store_erase_sector(uint32_t index) {
+    return flash_erase_block(((WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) + index) * (EXTERNAL_FLASH_BLOCK_SIZE)) == FLASH_STATUS_SUCCESS;
+}
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
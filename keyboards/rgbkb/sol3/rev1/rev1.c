@@ -32,6 +32,15 @@ RGB rgb_matrix_hsv_to_rgb(hsv_t hsv) {
     return hsv_to_rgb(hsv);
 }
 
+void rgb_matrix_hsv_to_rgb_batch(hsv_t *hsv, rgb_t *rgb, uint8_t count) {
+    if (limit_lightning) {
+        for (uint8_t i = 0; i < count; i++) {
+            hsv[i].v /= 2;
+        }
+    }
+    hsv_to_rgb_batch(hsv, rgb, count);
+}
+
 bool dip_switch_update_kb(uint8_t index, bool active) {
     if (!dip_switch_update_user(index, active))
         return false;
@@ -87,7 +87,7 @@ void keyboard_post_init_kb(void) {
 // RGB brightness scaling dependent on USBPD state
 
 #if defined(RGB_MATRIX_ENABLE)
-rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
+static float djinn_rgb_scale(void) {
     float scale;
 
 #    ifdef DJINN_SUPPORTS_3A_FUSE
@@ -118,9 +118,21 @@ rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
     }
 #    endif
 
-    hsv.v = (uint8_t)(hsv.v * scale);
+    return scale;
+}
+
+rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
+    hsv.v = (uint8_t)(hsv.v * djinn_rgb_scale());
     return hsv_to_rgb(hsv);
 }
+
+void rgb_matrix_hsv_to_rgb_batch(hsv_t *hsv, rgb_t *rgb, uint8_t count) {
+    float scale = djinn_rgb_scale();
+    for (uint8_t i = 0; i < count; i++) {
+        hsv[i].v = (uint8_t)(hsv[i].v * scale);
+    }
+    hsv_to_rgb_batch(hsv, rgb, count);
+}
 #endif
 
 //----------------------------------------------------------
@@ -125,6 +125,35 @@ inline uint32_t timer_read32(void) {
     return t;
 }
 
+#if defined(__AVR_ATmega32A__)
+#    define TIMER_COMPARE_PENDING() (TIFR & _BV(OCF0))
+#elif defined(__AVR_ATtiny85__)
+#    define TIMER_COMPARE_PENDING() (TIFR & _BV(OCF0A))
+#else
+#    define TIMER_COMPARE_PENDING() (TIFR0 & _BV(OCF0A))
+#endif
+
+/** \brief timer read microseconds
+ *
+ * Millisecond count extended with the position of timer0 within the current millisecond.
+ */
+uint32_t timer_read_us(void) {
+    uint32_t ms;
+    uint8_t  raw;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms  = timer_count;
+        raw = TIMER_RAW;
+        if (TIMER_COMPARE_PENDING()) {
+            // timer0 wrapped but the interrupt has not counted it yet
+            ms++;
+            raw = TIMER_RAW;
+        }
+    }
+
+    return ms * 1000 + (uint32_t)raw * 1000 / (TIMER_RAW_TOP + 1);
+}
+
 // excecuted once per 1ms.(excess for just timer count?)
 #ifndef __AVR_ATmega32A__
 #    define TIMER_INTERRUPT_VECTOR TIMER0_COMPA_vect
@@ -134,6 +134,35 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+uint32_t backing_store_sector_count(void) {
+    // Sectors can differ in size, only erase them individually when they split the backing store evenly
+    for (flash_sector_t i = 0; i < sector_count; ++i) {
+        if (flashGetSectorSize(flash, first_sector + i) * sector_count != (WEAR_LEVELING_BACKING_SIZE)) {
+            return 1;
+        }
+    }
+    return sector_count;
+}
+
+bool backing_store_erase_sector(uint32_t index) {
+    bool          ret = true;
+    flash_error_t status;
+
+    // Kick off the sector erase
+    status = flashStartEraseSector(flash, first_sector + index);
+    if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+        ret = false;
+    }
+
+    // Wait for the erase to complete
+    status = flashWaitErase(flash);
+    if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+        ret = false;
+    }
+
+    return ret;
+}
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
@@ -37,6 +37,14 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+uint32_t backing_store_sector_count(void) {
+    return (WEAR_LEVELING_LEGACY_EMULATION_PAGE_COUNT) * (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE) == (WEAR_LEVELING_BACKING_SIZE) ? (WEAR_LEVELING_LEGACY_EMULATION_PAGE_COUNT) : 1;
+}
+
+bool backing_store_erase_sector(uint32_t index) {
+    return FLASH_ErasePage(WEAR_LEVELING_LEGACY_EMULATION_BASE_PAGE_ADDRESS + (index * (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE))) == FLASH_COMPLETE;
+}
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = ((WEAR_LEVELING_LEGACY_EMULATION_BASE_PAGE_ADDRESS) + address);
     bs_dprintf("Write ");
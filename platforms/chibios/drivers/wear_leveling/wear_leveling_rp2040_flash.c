@@ -190,6 +190,17 @@ bool backing_store_erase(void) {
     return true;
 }
 
+uint32_t backing_store_sector_count(void) {
+    return (WEAR_LEVELING_BACKING_SIZE) / (FLASH_SECTOR_SIZE);
+}
+
+bool backing_store_erase_sector(uint32_t index) {
+    interrupts = save_and_disable_interrupts();
+    flash_range_erase((WEAR_LEVELING_RP2040_FLASH_BASE) + index * (FLASH_SECTOR_SIZE), (FLASH_SECTOR_SIZE));
+    restore_interrupts(interrupts);
+    return true;
+}
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
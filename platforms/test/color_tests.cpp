@@ -0,0 +1,63 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "color.h"
+}
+
+// One row of 256 values per (h, s) pair, covering every v.
+static std::vector<hsv_t> hsv_row(uint8_t h, uint8_t s) {
+    std::vector<hsv_t> hsv;
+    hsv.reserve(256);
+    for (int v = 0; v < 256; v++) {
+        hsv.push_back({h, s, (uint8_t)v});
+    }
+    return hsv;
+}
+
+static void expect_matches_scalar(bool use_cie) {
+    rgb_t rgb[256];
+    for (int h = 0; h < 256; h++) {
+        for (int s = 0; s < 256; s++) {
+            std::vector<hsv_t> hsv = hsv_row(h, s);
+            if (use_cie) {
+                hsv_to_rgb_batch(hsv.data(), rgb, hsv.size());
+            } else {
+                hsv_to_rgb_batch_nocie(hsv.data(), rgb, hsv.size());
+            }
+            for (int v = 0; v < 256; v++) {
+                rgb_t expected = use_cie ? hsv_to_rgb(hsv[v]) : hsv_to_rgb_nocie(hsv[v]);
+                ASSERT_EQ(rgb[v].r, expected.r) << "h=" << h << " s=" << s << " v=" << v;
+                ASSERT_EQ(rgb[v].g, expected.g) << "h=" << h << " s=" << s << " v=" << v;
+                ASSERT_EQ(rgb[v].b, expected.b) << "h=" << h << " s=" << s << " v=" << v;
+            }
+        }
+    }
+}
+
+TEST(Color, BatchMatchesScalarForEveryInput) {
+    expect_matches_scalar(true);
+}
+
+TEST(Color, BatchNoCieMatchesScalarForEveryInput) {
+    expect_matches_scalar(false);
+}
+
+TEST(Color, BatchLeavesTrailingOutputUntouched) {
+    hsv_t hsv[3] = {{0, 255, 255}, {85, 255, 255}, {170, 255, 255}};
+    rgb_t rgb[4] = {};
+    rgb[2]       = {1, 2, 3};
+    rgb[3]       = {1, 2, 3};
+
+    hsv_to_rgb_batch_nocie(hsv, rgb, 2);
+    EXPECT_EQ(rgb[0].r, 255);
+    EXPECT_EQ(rgb[1].g, 255);
+    EXPECT_EQ(rgb[2].r, 1);
+    EXPECT_EQ(rgb[3].b, 3);
+
+    hsv_to_rgb_batch_nocie(hsv, rgb, 0);
+    EXPECT_EQ(rgb[2].g, 2);
+}
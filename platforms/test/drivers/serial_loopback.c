@@ -0,0 +1,75 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "serial.h"
+#include "serial_loopback.h"
+
+static split_shared_memory_t   slave_memory;
+static split_shared_memory_t   master_memory;
+static serial_loopback_stats_t stats;
+static uint32_t                pending_failures;
+
+void serial_loopback_reset(void) {
+    memset(split_shmem, 0, sizeof(split_shared_memory_t));
+    memset(&slave_memory, 0, sizeof(slave_memory));
+    memset(&stats, 0, sizeof(stats));
+    pending_failures = 0;
+}
+
+void serial_loopback_fail_next(uint32_t count) {
+    pending_failures = count;
+}
+
+void serial_loopback_slave_begin(void) {
+    memcpy(&master_memory, split_shmem, sizeof(split_shared_memory_t));
+    memcpy(split_shmem, &slave_memory, sizeof(split_shared_memory_t));
+}
+
+void serial_loopback_slave_end(void) {
+    memcpy(&slave_memory, split_shmem, sizeof(split_shared_memory_t));
+    memcpy(split_shmem, &master_memory, sizeof(split_shared_memory_t));
+}
+
+serial_loopback_stats_t serial_loopback_get_stats(void) {
+    return stats;
+}
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int index) {
+    if (index < 0 || index >= NUM_TOTAL_TRANSACTIONS) {
+        return false;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[index];
+
+    stats.transactions++;
+    stats.bytes += 2;
+    if (pending_failures > 0) {
+        pending_failures--;
+        stats.failures++;
+        return false;
+    }
+
+    // The master's buffer goes across to the slave.
+    uint8_t m2s_size = trans->initiator2target_buffer_size;
+    memcpy(((uint8_t *)&slave_memory) + trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), m2s_size);
+    stats.bytes += m2s_size;
+
+    serial_loopback_slave_begin();
+    if (trans->slave_callback) {
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+    }
+    serial_loopback_slave_end();
+
+    // As in the serial protocol, the response size is only looked at once the slave callback has run.
+    uint8_t s2m_size = trans->target2initiator_buffer_size;
+    memcpy(split_trans_target2initiator_buffer(trans), ((uint8_t *)&slave_memory) + trans->target2initiator_offset, s2m_size);
+    stats.bytes += s2m_size;
+
+    return true;
+}
@@ -0,0 +1,43 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Split transport loopback for host tests.
+ *
+ * Both halves run in the same process. The loopback keeps a separate copy of
+ * the slave's shared memory and swaps it in while slave code runs, so
+ * transactions behave as if they had crossed a real link. Traffic is
+ * counted as the ChibiOS serial protocol would put it on the wire: one
+ * transaction id byte, one handshake byte, then the buffers.
+ */
+
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t failures;
+} serial_loopback_stats_t;
+
+/**
+ * @brief Clear both halves' shared memory, the statistics and any injected failures.
+ */
+void serial_loopback_reset(void);
+
+/**
+ * @brief Make the next `count` transactions fail after the handshake.
+ */
+void serial_loopback_fail_next(uint32_t count);
+
+/**
+ * @brief Swap the slave's shared memory in, so that slave-side code
+ * (e.g. transactions_slave()) can be called. Must be paired with
+ * serial_loopback_slave_end().
+ */
+void serial_loopback_slave_begin(void);
+void serial_loopback_slave_end(void);
+
+serial_loopback_stats_t serial_loopback_get_stats(void);
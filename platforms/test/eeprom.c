@@ -15,8 +15,25 @@
  */
 
 #include "eeprom.h"
+#include "eeprom_test.h"
 
-static uint8_t buffer[TOTAL_EEPROM_BYTE_COUNT];
+static uint8_t  buffer[TOTAL_EEPROM_BYTE_COUNT];
+static uint32_t write_count = 0;
+
+uint32_t eeprom_test_get_write_count(void) {
+    return write_count;
+}
+
+void eeprom_test_reset_write_count(void) {
+    write_count = 0;
+}
+
+static void buffer_write(uint8_t *addr, const uint8_t *src, size_t len) {
+    uintptr_t offset = (uintptr_t)addr;
+    while (len--) {
+        buffer[offset++] = *src++;
+    }
+}
 
 uint8_t eeprom_read_byte(const uint8_t *addr) {
     uintptr_t offset = (uintptr_t)addr;
@@ -24,8 +41,8 @@ uint8_t eeprom_read_byte(const uint8_t *addr) {
 }
 
 void eeprom_write_byte(uint8_t *addr, uint8_t value) {
-    uintptr_t offset = (uintptr_t)addr;
-    buffer[offset]   = value;
+    write_count++;
+    buffer_write(addr, &value, sizeof(value));
 }
 
 uint16_t eeprom_read_word(const uint16_t *addr) {
@@ -47,25 +64,20 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 }
 
 void eeprom_write_word(uint16_t *addr, uint16_t value) {
-    uint8_t *p = (uint8_t *)addr;
-    eeprom_write_byte(p++, value);
-    eeprom_write_byte(p, value >> 8);
+    uint8_t bytes[] = {value, value >> 8};
+    write_count++;
+    buffer_write((uint8_t *)addr, bytes, sizeof(bytes));
 }
 
 void eeprom_write_dword(uint32_t *addr, uint32_t value) {
-    uint8_t *p = (uint8_t *)addr;
-    eeprom_write_byte(p++, value);
-    eeprom_write_byte(p++, value >> 8);
-    eeprom_write_byte(p++, value >> 16);
-    eeprom_write_byte(p, value >> 24);
+    uint8_t bytes[] = {value, value >> 8, value >> 16, value >> 24};
+    write_count++;
+    buffer_write((uint8_t *)addr, bytes, sizeof(bytes));
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
-    uint8_t       *p   = (uint8_t *)addr;
-    const uint8_t *src = (const uint8_t *)buf;
-    while (len--) {
-        eeprom_write_byte(p++, *src++);
-    }
+    write_count++;
+    buffer_write((uint8_t *)addr, (const uint8_t *)buf, len);
 }
 
 void eeprom_update_byte(uint8_t *addr, uint8_t value) {
@@ -73,23 +85,13 @@ void eeprom_update_byte(uint8_t *addr, uint8_t value) {
 }
 
 void eeprom_update_word(uint16_t *addr, uint16_t value) {
-    uint8_t *p = (uint8_t *)addr;
-    eeprom_write_byte(p++, value);
-    eeprom_write_byte(p, value >> 8);
+    eeprom_write_word(addr, value);
 }
 
 void eeprom_update_dword(uint32_t *addr, uint32_t value) {
-    uint8_t *p = (uint8_t *)addr;
-    eeprom_write_byte(p++, value);
-    eeprom_write_byte(p++, value >> 8);
-    eeprom_write_byte(p++, value >> 16);
-    eeprom_write_byte(p, value >> 24);
+    eeprom_write_dword(addr, value);
 }
 
 void eeprom_update_block(const void *buf, void *addr, size_t len) {
-    uint8_t       *p   = (uint8_t *)addr;
-    const uint8_t *src = (const uint8_t *)buf;
-    while (len--) {
-        eeprom_write_byte(p++, *src++);
-    }
+    eeprom_write_block(buf, addr, len);
 }
@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Number of write/update calls made to the test EEPROM, each standing in for one backing store operation.
+ */
+uint32_t eeprom_test_get_write_count(void);
+void     eeprom_test_reset_write_count(void);
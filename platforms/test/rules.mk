@@ -23,3 +23,13 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+color_SRC := \
+	$(QUANTUM_PATH)/color.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/color_tests.cpp
+
+color_cie_DEFS := -DUSE_CIE1931_CURVE
+color_cie_SRC := \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/led_tables.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/color_tests.cpp
@@ -1 +1 @@
-TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large
+TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large color color_cie
@@ -539,6 +539,7 @@ void process_action(keyrecord_t *record, action_t action) {
                     } else {
                         if (tap_count > 0) {
                             ac_dprintf("MODS_TAP: Tap: unregister_code\n");
+                            host_flush_reports();
                             if (action.layer_tap.code == KC_CAPS_LOCK) {
                                 wait_ms(TAP_HOLD_CAPS_DELAY);
                             } else {
@@ -720,6 +721,7 @@ void process_action(keyrecord_t *record, action_t action) {
                     } else {
                         if (tap_count > 0) {
                             ac_dprintf("KEYMAP_TAP_KEY: Tap: unregister_code\n");
+                            host_flush_reports();
                             if (action.layer_tap.code == KC_CAPS_LOCK) {
                                 wait_ms(TAP_HOLD_CAPS_DELAY);
                             } else {
@@ -737,6 +739,7 @@ void process_action(keyrecord_t *record, action_t action) {
                         register_code(action.layer_tap.code);
                     } else {
                         ac_dprintf("KEYMAP_TAP_KEY: Tap: unregister_code\n");
+                        host_flush_reports();
                         if (action.layer_tap.code == KC_CAPS) {
                             wait_ms(TAP_HOLD_CAPS_DELAY);
                         } else {
@@ -810,6 +813,7 @@ void process_action(keyrecord_t *record, action_t action) {
                         if (event.pressed) {
                             register_code(action.swap.code);
                         } else {
+                            host_flush_reports();
                             wait_ms(TAP_CODE_DELAY);
                             unregister_code(action.swap.code);
                             *record = (keyrecord_t){}; // hack: reset tap mode
@@ -876,8 +880,10 @@ void process_action(keyrecord_t *record, action_t action) {
                     process_auto_shift(action.layer_tap.code, record);
 #        else
                     register_mods(retro_tap_curr_mods);
+                    host_flush_reports();
                     wait_ms(TAP_CODE_DELAY);
                     tap_code(action.layer_tap.code);
+                    host_flush_reports();
                     wait_ms(TAP_CODE_DELAY);
                     unregister_mods(retro_tap_curr_mods);
 #        endif
@@ -929,6 +935,7 @@ __attribute__((weak)) void register_code(uint8_t code) {
 #    endif
         add_key(KC_CAPS_LOCK);
         send_keyboard_report();
+        host_flush_reports();
         wait_ms(TAP_HOLD_CAPS_DELAY);
         del_key(KC_CAPS_LOCK);
         send_keyboard_report();
@@ -939,6 +946,7 @@ __attribute__((weak)) void register_code(uint8_t code) {
 #    endif
         add_key(KC_NUM_LOCK);
         send_keyboard_report();
+        host_flush_reports();
         wait_ms(100);
         del_key(KC_NUM_LOCK);
         send_keyboard_report();
@@ -949,6 +957,7 @@ __attribute__((weak)) void register_code(uint8_t code) {
 #    endif
         add_key(KC_SCROLL_LOCK);
         send_keyboard_report();
+        host_flush_reports();
         wait_ms(100);
         del_key(KC_SCROLL_LOCK);
         send_keyboard_report();
@@ -1047,6 +1056,7 @@ __attribute__((weak)) void unregister_code(uint8_t code) {
  */
 __attribute__((weak)) void tap_code_delay(uint8_t code, uint16_t delay) {
     register_code(code);
+    host_flush_reports();
     wait_ms(delay);
     unregister_code(code);
 }
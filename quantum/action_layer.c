@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -46,6 +47,7 @@ static void default_layer_state_set(layer_state_t state) {
     default_layer_debug();
     ac_dprintf(" to ");
     default_layer_state = state;
+    layer_resolution_cache_invalidate();
     default_layer_debug();
     ac_dprintf("\n");
 #if defined(STRICT_LAYER_RELEASE)
@@ -136,6 +138,7 @@ void layer_state_set(layer_state_t state) {
     layer_debug();
     ac_dprintf(" to ");
     layer_state = state;
+    layer_resolution_cache_invalidate();
     layer_debug();
     ac_dprintf("\n");
 #    if defined(STRICT_LAYER_RELEASE)
@@ -335,16 +338,15 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#if !defined(NO_ACTION_LAYER)
+/** \brief Resolve layer
  *
- * Gets the layer based on key info
+ * Walks the given layer stack from the top and returns the first layer with a non-transparent action for the key
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
+static uint8_t resolve_layer(keypos_t key, layer_state_t layers) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -356,6 +358,71 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_RESOLUTION_CACHE)
+#    define RESOLVED_LAYER_INVALID UINT8_MAX
+
+/** \brief resolved layer cache
+ *
+ * Effective layer per matrix position, filled lazily for the layer stack in resolved_layer_cache_state
+ */
+static uint8_t       resolved_layer_cache[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t resolved_layer_cache_state = 0;
+static bool          resolved_layer_cache_valid = false;
+
+/** \brief Layer resolution cache invalidate
+ *
+ * Drops every cached entry, they are recomputed on the next lookup
+ */
+void layer_resolution_cache_invalidate(void) {
+    resolved_layer_cache_valid = false;
+}
+
+/** \brief Layer resolution cache invalidate key
+ *
+ * Drops the cached entry of a single matrix position, for example after its keycode was changed
+ */
+void layer_resolution_cache_invalidate_key(uint8_t row, uint8_t col) {
+    if (row < MATRIX_ROWS && col < MATRIX_COLS) {
+        resolved_layer_cache[row][col] = RESOLVED_LAYER_INVALID;
+    }
+}
+
+/** \brief Read resolved layer cache
+ *
+ * Returns the cached layer for the key, resolving and storing it on a miss
+ */
+static uint8_t read_resolved_layer_cache(keypos_t key, layer_state_t layers) {
+    // layer_state may have been assigned directly, so the stack is compared as well
+    if (!resolved_layer_cache_valid || resolved_layer_cache_state != layers) {
+        memset(resolved_layer_cache, RESOLVED_LAYER_INVALID, sizeof(resolved_layer_cache));
+        resolved_layer_cache_state = layers;
+        resolved_layer_cache_valid = true;
+    }
+
+    uint8_t *entry = &resolved_layer_cache[key.row][key.col];
+    if (*entry == RESOLVED_LAYER_INVALID) {
+        *entry = resolve_layer(key, layers);
+    }
+    return *entry;
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+#    ifdef LAYER_RESOLUTION_CACHE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        return read_resolved_layer_cache(key, layers);
+    }
+#    endif
+    return resolve_layer(key, layers);
 #else
     return get_highest_layer(default_layer_state);
 #endif
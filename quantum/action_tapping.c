@@ -5,6 +5,7 @@
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "action_util.h"
+#include "host.h"
 #include "keycode.h"
 #include "keycode_config.h"
 #include "quantum_keycodes.h"
@@ -871,6 +872,7 @@ void speculative_key_settled(keyrecord_t *record) {
         }
 
         send_keyboard_report();
+        host_flush_reports();
         wait_ms(TAP_CODE_DELAY);
 
         ac_dprintf("Speculative Hold: canceled %02x, ", cleared_mods);
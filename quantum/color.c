@@ -108,3 +108,70 @@ rgb_t hsv_to_rgb(hsv_t hsv) {
 rgb_t hsv_to_rgb_nocie(hsv_t hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
+
+// Byte offset of each output channel (r, g, b) within the packed
+// {v, p, q, t} word for each hue region. Region 6 only occurs for h == 255
+// and matches region 0.
+#define HSV_REGION_MAP(r, g, b) ((r) * 8 | (g) * 8 << 8 | (uint32_t)(b) * 8 << 16)
+static const uint32_t hsv_region_map[7] PROGMEM = {
+    HSV_REGION_MAP(0, 3, 1), // v, t, p
+    HSV_REGION_MAP(2, 0, 1), // q, v, p
+    HSV_REGION_MAP(1, 0, 3), // p, v, t
+    HSV_REGION_MAP(1, 2, 0), // p, q, v
+    HSV_REGION_MAP(3, 1, 0), // t, p, v
+    HSV_REGION_MAP(0, 1, 2), // v, p, q
+    HSV_REGION_MAP(0, 3, 1), // v, t, p
+};
+
+/* Branch-free equivalent of the arithmetic in hsv_to_rgb_impl(), with v
+ * already passed through the CIE curve when requested. The four candidate
+ * channel values are packed into one word and the region switch becomes a
+ * table of shift amounts; the grey (s == 0) case is folded in with a mask.
+ */
+static inline rgb_t hsv_to_rgb_kernel(uint8_t h, uint8_t s, uint8_t v) {
+    uint8_t  region    = (uint16_t)h * 6 / 255;
+    uint8_t  remainder = (h * 2 - region * 85) * 3;
+    uint32_t grey      = v * 0x01010101UL;
+    uint32_t mask      = -(uint32_t)(s != 0);
+
+    // The products below reach 255 * 255, which overflows a 16-bit int on
+    // AVR, so one operand is always widened to uint16_t as in hsv_to_rgb_impl().
+    uint32_t p      = ((uint16_t)v * (255 - s)) >> 8;
+    uint32_t q      = ((uint16_t)v * (255 - (((uint16_t)s * remainder) >> 8))) >> 8;
+    uint32_t t      = ((uint16_t)v * (255 - (((uint16_t)s * (255 - remainder)) >> 8))) >> 8;
+    uint32_t packed = ((v | p << 8 | q << 16 | t << 24) & mask) | (grey & ~mask);
+
+    uint32_t map = pgm_read_dword(&hsv_region_map[region]);
+    rgb_t    rgb = {
+           .r = packed >> (map & 0xFF),
+           .g = packed >> ((map >> 8) & 0xFF),
+           .b = packed >> (map >> 16),
+    };
+    return rgb;
+}
+
+static void hsv_to_rgb_batch_impl(const hsv_t *hsv, rgb_t *rgb, uint16_t count, bool use_cie) {
+#ifdef USE_CIE1931_CURVE
+    if (use_cie) {
+        for (uint16_t i = 0; i < count; i++) {
+            rgb[i] = hsv_to_rgb_kernel(hsv[i].h, hsv[i].s, pgm_read_byte(&CIE1931_CURVE[hsv[i].v]));
+        }
+        return;
+    }
+#endif
+    for (uint16_t i = 0; i < count; i++) {
+        rgb[i] = hsv_to_rgb_kernel(hsv[i].h, hsv[i].s, hsv[i].v);
+    }
+}
+
+void hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint16_t count) {
+#ifdef USE_CIE1931_CURVE
+    hsv_to_rgb_batch_impl(hsv, rgb, count, true);
+#else
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+#endif
+}
+
+void hsv_to_rgb_batch_nocie(const hsv_t *hsv, rgb_t *rgb, uint16_t count) {
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+}
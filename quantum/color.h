@@ -95,3 +95,12 @@ typedef hsv_t HSV;
 
 rgb_t hsv_to_rgb(hsv_t hsv);
 rgb_t hsv_to_rgb_nocie(hsv_t hsv);
+
+/**
+ * Convert `count` HSV values to RGB in one pass.
+ *
+ * Produces exactly the same output as calling hsv_to_rgb() (or
+ * hsv_to_rgb_nocie()) on each element, without per-pixel branching.
+ */
+void hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint16_t count);
+void hsv_to_rgb_batch_nocie(const hsv_t *hsv, rgb_t *rgb, uint16_t count);
@@ -9,34 +9,130 @@
 #    define MAX_DEFERRED_EXECUTORS 8
 #endif
 
+// Every slot needs at least two generations of tokens, so a reused slot doesn't accept the token it had before
+#define DEFERRED_EXEC_MAX_TABLE_SIZE ((UINT16_MAX + 1) / 3)
+
+_Static_assert(MAX_DEFERRED_EXECUTORS <= DEFERRED_EXEC_MAX_TABLE_SIZE, "MAX_DEFERRED_EXECUTORS is too large");
+
 //------------------------------------
 // Helpers
 //
+// Each table is kept as a binary min-heap ordered by trigger time. Entries never move between slots, so callbacks
+// and cb_args stay put and a token can be resolved to its slot directly: token = generation * table_count + slot.
+// The heap itself is a permutation of slot indices threaded through the table -- `heap_slot` of entry i names the
+// slot at heap position i, and `heap_index` of a slot is its heap position. Both are stored XOR'ed with their own
+// index, so a zero-initialised table is the identity permutation. Heap positions [0, n) hold the n active slots,
+// positions [n, table_count) hold the free ones. A free slot has no callback, and keeps its last token so the next
+// one handed out for it moves on to the following generation.
+//
+// A repeating executor that is still due after being re-armed is marked `overdue` for the rest of the pass, which
+// sorts it after every unmarked one, so it catches up by one invocation per pass instead of running back to back.
+//
 
-static deferred_token current_token = 0;
+static inline size_t slot_at(deferred_executor_t *table, size_t pos) {
+    return table[pos].heap_slot ^ pos;
+}
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
+static inline size_t position_of(deferred_executor_t *table, size_t slot) {
+    return table[slot].heap_index ^ slot;
+}
+
+static inline void place(deferred_executor_t *table, size_t pos, size_t slot) {
+    table[pos].heap_slot   = slot ^ pos;
+    table[slot].heap_index = pos ^ slot;
+}
+
+static inline bool triggers_before(deferred_executor_t *table, size_t pos_a, size_t pos_b) {
+    deferred_executor_t *a = &table[slot_at(table, pos_a)];
+    deferred_executor_t *b = &table[slot_at(table, pos_b)];
+    if (a->overdue != b->overdue) {
+        return b->overdue;
     }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
+    return ((int32_t)TIMER_DIFF_32(a->trigger_time, b->trigger_time)) < 0;
+}
+
+static inline void swap_positions(deferred_executor_t *table, size_t pos_a, size_t pos_b) {
+    size_t slot_a = slot_at(table, pos_a);
+    place(table, pos_a, slot_at(table, pos_b));
+    place(table, pos_b, slot_a);
+}
+
+static size_t heap_size(deferred_executor_t *table, size_t table_count) {
+    // Active slots occupy a prefix of the heap, so the boundary can be found with a binary search
+    size_t lo = 0, hi = table_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (table[slot_at(table, mid)].callback) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
-    return true;
+    return lo;
+}
+
+static void sift_up(deferred_executor_t *table, size_t pos) {
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!triggers_before(table, pos, parent)) {
+            break;
+        }
+        swap_positions(table, pos, parent);
+        pos = parent;
+    }
 }
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
-    deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
-        ++current_token;
-        if (current_token == first) {
-            // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
-            return INVALID_DEFERRED_TOKEN;
+static void sift_down(deferred_executor_t *table, size_t count, size_t pos) {
+    while (true) {
+        size_t first    = pos;
+        size_t children = 2 * pos + 1;
+        for (size_t child = children; child < children + 2 && child < count; ++child) {
+            if (triggers_before(table, child, first)) {
+                first = child;
+            }
+        }
+        if (first == pos) {
+            break;
         }
+        swap_positions(table, pos, first);
+        pos = first;
+    }
+}
+
+static inline void reschedule(deferred_executor_t *table, size_t count, size_t slot) {
+    size_t pos = position_of(table, slot);
+    sift_up(table, pos);
+    sift_down(table, count, position_of(table, slot));
+}
+
+static void release_slot(deferred_executor_t *table, size_t table_count, size_t slot) {
+    size_t count = heap_size(table, table_count);
+    size_t pos   = position_of(table, slot);
+
+    // Move the last active slot into the hole, and the released slot into the free region
+    swap_positions(table, pos, count - 1);
+
+    deferred_executor_t *entry = &table[slot];
+    entry->overdue             = false;
+    entry->trigger_time        = 0;
+    entry->callback            = NULL;
+    entry->cb_arg              = NULL;
+
+    if (pos < count - 1) {
+        reschedule(table, count - 1, slot_at(table, pos));
     }
-    return current_token;
+}
+
+static inline deferred_executor_t *find_token(deferred_executor_t *table, size_t table_count, deferred_token token) {
+    size_t slot = token % table_count;
+    return table[slot].callback && table[slot].token == token ? &table[slot] : NULL;
+}
+
+static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count, size_t slot) {
+    // Each slot cycles through its own generations, so a stale token only matches again once they wrap around
+    size_t generations = (UINT16_MAX - table_count + 1) / table_count;
+    size_t generation  = (table[slot].token / table_count) % generations + 1;
+    return (deferred_token)(generation * table_count + slot);
 }
 
 //------------------------------------
@@ -45,31 +141,27 @@ static inline deferred_token allocate_token(deferred_executor_t *table, size_t t
 
 deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_count, uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
-    if (!table || table_count == 0 || delay_ms == 0 || !callback) {
+    if (!table || table_count == 0 || table_count > DEFERRED_EXEC_MAX_TABLE_SIZE || delay_ms == 0 || !callback) {
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
-
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
-        }
+    // The first free slot sits just past the end of the heap
+    size_t count = heap_size(table, table_count);
+    if (count == table_count) {
+        // None available
+        return INVALID_DEFERRED_TOKEN;
     }
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Set up the executor table entry
+    size_t               slot  = slot_at(table, count);
+    deferred_executor_t *entry = &table[slot];
+    entry->token               = allocate_token(table, table_count, slot);
+    entry->overdue             = false;
+    entry->trigger_time        = timer_read32() + delay_ms;
+    entry->callback            = callback;
+    entry->cb_arg              = cb_arg;
+    sift_up(table, count);
+    return entry->token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
@@ -79,17 +171,16 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    deferred_executor_t *entry = find_token(table, table_count, token);
+    if (!entry) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    entry->trigger_time = timer_read32() + delay_ms;
+    reschedule(table, heap_size(table, table_count), entry - table);
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
@@ -99,20 +190,15 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    deferred_executor_t *entry = find_token(table, table_count, token);
+    if (!entry) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    release_slot(table, table_count, entry - table);
+    return true;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
@@ -122,34 +208,55 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
-            deferred_executor_t *entry      = &table[i];
+        // Only the earliest trigger needs checking; if that isn't due, nothing else is either
+        deferred_executor_t *first = &table[slot_at(table, 0)];
+        if (!first->callback || ((int32_t)TIMER_DIFF_32(first->trigger_time, now)) > 0) {
+            return;
+        }
+
+        // Each executor that was pending at the start gets at most one invocation per pass, same as a full table scan
+        bool any_overdue = false;
+        while (true) {
+            size_t               slot       = slot_at(table, 0);
+            deferred_executor_t *entry      = &table[slot];
             deferred_token       curr_token = entry->token;
+            if (!entry->callback || entry->overdue || ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) > 0) {
+                break;
+            }
+
+            // Invoke the callback and work work out if we should be requeued
+            uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
 
-            // Check if we're supposed to execute this entry
-            if (curr_token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+            // If the slot was freed or the token has changed, then the callback has canceled and maybe re-queued. Skip further processing.
+            if (!entry->callback || entry->token != curr_token) {
+                continue;
+            }
 
-                // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
-                if (entry->token != curr_token) {
-                    continue;
+            // Update the trigger time if we have to repeat, otherwise clear it out
+            if (delay_ms > 0) {
+                // Intentionally add just the delay to the existing trigger time -- this ensures the next
+                // invocation is with respect to the previous trigger, rather than when it got to execution. Under
+                // normal circumstances this won't cause issue, but if another executor is invoked that takes a
+                // considerable length of time, then this ensures best-effort timing between invocations.
+                entry->trigger_time += delay_ms;
+                if (((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
+                    // Still behind, leave the rest of the catching up to later passes
+                    entry->overdue = true;
+                    any_overdue    = true;
                 }
+                reschedule(table, heap_size(table, table_count), slot);
+            } else {
+                // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
+                release_slot(table, table_count, slot);
+            }
+        }
 
-                // Update the trigger time if we have to repeat, otherwise clear it out
-                if (delay_ms > 0) {
-                    // Intentionally add just the delay to the existing trigger time -- this ensures the next
-                    // invocation is with respect to the previous trigger, rather than when it got to execution. Under
-                    // normal circumstances this won't cause issue, but if another executor is invoked that takes a
-                    // considerable length of time, then this ensures best-effort timing between invocations.
-                    entry->trigger_time += delay_ms;
-                } else {
-                    // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
+        // Only lowers keys, so sifting each one up restores the heap
+        if (any_overdue) {
+            for (size_t slot = 0; slot < table_count; slot++) {
+                if (table[slot].callback && table[slot].overdue) {
+                    table[slot].overdue = false;
+                    sift_up(table, position_of(table, slot));
                 }
             }
         }
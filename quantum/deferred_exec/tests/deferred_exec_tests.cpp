@@ -0,0 +1,282 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <map>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+static constexpr size_t TABLE_SIZE = MAX_DEFERRED_EXECUTORS;
+
+struct fired_t {
+    uint32_t trigger_time;
+    uint32_t now;
+    uintptr_t id;
+};
+
+static std::vector<fired_t> fired;
+static uint32_t             repeat_delay = 0;
+
+static uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    fired.push_back({trigger_time, timer_read32(), (uintptr_t)cb_arg});
+    return repeat_delay;
+}
+
+class DeferredExec : public ::testing::Test {
+   protected:
+    deferred_executor_t table[TABLE_SIZE] = {};
+    uint32_t            last_exec         = 0;
+
+    void SetUp() override {
+        timer_clear();
+        fired.clear();
+        repeat_delay = 0;
+    }
+
+    void tick(uint32_t ms = 1) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            deferred_exec_advanced_task(table, TABLE_SIZE, &last_exec);
+        }
+    }
+};
+
+TEST_F(DeferredExec, FiresInTriggerOrderAtTriggerTime) {
+    std::mt19937 rng(1);
+    for (uintptr_t i = 0; i < TABLE_SIZE; i++) {
+        ASSERT_NE(defer_exec_advanced(table, TABLE_SIZE, 1 + rng() % 1000, record_callback, (void *)i), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer_exec_advanced(table, TABLE_SIZE, 1, record_callback, NULL), INVALID_DEFERRED_TOKEN);
+
+    tick(1000);
+
+    ASSERT_EQ(fired.size(), TABLE_SIZE);
+    for (size_t i = 0; i < fired.size(); i++) {
+        EXPECT_EQ(fired[i].now, fired[i].trigger_time);
+        if (i > 0) {
+            EXPECT_LE(fired[i - 1].trigger_time, fired[i].trigger_time);
+        }
+    }
+
+    // Everything has been released again
+    for (uintptr_t i = 0; i < TABLE_SIZE; i++) {
+        EXPECT_NE(defer_exec_advanced(table, TABLE_SIZE, 1, record_callback, (void *)i), INVALID_DEFERRED_TOKEN);
+    }
+}
+
+TEST_F(DeferredExec, RepeatingCallbacksRunOncePerPass) {
+    repeat_delay = 1;
+    ASSERT_NE(defer_exec_advanced(table, TABLE_SIZE, 1, record_callback, (void *)1), INVALID_DEFERRED_TOKEN);
+    ASSERT_NE(defer_exec_advanced(table, TABLE_SIZE, 1, record_callback, (void *)2), INVALID_DEFERRED_TOKEN);
+
+    // Fall behind by a few ticks; each executor still only runs once per pass and catches up on later ones
+    advance_time(5);
+    tick();
+    EXPECT_EQ(fired.size(), 2);
+
+    tick(10);
+    EXPECT_EQ(fired.size(), 22);
+    for (auto &f : fired) {
+        EXPECT_LE(f.trigger_time, f.now);
+    }
+}
+
+TEST_F(DeferredExec, FarBehindRepeatingCallbackDoesNotRunAgainInTheSamePass) {
+    repeat_delay = 1;
+    ASSERT_NE(defer_exec_advanced(table, TABLE_SIZE, 1, record_callback, (void *)1), INVALID_DEFERRED_TOKEN);
+    ASSERT_NE(defer_exec_advanced(table, TABLE_SIZE, 30, record_callback, (void *)2), INVALID_DEFERRED_TOKEN);
+    ASSERT_NE(defer_exec_advanced(table, TABLE_SIZE, 100, record_callback, (void *)3), INVALID_DEFERRED_TOKEN);
+
+    // The first executor is dozens of periods behind, and stays behind after every invocation
+    advance_time(50);
+    tick();
+    ASSERT_EQ(fired.size(), 2);
+    EXPECT_EQ(fired[0].id, 1);
+    EXPECT_EQ(fired[0].trigger_time, 1);
+    EXPECT_EQ(fired[1].id, 2);
+
+    tick();
+    ASSERT_EQ(fired.size(), 4);
+    EXPECT_EQ(fired[2].id, 1);
+    EXPECT_EQ(fired[2].trigger_time, 2);
+    EXPECT_EQ(fired[3].id, 2);
+}
+
+TEST_F(DeferredExec, StaleTokensAreRejected) {
+    deferred_token first = defer_exec_advanced(table, TABLE_SIZE, 10, record_callback, NULL);
+    ASSERT_NE(first, INVALID_DEFERRED_TOKEN);
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, first));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, first));
+
+    // The slot gets reused, but with a different token
+    deferred_token second = defer_exec_advanced(table, TABLE_SIZE, 10, record_callback, NULL);
+    ASSERT_NE(second, INVALID_DEFERRED_TOKEN);
+    EXPECT_NE(first, second);
+    EXPECT_FALSE(extend_deferred_exec_advanced(table, TABLE_SIZE, first, 10));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, first));
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, second));
+}
+
+TEST_F(DeferredExec, StaleTokensStayRejectedAcrossManyReuses) {
+    deferred_executor_t single[1] = {};
+    deferred_token      first     = defer_exec_advanced(single, 1, 10, record_callback, NULL);
+    ASSERT_NE(first, INVALID_DEFERRED_TOKEN);
+    EXPECT_TRUE(cancel_deferred_exec_advanced(single, 1, first));
+
+    // Every reuse of the only slot hands out a fresh token
+    for (int i = 0; i < 1000; i++) {
+        deferred_token token = defer_exec_advanced(single, 1, 10, record_callback, NULL);
+        ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+        ASSERT_NE(token, first);
+        EXPECT_FALSE(cancel_deferred_exec_advanced(single, 1, first));
+        EXPECT_TRUE(cancel_deferred_exec_advanced(single, 1, token));
+    }
+}
+
+static deferred_executor_t *requeue_table;
+static deferred_token       requeue_token;
+
+static uint32_t requeue_self_callback(uint32_t trigger_time, void *cb_arg) {
+    fired.push_back({trigger_time, timer_read32(), (uintptr_t)cb_arg});
+    if (fired.size() < 3) {
+        // Lands in the slot that is being run
+        cancel_deferred_exec_advanced(requeue_table, 1, requeue_token);
+        requeue_token = defer_exec_advanced(requeue_table, 1, 2, requeue_self_callback, cb_arg);
+    }
+    return 0;
+}
+
+TEST_F(DeferredExec, CallbackCanRequeueIntoItsOwnSlot) {
+    deferred_executor_t single[1] = {};
+    uint32_t            last      = 0;
+    requeue_table                 = single;
+    requeue_token                 = defer_exec_advanced(single, 1, 2, requeue_self_callback, (void *)1);
+    ASSERT_NE(requeue_token, INVALID_DEFERRED_TOKEN);
+
+    for (int i = 0; i < 20; i++) {
+        advance_time(1);
+        deferred_exec_advanced_task(single, 1, &last);
+    }
+
+    ASSERT_EQ(fired.size(), 3);
+    EXPECT_EQ(fired[0].now, 2);
+    EXPECT_EQ(fired[1].now, 4);
+    EXPECT_EQ(fired[2].now, 6);
+}
+
+static deferred_executor_t *callback_table;
+static deferred_token       victim_token;
+
+static uint32_t cancel_other_callback(uint32_t trigger_time, void *cb_arg) {
+    fired.push_back({trigger_time, timer_read32(), (uintptr_t)cb_arg});
+    cancel_deferred_exec_advanced(callback_table, TABLE_SIZE, victim_token);
+    defer_exec_advanced(callback_table, TABLE_SIZE, 3, record_callback, (void *)3);
+    return 0;
+}
+
+TEST_F(DeferredExec, CallbacksCanModifyTheTable) {
+    callback_table = table;
+    ASSERT_NE(defer_exec_advanced(table, TABLE_SIZE, 5, cancel_other_callback, (void *)1), INVALID_DEFERRED_TOKEN);
+    victim_token = defer_exec_advanced(table, TABLE_SIZE, 5, record_callback, (void *)2);
+    ASSERT_NE(victim_token, INVALID_DEFERRED_TOKEN);
+
+    tick(20);
+
+    ASSERT_EQ(fired.size(), 2);
+    EXPECT_EQ(fired[0].id, 1);
+    EXPECT_EQ(fired[1].id, 3);
+    EXPECT_EQ(fired[1].now, 8);
+}
+
+TEST_F(DeferredExec, RandomisedScheduleCancelExtendMatchesModel) {
+    std::mt19937                                             rng(1234);
+    std::map<deferred_token, std::pair<uintptr_t, uint32_t>> model; // token -> (id, trigger time)
+    std::vector<deferred_token>                              stale;
+    uintptr_t                                                next_id = 0;
+
+    for (uint32_t step = 0; step < 2000; step++) {
+        for (int op = 0; op < 8; op++) {
+            uint32_t choice = rng() % 10;
+            if (choice < 5 || model.empty()) {
+                uint32_t       delay = 1 + rng() % 200;
+                deferred_token token = defer_exec_advanced(table, TABLE_SIZE, delay, record_callback, (void *)next_id);
+                if (model.size() == TABLE_SIZE) {
+                    EXPECT_EQ(token, INVALID_DEFERRED_TOKEN);
+                    continue;
+                }
+                ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+                ASSERT_EQ(model.count(token), 0);
+                model[token] = {next_id++, timer_read32() + delay};
+            } else {
+                auto it = model.begin();
+                std::advance(it, rng() % model.size());
+                if (choice < 8) {
+                    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, it->first));
+                    stale.push_back(it->first);
+                    model.erase(it);
+                } else {
+                    uint32_t delay = 1 + rng() % 200;
+                    EXPECT_TRUE(extend_deferred_exec_advanced(table, TABLE_SIZE, it->first, delay));
+                    it->second.second = timer_read32() + delay;
+                }
+            }
+        }
+
+        if (!stale.empty()) {
+            deferred_token token = stale[rng() % stale.size()];
+            if (model.count(token) == 0) {
+                EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, token));
+            }
+        }
+
+        fired.clear();
+        tick();
+
+        uint32_t now = timer_read32();
+        for (auto &f : fired) {
+            EXPECT_EQ(f.trigger_time, now);
+        }
+        size_t due = 0;
+        for (auto it = model.begin(); it != model.end();) {
+            if (it->second.second == now) {
+                due++;
+                it = model.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        ASSERT_EQ(fired.size(), due) << "at step " << step;
+    }
+
+    // Whatever is still pending fires, and leaves the table empty
+    fired.clear();
+    tick(200);
+    EXPECT_EQ(fired.size(), model.size());
+    for (uintptr_t i = 0; i < TABLE_SIZE; i++) {
+        EXPECT_NE(defer_exec_advanced(table, TABLE_SIZE, 1, record_callback, (void *)i), INVALID_DEFERRED_TOKEN);
+    }
+}
+
+TEST_F(DeferredExec, BasicApi) {
+    deferred_token token = defer_exec(5, record_callback, (void *)7);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+    EXPECT_TRUE(extend_deferred_exec(token, 10));
+
+    for (int i = 0; i < 20; i++) {
+        advance_time(1);
+        deferred_exec_task();
+    }
+
+    ASSERT_EQ(fired.size(), 1);
+    EXPECT_EQ(fired[0].id, 7);
+    EXPECT_EQ(fired[0].now, 10);
+    EXPECT_FALSE(cancel_deferred_exec(token));
+}
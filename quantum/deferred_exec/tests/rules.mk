@@ -0,0 +1,7 @@
+deferred_exec_DEFS := -DMAX_DEFERRED_EXECUTORS=512
+
+deferred_exec_SRC := \
+    $(QUANTUM_PATH)/deferred_exec/tests/deferred_exec_tests.cpp \
+    $(QUANTUM_PATH)/deferred_exec.c \
+    $(PLATFORM_PATH)/timer.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -4,6 +4,7 @@
 #include <string.h>
 #include "action.h"
 #include "encoder.h"
+#include "host.h"
 #include "wait.h"
 
 #ifndef ENCODER_MAP_KEY_DELAY
@@ -37,11 +38,13 @@ static bool encoder_handle_queue(void) {
         // The delays below cater for Windows and its wonderful requirements.
         action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
 #    if ENCODER_MAP_KEY_DELAY > 0
+        host_flush_reports();
         wait_ms(ENCODER_MAP_KEY_DELAY);
 #    endif // ENCODER_MAP_KEY_DELAY > 0
 
         action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, false) : MAKE_ENCODER_CCW_EVENT(index, false));
 #    if ENCODER_MAP_KEY_DELAY > 0
+        host_flush_reports();
         wait_ms(ENCODER_MAP_KEY_DELAY);
 #    endif // ENCODER_MAP_KEY_DELAY > 0
 
@@ -16,6 +16,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <stdint.h>
+#include <string.h>
 #include "keyboard.h"
 #include "keycode_config.h"
 #include "matrix.h"
@@ -151,6 +152,21 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef CONNECTION_ENABLE
 #    include "connection.h"
 #endif
+#ifdef KEYEVENT_QUEUE_ENABLE
+#    include "keyevent_queue.h"
+#endif
+#ifdef LATENCY_STATS_ENABLE
+#    include "latency_stats.h"
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_ASYNC_CONSOLIDATION)
+#    include "wear_leveling.h"
+#endif
+#ifdef NVM_WRITE_BACK_ENABLE
+#    include "nvm_write_back.h"
+#endif
+#ifdef TASK_SCHEDULER_ENABLE
+#    include "task_scheduler.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -452,6 +468,39 @@ void quantum_init(void) {
     layer_state_set_kb((layer_state_t)layer_state);
 }
 
+#ifdef TASK_SCHEDULER_ENABLE
+#    ifndef TASK_SCHEDULER_COSMETIC_BUDGET_US
+#        define TASK_SCHEDULER_COSMETIC_BUDGET_US 200
+#    endif
+
+/** \brief Registers the lighting and display tasks with the scheduler
+ *
+ * These only affect what the user sees, so they are the first to be
+ * postponed when the main loop runs over its time budget.
+ */
+static void keyboard_task_scheduler_init(void) {
+    task_scheduler_init();
+#    if defined(RGBLIGHT_ENABLE)
+    task_scheduler_register(rgblight_task, TASK_SCHEDULER_COSMETIC_PERIOD, TASK_PRIORITY_COSMETIC, TASK_SCHEDULER_COSMETIC_BUDGET_US);
+#    endif
+#    ifdef LED_MATRIX_ENABLE
+    task_scheduler_register(led_matrix_task, TASK_SCHEDULER_COSMETIC_PERIOD, TASK_PRIORITY_COSMETIC, TASK_SCHEDULER_COSMETIC_BUDGET_US);
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    task_scheduler_register(rgb_matrix_task, TASK_SCHEDULER_COSMETIC_PERIOD, TASK_PRIORITY_COSMETIC, TASK_SCHEDULER_COSMETIC_BUDGET_US);
+#    endif
+#    if defined(BACKLIGHT_ENABLE) && (defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS))
+    task_scheduler_register(backlight_task, TASK_SCHEDULER_COSMETIC_PERIOD, TASK_PRIORITY_COSMETIC, TASK_SCHEDULER_COSMETIC_BUDGET_US);
+#    endif
+#    ifdef OLED_ENABLE
+    task_scheduler_register(oled_task, TASK_SCHEDULER_COSMETIC_PERIOD, TASK_PRIORITY_COSMETIC, TASK_SCHEDULER_COSMETIC_BUDGET_US);
+#    endif
+#    ifdef ST7565_ENABLE
+    task_scheduler_register(st7565_task, TASK_SCHEDULER_COSMETIC_PERIOD, TASK_PRIORITY_COSMETIC, TASK_SCHEDULER_COSMETIC_BUDGET_US);
+#    endif
+}
+#endif
+
 /** \brief keyboard_init
  *
  * FIXME: needs doc
@@ -545,6 +594,10 @@ void keyboard_init(void) {
     haptic_init();
 #endif
 
+#ifdef TASK_SCHEDULER_ENABLE
+    keyboard_task_scheduler_init();
+#endif
+
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
 #endif
@@ -572,6 +625,12 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
  * internal QMK state machine.
  */
 static inline void generate_tick_event(void) {
+#ifdef KEYEVENT_QUEUE_ENABLE
+    // Ticks must not overtake key events that were detected before them
+    if (!keyevent_queue_is_empty()) {
+        return;
+    }
+#endif
     static uint16_t last_tick = 0;
     const uint16_t  now       = timer_read();
     if (TIMER_DIFF_16(now, last_tick) != 0) {
@@ -580,8 +639,134 @@ static inline void generate_tick_event(void) {
     }
 }
 
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_MATRIX_EVENTS)
+static uint16_t last_key_event_time = 0;
+#endif
+
+/**
+ * @brief Hands a key event over to the action pipeline, either directly or
+ * through the key event queue. The event is only marked for latency stats
+ * once it has been accepted, so an event retried on a later scan is measured
+ * once.
+ *
+ * @return true The event was accepted
+ * @return false The event queue is full
+ */
+static inline bool dispatch_key_event(keyevent_t event) {
+#ifdef KEYEVENT_QUEUE_ENABLE
+    if (!keyevent_queue_push(event)) {
+        return false;
+    }
+#endif
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_MATRIX_EVENTS)
+    last_key_event_time = event.time;
+#endif
+#ifdef LATENCY_STATS_ENABLE
+    latency_stats_key_event();
+#endif
+#ifndef KEYEVENT_QUEUE_ENABLE
+    action_exec(event);
+#endif
+    return true;
+}
+
+#ifdef KEYEVENT_QUEUE_ENABLE
+/**
+ * @brief Processes up to KEYEVENT_QUEUE_DRAIN_MAX key events queued by matrix
+ * scanning, in order. Anything left over waits for the next loop, after the
+ * matrix has been scanned again.
+ */
+static void keyevent_queue_task(void) {
+    keyevent_t event;
+    for (uint8_t i = 0; i < KEYEVENT_QUEUE_DRAIN_MAX && keyevent_queue_pop(&event); i++) {
+        action_exec(event);
+    }
+}
+#endif
+
 matrix_row_t matrix_previous[MATRIX_ROWS];
 
+#define MATRIX_CHANGED_ROWS_WORDS CEILING(MATRIX_ROWS, 32)
+
+/* Per-row change masks, only valid for rows flagged in matrix_changed_rows */
+static matrix_row_t matrix_row_changes[MATRIX_ROWS];
+static uint32_t     matrix_changed_rows[MATRIX_CHANGED_ROWS_WORDS];
+
+/**
+ * @brief Diffs the debounced matrix against the previous state in a single
+ * pass, recording which rows changed and the columns that flipped in them.
+ *
+ * @return true Matrix did change
+ * @return false Matrix didn't change
+ */
+static bool matrix_collect_changes(void) {
+    bool matrix_changed = false;
+
+    memset(matrix_changed_rows, 0, sizeof(matrix_changed_rows));
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        const matrix_row_t row_changes = matrix_previous[row] ^ matrix_get_row(row);
+        if (row_changes) {
+            matrix_row_changes[row] = row_changes;
+            matrix_changed_rows[row / 32] |= BIT32(row % 32);
+            matrix_changed = true;
+        }
+    }
+
+    return matrix_changed;
+}
+
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_MATRIX_EVENTS)
+/**
+ * @brief Dispatches the key changes reported by the slave half, in the order
+ * and with the timestamps they were detected with on the slave.
+ *
+ * Each dispatched key is marked in matrix_previous so the matrix diff does not
+ * report it a second time; anything the event stream missed is still picked up
+ * by the diff.
+ *
+ * @return true At least one slave key changed
+ */
+static bool split_matrix_event_task(void) {
+    const bool process_keypress = should_process_keypress();
+    bool       changed          = false;
+    keyevent_t event;
+
+    while (split_matrix_event_peek(&event)) {
+        const uint8_t      row      = event.key.row;
+        const uint8_t      col      = event.key.col;
+        const matrix_row_t col_mask = MATRIX_ROW_SHIFTER << col;
+
+        if (((matrix_previous[row] & col_mask) != 0) == event.pressed || has_ghost_in_row(row, matrix_previous[row] ^ col_mask)) {
+            split_matrix_event_drop();
+            continue;
+        }
+
+        // Keep time monotonic for the action pipeline: never ahead of now, never behind an event already dispatched
+        const uint16_t now = timer_read();
+        if ((int16_t)TIMER_DIFF_16(now, event.time) < 0) {
+            event.time = now;
+        }
+        if ((int16_t)TIMER_DIFF_16(event.time, last_key_event_time) < 0) {
+            event.time = last_key_event_time;
+        }
+
+        if (process_keypress && !keypress_is_wakeup_key(row, col)) {
+            if (!dispatch_key_event(event)) {
+                // Leave the event queued, it is retried on the next scan
+                break;
+            }
+        }
+
+        switch_events(row, col, event.pressed);
+        matrix_previous[row] ^= col_mask;
+        split_matrix_event_drop();
+        changed = true;
+    }
+
+    return changed;
+}
+#endif
+
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
@@ -596,15 +781,20 @@ static bool matrix_task(void) {
     }
 
     matrix_scan();
-    bool matrix_changed = false;
-    for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
-        matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
-    }
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_MATRIX_EVENTS)
+    const bool split_events_changed = split_matrix_event_task();
+#endif
+    const bool matrix_changed = matrix_collect_changes();
 
     matrix_scan_perf_task();
 
     // Short-circuit the complete matrix processing if it is not necessary
     if (!matrix_changed) {
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_MATRIX_EVENTS)
+        if (split_events_changed) {
+            return true;
+        }
+#endif
         generate_tick_event();
         return matrix_changed;
     }
@@ -615,28 +805,33 @@ static bool matrix_task(void) {
 
     const bool process_keypress = should_process_keypress();
 
-    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
-        const matrix_row_t current_row = matrix_get_row(row);
-        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
+    // Only visit the rows and columns that flipped, in ascending matrix order
+    for (uint8_t word = 0; word < MATRIX_CHANGED_ROWS_WORDS; word++) {
+        for (uint32_t rows = matrix_changed_rows[word]; rows; rows &= rows - 1) {
+            const uint8_t      row         = word * 32 + __builtin_ctzl(rows);
+            const matrix_row_t row_changes = matrix_row_changes[row];
+            const matrix_row_t current_row = matrix_previous[row] ^ row_changes;
 
-        if (!row_changes || has_ghost_in_row(row, current_row)) {
-            continue;
-        }
+            if (has_ghost_in_row(row, current_row)) {
+                continue;
+            }
 
-        matrix_row_t col_mask = 1;
-        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
-            if (row_changes & col_mask) {
-                const bool key_pressed = current_row & col_mask;
+            for (matrix_row_t cols = row_changes; cols; cols &= cols - 1) {
+                const uint8_t      col         = __builtin_ctzl(cols);
+                const matrix_row_t col_mask    = MATRIX_ROW_SHIFTER << col;
+                const bool         key_pressed = current_row & col_mask;
 
                 if (process_keypress && !keypress_is_wakeup_key(row, col)) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+                    if (!dispatch_key_event(MAKE_KEYEVENT(row, col, key_pressed))) {
+                        // Leave the remaining changes in place, they are picked up again on the next scan
+                        return matrix_changed;
+                    }
                 }
 
                 switch_events(row, col, key_pressed);
+                matrix_previous[row] ^= col_mask;
             }
         }
-
-        matrix_previous[row] = current_row;
     }
 
     return matrix_changed;
@@ -710,31 +905,52 @@ void quantum_task(void) {
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
     __attribute__((unused)) bool activity_has_occurred = false;
+#ifdef TASK_SCHEDULER_ENABLE
+    task_scheduler_loop_start();
+#endif
     if (matrix_task()) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
 
+#ifdef KEYEVENT_QUEUE_ENABLE
+    keyevent_queue_task();
+#endif
+
+#ifdef LATENCY_STATS_ENABLE
+    latency_stats_task();
+#endif
+
+#ifdef NVM_WRITE_BACK_ENABLE
+    nvm_write_back_task();
+#endif
+
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_ASYNC_CONSOLIDATION)
+    wear_leveling_task();
+#endif
+
     quantum_task();
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
 #endif
 
-#if defined(RGBLIGHT_ENABLE)
+#if defined(RGBLIGHT_ENABLE) && !defined(TASK_SCHEDULER_ENABLE)
     rgblight_task();
 #endif
 
-#ifdef LED_MATRIX_ENABLE
+#ifndef TASK_SCHEDULER_ENABLE
+#    ifdef LED_MATRIX_ENABLE
     led_matrix_task();
-#endif
-#ifdef RGB_MATRIX_ENABLE
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
     rgb_matrix_task();
-#endif
+#    endif
 
-#if defined(BACKLIGHT_ENABLE)
-#    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
+#    if defined(BACKLIGHT_ENABLE)
+#        if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
     backlight_task();
+#        endif
 #    endif
 #endif
 
@@ -753,7 +969,9 @@ void keyboard_task(void) {
 #endif
 
 #ifdef OLED_ENABLE
+#    ifndef TASK_SCHEDULER_ENABLE
     oled_task();
+#    endif
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
@@ -761,7 +979,9 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ST7565_ENABLE
+#    ifndef TASK_SCHEDULER_ENABLE
     st7565_task();
+#    endif
 #    if ST7565_TIMEOUT > 0
     // Wake up display if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) st7565_on();
@@ -802,4 +1022,13 @@ void keyboard_task(void) {
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
+
+#ifdef TASK_SCHEDULER_ENABLE
+    task_scheduler_task();
+#endif
+
+#ifdef REPORT_COALESCING_ENABLE
+    // Everything this scan produced has been merged, send it on
+    host_report_coalescing_task();
+#endif
 }
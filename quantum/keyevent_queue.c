@@ -0,0 +1,51 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyevent_queue.h"
+
+#define KEYEVENT_QUEUE_MASK (KEYEVENT_QUEUE_SIZE - 1)
+
+/* Free-running indices: head is only written by the producer, tail only by the consumer. */
+static keyevent_t queue[KEYEVENT_QUEUE_SIZE];
+static uint8_t    queue_head = 0;
+static uint8_t    queue_tail = 0;
+
+bool keyevent_queue_push(keyevent_t event) {
+    uint8_t head = queue_head;
+    uint8_t tail = __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE);
+
+    if ((uint8_t)(head - tail) >= KEYEVENT_QUEUE_SIZE) {
+        return false;
+    }
+
+    queue[head & KEYEVENT_QUEUE_MASK] = event;
+    // publish the slot only once it has been written
+    __atomic_store_n(&queue_head, (uint8_t)(head + 1), __ATOMIC_RELEASE);
+    return true;
+}
+
+bool keyevent_queue_pop(keyevent_t *event) {
+    uint8_t tail = queue_tail;
+    uint8_t head = __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE);
+
+    if (head == tail) {
+        return false;
+    }
+
+    *event = queue[tail & KEYEVENT_QUEUE_MASK];
+    // hand the slot back only once it has been read
+    __atomic_store_n(&queue_tail, (uint8_t)(tail + 1), __ATOMIC_RELEASE);
+    return true;
+}
+
+bool keyevent_queue_is_empty(void) {
+    return __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE) == __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE);
+}
+
+uint8_t keyevent_queue_count(void) {
+    return (uint8_t)(__atomic_load_n(&queue_head, __ATOMIC_ACQUIRE) - __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE));
+}
+
+void keyevent_queue_clear(void) {
+    __atomic_store_n(&queue_tail, __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+}
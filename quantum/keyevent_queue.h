@@ -0,0 +1,67 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "keyboard.h"
+
+#ifndef KEYEVENT_QUEUE_SIZE
+#    define KEYEVENT_QUEUE_SIZE 32
+#endif
+
+#if (KEYEVENT_QUEUE_SIZE & (KEYEVENT_QUEUE_SIZE - 1)) != 0 || KEYEVENT_QUEUE_SIZE > 128
+#    error "KEYEVENT_QUEUE_SIZE must be a power of two no larger than 128"
+#endif
+
+/* The most events processed per main loop iteration, so a burst of slow
+ * actions cannot hold up the next matrix scan */
+#ifndef KEYEVENT_QUEUE_DRAIN_MAX
+#    define KEYEVENT_QUEUE_DRAIN_MAX 4
+#endif
+
+#if KEYEVENT_QUEUE_DRAIN_MAX < 1
+#    error "KEYEVENT_QUEUE_DRAIN_MAX must be at least 1"
+#endif
+
+/**
+ * Single-producer/single-consumer queue of key events, carrying the
+ * timestamp captured when the event was detected.
+ *
+ * The producer (matrix scanning) and the consumer (action processing) may run
+ * in different contexts -- for example a scan thread and the main loop -- as
+ * long as each side only ever calls its own functions.
+ */
+
+/**
+ * @brief Appends an event to the queue. Producer side only.
+ *
+ * @return true the event was queued
+ * @return false the queue is full, the producer should retry later
+ */
+bool keyevent_queue_push(keyevent_t event);
+
+/**
+ * @brief Removes the oldest event from the queue. Consumer side only.
+ *
+ * @param event[out] the dequeued event
+ * @return true an event was dequeued
+ * @return false the queue is empty
+ */
+bool keyevent_queue_pop(keyevent_t *event);
+
+/**
+ * @brief Whether there are no pending events.
+ */
+bool keyevent_queue_is_empty(void);
+
+/**
+ * @brief The number of pending events.
+ */
+uint8_t keyevent_queue_count(void);
+
+/**
+ * @brief Drops all pending events. Only safe while the producer is idle.
+ */
+void keyevent_queue_clear(void);
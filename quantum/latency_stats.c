@@ -0,0 +1,141 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "latency_stats.h"
+#include "timer.h"
+#include "debug.h"
+#include "print.h"
+#include "util.h"
+#include "bitwise.h"
+
+#define LATENCY_SUB_BUCKET_BITS 2
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BUCKET_BITS)
+
+static uint16_t histograms[LATENCY_STAGE_COUNT][LATENCY_STATS_BUCKETS];
+static uint32_t sample_count[LATENCY_STAGE_COUNT];
+static uint32_t sample_max[LATENCY_STAGE_COUNT];
+
+static bool     event_pending  = false;
+static bool     report_pending = false;
+static uint32_t event_time     = 0;
+static uint32_t report_time    = 0;
+
+#ifdef CONSOLE_ENABLE
+static const char *const stage_names[LATENCY_STAGE_COUNT] = {
+    [LATENCY_STAGE_SCAN_TO_HOST]     = "scan->host",
+    [LATENCY_STAGE_HOST_TO_ENDPOINT] = "host->endpoint",
+    [LATENCY_STAGE_SCAN_TO_ENDPOINT] = "scan->endpoint",
+};
+#endif
+
+__attribute__((weak)) uint32_t latency_stats_timestamp(void) {
+    return timer_read_us();
+}
+
+static uint8_t latency_bucket(uint32_t value) {
+    if (value < LATENCY_SUB_BUCKETS) {
+        return value;
+    }
+    uint8_t msb   = biton32(value);
+    uint8_t shift = msb - LATENCY_SUB_BUCKET_BITS;
+    uint8_t index = (shift + 1) * LATENCY_SUB_BUCKETS + ((value >> shift) & (LATENCY_SUB_BUCKETS - 1));
+    return MIN(index, LATENCY_STATS_BUCKETS - 1);
+}
+
+uint32_t latency_stats_bucket_lower_bound(uint8_t bucket) {
+    if (bucket < LATENCY_SUB_BUCKETS) {
+        return bucket;
+    }
+    uint8_t shift = bucket / LATENCY_SUB_BUCKETS - 1;
+    return (uint32_t)(LATENCY_SUB_BUCKETS + bucket % LATENCY_SUB_BUCKETS) << shift;
+}
+
+void latency_stats_record(latency_stage_t stage, uint32_t duration_us) {
+    uint16_t *count = &histograms[stage][latency_bucket(duration_us)];
+    if (*count < UINT16_MAX) {
+        (*count)++;
+    }
+    sample_count[stage]++;
+    sample_max[stage] = MAX(sample_max[stage], duration_us);
+}
+
+void latency_stats_key_event(void) {
+    // An earlier event still pending produced no report of its own, so it is superseded
+    event_time    = latency_stats_timestamp();
+    event_pending = true;
+}
+
+void latency_stats_report_queued(void) {
+    if (!event_pending) {
+        return;
+    }
+    report_time = latency_stats_timestamp();
+    latency_stats_record(LATENCY_STAGE_SCAN_TO_HOST, report_time - event_time);
+    event_pending  = false;
+    report_pending = true;
+}
+
+void latency_stats_report_sent(void) {
+    if (!report_pending) {
+        return;
+    }
+    uint32_t now = latency_stats_timestamp();
+    latency_stats_record(LATENCY_STAGE_HOST_TO_ENDPOINT, now - report_time);
+    latency_stats_record(LATENCY_STAGE_SCAN_TO_ENDPOINT, now - event_time);
+    report_pending = false;
+}
+
+static uint32_t latency_percentile(latency_stage_t stage, uint8_t percent) {
+    uint32_t target     = (sample_count[stage] * percent + 99) / 100;
+    uint32_t cumulative = 0;
+    for (uint8_t bucket = 0; bucket < LATENCY_STATS_BUCKETS; bucket++) {
+        cumulative += histograms[stage][bucket];
+        if (cumulative >= target) {
+            if (bucket == LATENCY_STATS_BUCKETS - 1) {
+                break;
+            }
+            return MIN(latency_stats_bucket_lower_bound(bucket + 1) - 1, sample_max[stage]);
+        }
+    }
+    return sample_max[stage];
+}
+
+void latency_stats_get(latency_stage_t stage, latency_summary_t *summary) {
+    summary->count = sample_count[stage];
+    summary->max   = sample_max[stage];
+    summary->p50   = sample_count[stage] ? latency_percentile(stage, 50) : 0;
+    summary->p99   = sample_count[stage] ? latency_percentile(stage, 99) : 0;
+}
+
+uint16_t latency_stats_get_bucket(latency_stage_t stage, uint8_t bucket) {
+    return bucket < LATENCY_STATS_BUCKETS ? histograms[stage][bucket] : 0;
+}
+
+void latency_stats_reset(void) {
+    memset(histograms, 0, sizeof(histograms));
+    memset(sample_count, 0, sizeof(sample_count));
+    memset(sample_max, 0, sizeof(sample_max));
+    event_pending  = false;
+    report_pending = false;
+}
+
+void latency_stats_print(void) {
+#ifdef CONSOLE_ENABLE
+    latency_summary_t summary;
+    for (uint8_t stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+        latency_stats_get(stage, &summary);
+        xprintf("latency %s: n=%lu p50=%luus p99=%luus max=%luus\n", stage_names[stage], summary.count, summary.p50, summary.p99, summary.max);
+    }
+#endif
+}
+
+void latency_stats_task(void) {
+#ifdef LATENCY_STATS_PRINT_INTERVAL
+    static uint32_t last_print = 0;
+    if (debug_enable && timer_elapsed32(last_print) >= LATENCY_STATS_PRINT_INTERVAL) {
+        last_print = timer_read32();
+        latency_stats_print();
+    }
+#endif
+}
@@ -0,0 +1,96 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Scan-to-report latency instrumentation.
+
+    A key event detected by matrix scanning is timestamped, and the next
+    keyboard report is timestamped again when host_keyboard_send() queues it
+    and once the host driver has accepted it. Each stage is accumulated into
+    a log-bucketed histogram, four sub-buckets per power of two.
+
+    Timestamps come from latency_stats_timestamp(), which defaults to
+    timer_read_us(). Boards with a cycle counter can override it for finer
+    resolution.
+*/
+
+#ifndef LATENCY_STATS_BUCKETS
+#    define LATENCY_STATS_BUCKETS 80
+#endif
+
+typedef enum {
+    LATENCY_STAGE_SCAN_TO_HOST,     // key event detected -> report queued by host_keyboard_send()
+    LATENCY_STAGE_HOST_TO_ENDPOINT, // report queued -> accepted by the host driver
+    LATENCY_STAGE_SCAN_TO_ENDPOINT, // key event detected -> accepted by the host driver
+    LATENCY_STAGE_COUNT,
+} latency_stage_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t max;
+} latency_summary_t;
+
+/**
+ * @brief Current time in microseconds, used for all latency samples.
+ */
+uint32_t latency_stats_timestamp(void);
+
+/**
+ * @brief Marks that a key event was detected. The next report is measured
+ * from the most recent event, so an event that produces no report (a layer
+ * key, say) is not charged to whatever report comes later.
+ */
+void latency_stats_key_event(void);
+
+/**
+ * @brief Marks that a keyboard report was handed to the host driver.
+ */
+void latency_stats_report_queued(void);
+
+/**
+ * @brief Marks that the host driver accepted the report queued last.
+ */
+void latency_stats_report_sent(void);
+
+/**
+ * @brief Adds a single sample, in microseconds, to a stage's histogram.
+ */
+void latency_stats_record(latency_stage_t stage, uint32_t duration_us);
+
+/**
+ * @brief Summarizes a stage's histogram. Percentiles are reported as the
+ * upper bound of the bucket they fall in, capped at the exact maximum.
+ */
+void latency_stats_get(latency_stage_t stage, latency_summary_t *summary);
+
+/**
+ * @brief Sample count of a single histogram bucket.
+ */
+uint16_t latency_stats_get_bucket(latency_stage_t stage, uint8_t bucket);
+
+/**
+ * @brief Smallest value, in microseconds, that lands in the given bucket.
+ */
+uint32_t latency_stats_bucket_lower_bound(uint8_t bucket);
+
+/**
+ * @brief Clears all histograms and any in-flight measurement.
+ */
+void latency_stats_reset(void);
+
+/**
+ * @brief Prints a summary of every stage to the console.
+ */
+void latency_stats_print(void);
+
+/**
+ * @brief Periodically prints the summary when LATENCY_STATS_PRINT_INTERVAL is set.
+ */
+void latency_stats_task(void);
@@ -91,8 +91,10 @@ void matrix_print(void) {
 bool matrix_post_scan(void) {
     bool changed = false;
     if (is_keyboard_master()) {
-        static bool  last_connected                     = false;
-        matrix_row_t slave_matrix[MATRIX_ROWS_PER_HAND] = {0};
+        static bool  last_connected = false;
+        matrix_row_t slave_matrix[MATRIX_ROWS_PER_HAND];
+        // Start from the last known state, so a sync cycle that was skipped or failed early changes nothing
+        memcpy(slave_matrix, matrix + thatHand, sizeof(slave_matrix));
         if (transport_master_if_connected(matrix + thisHand, slave_matrix)) {
             changed = memcmp(matrix + thatHand, slave_matrix, sizeof(slave_matrix)) != 0;
 
@@ -116,6 +118,26 @@ bool matrix_post_scan(void) {
 
     return changed;
 }
+
+#    ifdef SPLIT_MATRIX_EVENTS
+bool split_matrix_event_peek(keyevent_t *event) {
+    while (transactions_slave_matrix_event_peek(event)) {
+        event->key.row += thatHand;
+#        ifdef MATRIX_MASKED
+        if (!(matrix_mask[event->key.row] & (MATRIX_ROW_SHIFTER << event->key.col))) {
+            transactions_slave_matrix_event_drop();
+            continue;
+        }
+#        endif
+        return true;
+    }
+    return false;
+}
+
+void split_matrix_event_drop(void) {
+    transactions_slave_matrix_event_drop();
+}
+#    endif // SPLIT_MATRIX_EVENTS
 #endif
 
 /* `matrix_io_delay ()` exists for backwards compatibility. From now on, use matrix_output_unselect_delay(). */
@@ -0,0 +1,32 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "eeprom.h"
+
+// EEPROM accessors used by the eeprom NVM provider, which go through the write-back cache when it's enabled.
+
+#ifdef NVM_WRITE_BACK_ENABLE
+#    include "nvm_write_back.h"
+
+uint8_t  nvm_eeprom_read_byte(const uint8_t *addr);
+uint16_t nvm_eeprom_read_word(const uint16_t *addr);
+uint32_t nvm_eeprom_read_dword(const uint32_t *addr);
+void     nvm_eeprom_read_block(void *buf, const void *addr, size_t len);
+void     nvm_eeprom_update_byte(uint8_t *addr, uint8_t value);
+void     nvm_eeprom_update_word(uint16_t *addr, uint16_t value);
+void     nvm_eeprom_update_dword(uint32_t *addr, uint32_t value);
+void     nvm_eeprom_update_block(const void *buf, void *addr, size_t len);
+#else // NVM_WRITE_BACK_ENABLE
+#    define nvm_eeprom_read_byte eeprom_read_byte
+#    define nvm_eeprom_read_word eeprom_read_word
+#    define nvm_eeprom_read_dword eeprom_read_dword
+#    define nvm_eeprom_read_block eeprom_read_block
+#    define nvm_eeprom_update_byte eeprom_update_byte
+#    define nvm_eeprom_update_word eeprom_update_word
+#    define nvm_eeprom_update_dword eeprom_update_dword
+#    define nvm_eeprom_update_block eeprom_update_block
+#endif // NVM_WRITE_BACK_ENABLE
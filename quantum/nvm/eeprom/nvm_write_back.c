@@ -0,0 +1,228 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <string.h>
+#include "compiler_support.h"
+#include "nvm_write_back.h"
+#include "nvm_eeprom_write_back_internal.h"
+#include "timer.h"
+#include "util.h"
+
+#ifndef NVM_WRITE_BACK_RANGES
+#    define NVM_WRITE_BACK_RANGES 4
+#endif
+
+#ifndef NVM_WRITE_BACK_RANGE_SIZE
+#    define NVM_WRITE_BACK_RANGE_SIZE 32
+#endif
+
+#ifndef NVM_WRITE_BACK_DELAY
+#    define NVM_WRITE_BACK_DELAY 1000
+#endif
+
+STATIC_ASSERT(NVM_WRITE_BACK_RANGE_SIZE <= 255, "NVM_WRITE_BACK_RANGE_SIZE must fit in a byte");
+
+/*
+    Write-back cache for the eeprom provider.
+
+    Updates land in a small set of dirty ranges in RAM instead of going
+    straight to the EEPROM driver, which for wear-leveled flash means a log
+    entry per update. An update overlapping or touching a pending range is
+    merged into it, so repeated updates of the same settings cost a single
+    write of the final value. Ranges are flushed once updates have been quiet
+    for NVM_WRITE_BACK_DELAY, when a range is needed and none are free, and
+    by nvm_write_back_flush(). Reads see the pending data on top of the
+    EEPROM contents.
+
+    Bytes covered by more than one range hold the same value in each, so
+    ranges can be flushed or dropped in any order.
+*/
+
+typedef struct {
+    uint32_t address;
+    uint16_t last_used;
+    uint8_t  length; // 0 when free
+    uint8_t  data[NVM_WRITE_BACK_RANGE_SIZE];
+} nvm_write_back_range_t;
+
+static nvm_write_back_range_t ranges[NVM_WRITE_BACK_RANGES];
+static uint16_t               use_counter = 0;
+static uint32_t               last_write  = 0;
+
+static void range_flush(nvm_write_back_range_t *range) {
+    eeprom_update_block(range->data, (void *)(uintptr_t)range->address, range->length);
+    range->length = 0;
+}
+
+// Whether the range and [address, address + length) overlap or touch, and would fit in a single range together
+static bool range_can_merge(const nvm_write_back_range_t *range, uint32_t address, size_t length) {
+    if (range->length == 0 || address > range->address + range->length || address + length < range->address) {
+        return false;
+    }
+    return MAX(range->address + range->length, address + length) - MIN(range->address, address) <= NVM_WRITE_BACK_RANGE_SIZE;
+}
+
+// Pre-condition: range_can_merge(), or the range is free
+static void range_merge(nvm_write_back_range_t *range, uint32_t address, const uint8_t *data, size_t length) {
+    if (range->length == 0) {
+        range->address = address;
+        range->length  = length;
+    } else {
+        uint32_t start = MIN(range->address, address);
+        uint32_t end   = MAX(range->address + range->length, address + length);
+        if (start < range->address) {
+            memmove(&range->data[range->address - start], range->data, range->length);
+        }
+        range->address = start;
+        range->length  = end - start;
+    }
+    memcpy(&range->data[address - range->address], data, length);
+    range->last_used = ++use_counter;
+}
+
+// Updates every pending copy of the given bytes
+static void ranges_patch(uint32_t address, const uint8_t *data, size_t length) {
+    for (uint8_t i = 0; i < NVM_WRITE_BACK_RANGES; i++) {
+        nvm_write_back_range_t *range = &ranges[i];
+        uint32_t                start = MAX(range->address, address);
+        uint32_t                end   = MIN(range->address + range->length, address + length);
+        if (start < end) {
+            memcpy(&range->data[start - range->address], &data[start - address], end - start);
+        }
+    }
+}
+
+static nvm_write_back_range_t *range_allocate(void) {
+    nvm_write_back_range_t *victim = &ranges[0];
+    for (uint8_t i = 0; i < NVM_WRITE_BACK_RANGES; i++) {
+        if (ranges[i].length == 0) {
+            return &ranges[i];
+        }
+        if ((uint16_t)(use_counter - ranges[i].last_used) > (uint16_t)(use_counter - victim->last_used)) {
+            victim = &ranges[i];
+        }
+    }
+    // Out of ranges, make room by writing out the least recently used one
+    range_flush(victim);
+    return victim;
+}
+
+void nvm_eeprom_read_block(void *buf, const void *addr, size_t len) {
+    eeprom_read_block(buf, addr, len);
+
+    uint32_t address = (uintptr_t)addr;
+    uint8_t *dest    = (uint8_t *)buf;
+    for (uint8_t i = 0; i < NVM_WRITE_BACK_RANGES; i++) {
+        const nvm_write_back_range_t *range = &ranges[i];
+        uint32_t                      start = MAX(range->address, address);
+        uint32_t                      end   = MIN(range->address + range->length, address + len);
+        if (start < end) {
+            memcpy(&dest[start - address], &range->data[start - range->address], end - start);
+        }
+    }
+}
+
+uint8_t nvm_eeprom_read_byte(const uint8_t *addr) {
+    uint8_t value;
+    nvm_eeprom_read_block(&value, addr, sizeof(value));
+    return value;
+}
+
+uint16_t nvm_eeprom_read_word(const uint16_t *addr) {
+    uint16_t value;
+    nvm_eeprom_read_block(&value, addr, sizeof(value));
+    return value;
+}
+
+uint32_t nvm_eeprom_read_dword(const uint32_t *addr) {
+    uint32_t value;
+    nvm_eeprom_read_block(&value, addr, sizeof(value));
+    return value;
+}
+
+void nvm_eeprom_update_block(const void *buf, void *addr, size_t len) {
+    uint32_t       address = (uintptr_t)addr;
+    const uint8_t *data    = (const uint8_t *)buf;
+
+    if (len > NVM_WRITE_BACK_RANGE_SIZE) {
+        // Too large to hold, so it goes straight through -- any pending copies need to agree with it
+        ranges_patch(address, data, len);
+        eeprom_update_block(buf, addr, len);
+        return;
+    }
+
+    // Skip updates which don't change anything, as the EEPROM drivers do
+    uint8_t current[NVM_WRITE_BACK_RANGE_SIZE];
+    nvm_eeprom_read_block(current, addr, len);
+    if (memcmp(current, data, len) == 0) {
+        return;
+    }
+
+    last_write = timer_read32();
+    ranges_patch(address, data, len);
+
+    nvm_write_back_range_t *range = NULL;
+    for (uint8_t i = 0; i < NVM_WRITE_BACK_RANGES && !range; i++) {
+        if (range_can_merge(&ranges[i], address, len)) {
+            range = &ranges[i];
+        }
+    }
+    if (!range) {
+        range = range_allocate();
+    }
+    range_merge(range, address, data, len);
+
+    // The range may have grown into its neighbours
+    bool merged;
+    do {
+        merged = false;
+        for (uint8_t i = 0; i < NVM_WRITE_BACK_RANGES; i++) {
+            nvm_write_back_range_t *other = &ranges[i];
+            if (other != range && other->length && range_can_merge(range, other->address, other->length)) {
+                range_merge(range, other->address, other->data, other->length);
+                other->length = 0;
+                merged        = true;
+            }
+        }
+    } while (merged);
+}
+
+void nvm_eeprom_update_byte(uint8_t *addr, uint8_t value) {
+    nvm_eeprom_update_block(&value, addr, sizeof(value));
+}
+
+void nvm_eeprom_update_word(uint16_t *addr, uint16_t value) {
+    nvm_eeprom_update_block(&value, addr, sizeof(value));
+}
+
+void nvm_eeprom_update_dword(uint32_t *addr, uint32_t value) {
+    nvm_eeprom_update_block(&value, addr, sizeof(value));
+}
+
+bool nvm_write_back_pending(void) {
+    for (uint8_t i = 0; i < NVM_WRITE_BACK_RANGES; i++) {
+        if (ranges[i].length) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void nvm_write_back_flush(void) {
+    for (uint8_t i = 0; i < NVM_WRITE_BACK_RANGES; i++) {
+        if (ranges[i].length) {
+            range_flush(&ranges[i]);
+        }
+    }
+}
+
+void nvm_write_back_discard(void) {
+    for (uint8_t i = 0; i < NVM_WRITE_BACK_RANGES; i++) {
+        ranges[i].length = 0;
+    }
+}
+
+void nvm_write_back_task(void) {
+    if (nvm_write_back_pending() && timer_elapsed32(last_write) >= NVM_WRITE_BACK_DELAY) {
+        nvm_write_back_flush();
+    }
+}
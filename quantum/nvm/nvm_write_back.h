@@ -0,0 +1,25 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdbool.h>
+
+/**
+ * @brief Flushes pending writes once no new ones have arrived for NVM_WRITE_BACK_DELAY milliseconds.
+ */
+void nvm_write_back_task(void);
+
+/**
+ * @brief Barrier: writes everything pending to the backing store before returning.
+ */
+void nvm_write_back_flush(void);
+
+/**
+ * @brief Whether any writes are waiting to be flushed.
+ */
+bool nvm_write_back_pending(void);
+
+/**
+ * @brief Drops pending writes, for when the backing store is about to be erased.
+ */
+void nvm_write_back_discard(void);
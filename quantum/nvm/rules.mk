@@ -28,4 +28,9 @@ else
 
     QUANTUM_SRC += nvm_eeconfig.c
 
+    ifeq ($(strip $(NVM_WRITE_BACK_ENABLE)), yes)
+        OPT_DEFS += -DNVM_WRITE_BACK_ENABLE
+        QUANTUM_SRC += nvm_write_back.c
+    endif
+
 endif
@@ -72,6 +72,23 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_CACHE_SIZE
+/**
+ * @def This controls the size (in bytes) of the RAM arena used to cache font glyphs and image frames, decoded to the
+ *      display's native pixel format. Drawing the same glyph or frame again sends the cached pixels directly instead of
+ *      decoding the asset, with the least recently used entries being evicted to make room. Set to 0 to disable.
+ */
+#    define QUANTUM_PAINTER_CACHE_SIZE 0
+#endif
+
+#ifndef QUANTUM_PAINTER_CACHE_ENTRIES
+/**
+ * @def This controls the maximum number of glyphs and image frames held in the cache at any one time, if
+ *      \ref QUANTUM_PAINTER_CACHE_SIZE is non-zero.
+ */
+#    define QUANTUM_PAINTER_CACHE_ENTRIES 32
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
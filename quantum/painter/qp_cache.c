@@ -0,0 +1,185 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "qp_internal.h"
+#include "qp_cache.h"
+
+#if QUANTUM_PAINTER_CACHE_SIZE > 0
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Cache storage
+
+// Entries hold their pixel data in a shared arena, in no particular order. Making room for a new entry evicts the least
+// recently used ones until a large enough gap appears, compacting the arena if the free space is fragmented.
+
+static uint8_t                   cache_arena[QUANTUM_PAINTER_CACHE_SIZE] __attribute__((aligned(4)));
+static qp_internal_cache_entry_t cache_entries[QUANTUM_PAINTER_CACHE_ENTRIES];
+static uint16_t                  cache_use_counter = 0;
+
+static inline bool qp_cache_pixel_equal(qp_pixel_t a, qp_pixel_t b) {
+    return a.hsv888.h == b.hsv888.h && a.hsv888.s == b.hsv888.s && a.hsv888.v == b.hsv888.v;
+}
+
+static inline bool qp_cache_key_equal(const qp_internal_cache_key_t* a, const qp_internal_cache_key_t* b) {
+    return a->device == b->device && a->asset == b->asset && a->id == b->id && qp_cache_pixel_equal(a->fg_hsv888, b->fg_hsv888) && qp_cache_pixel_equal(a->bg_hsv888, b->bg_hsv888);
+}
+
+static inline uint16_t qp_cache_age(const qp_internal_cache_entry_t* entry) {
+    return cache_use_counter - entry->last_used;
+}
+
+// Whether [offset, offset + length) is clear of every entry's pixel data
+static bool qp_cache_range_free(uint32_t offset, uint32_t length) {
+    if (offset + length > QUANTUM_PAINTER_CACHE_SIZE) {
+        return false;
+    }
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_CACHE_ENTRIES; ++i) {
+        const qp_internal_cache_entry_t* entry = &cache_entries[i];
+        if (entry->length && offset < entry->offset + entry->length && entry->offset < offset + length) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Gaps can only start at the beginning of the arena, or directly after an entry
+static bool qp_cache_find_gap(uint32_t length, uint32_t* offset) {
+    if (qp_cache_range_free(0, length)) {
+        *offset = 0;
+        return true;
+    }
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_CACHE_ENTRIES; ++i) {
+        const qp_internal_cache_entry_t* entry = &cache_entries[i];
+        if (entry->length && qp_cache_range_free(entry->offset + entry->length, length)) {
+            *offset = entry->offset + entry->length;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Moves every entry's pixel data to the start of the arena, leaving the free space in one piece at the end
+static void qp_cache_compact(void) {
+    uint32_t position = 0;
+    while (true) {
+        qp_internal_cache_entry_t* next = NULL;
+        for (uint16_t i = 0; i < QUANTUM_PAINTER_CACHE_ENTRIES; ++i) {
+            qp_internal_cache_entry_t* entry = &cache_entries[i];
+            if (entry->length && entry->offset >= position && (!next || entry->offset < next->offset)) {
+                next = entry;
+            }
+        }
+        if (!next) {
+            return;
+        }
+        if (next->offset != position) {
+            memmove(&cache_arena[position], &cache_arena[next->offset], next->length);
+            next->offset = position;
+        }
+        position += next->length;
+    }
+}
+
+static qp_internal_cache_entry_t* qp_cache_least_recently_used(void) {
+    qp_internal_cache_entry_t* victim = NULL;
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_CACHE_ENTRIES; ++i) {
+        qp_internal_cache_entry_t* entry = &cache_entries[i];
+        if (entry->length && (!victim || qp_cache_age(entry) > qp_cache_age(victim))) {
+            victim = entry;
+        }
+    }
+    return victim;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter Core API: cache
+
+qp_internal_cache_entry_t* qp_internal_cache_find(const qp_internal_cache_key_t* key) {
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_CACHE_ENTRIES; ++i) {
+        qp_internal_cache_entry_t* entry = &cache_entries[i];
+        if (entry->length && qp_cache_key_equal(&entry->key, key)) {
+            entry->last_used = ++cache_use_counter;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+qp_internal_cache_entry_t* qp_internal_cache_allocate(const qp_internal_cache_key_t* key, uint16_t width, uint16_t height) {
+    painter_driver_t* driver = (painter_driver_t*)key->device;
+    uint32_t          length = (((uint32_t)width) * height * driver->native_bits_per_pixel + 7) / 8;
+    if (length == 0 || length > QUANTUM_PAINTER_CACHE_SIZE) {
+        qp_dprintf("qp_internal_cache_allocate: fail (%d bytes will not fit in the cache)\n", (int)length);
+        return NULL;
+    }
+
+    // Drop any stale copy of the same key
+    qp_internal_cache_entry_t* existing = qp_internal_cache_find(key);
+    if (existing) {
+        qp_internal_cache_release(existing);
+    }
+
+    // Find a free slot, evicting if required
+    qp_internal_cache_entry_t* slot = NULL;
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_CACHE_ENTRIES && !slot; ++i) {
+        if (!cache_entries[i].length) {
+            slot = &cache_entries[i];
+        }
+    }
+    if (!slot) {
+        slot = qp_cache_least_recently_used();
+        qp_internal_cache_release(slot);
+    }
+
+    // Find room in the arena, evicting until there's enough in total and compacting if it's fragmented
+    uint32_t offset;
+    while (!qp_cache_find_gap(length, &offset)) {
+        uint32_t used = 0;
+        for (uint16_t i = 0; i < QUANTUM_PAINTER_CACHE_ENTRIES; ++i) {
+            used += cache_entries[i].length;
+        }
+        if (QUANTUM_PAINTER_CACHE_SIZE - used >= length) {
+            qp_cache_compact();
+        } else {
+            qp_internal_cache_release(qp_cache_least_recently_used());
+        }
+    }
+
+    memset(slot, 0, sizeof(qp_internal_cache_entry_t));
+    slot->key       = *key;
+    slot->width     = width;
+    slot->height    = height;
+    slot->offset    = offset;
+    slot->length    = length;
+    slot->last_used = ++cache_use_counter;
+    return slot;
+}
+
+void qp_internal_cache_release(qp_internal_cache_entry_t* entry) {
+    entry->length = 0;
+}
+
+uint8_t* qp_internal_cache_data(const qp_internal_cache_entry_t* entry) {
+    return &cache_arena[entry->offset];
+}
+
+bool qp_internal_cache_blit(painter_device_t device, const qp_internal_cache_entry_t* entry, uint16_t x, uint16_t y) {
+    painter_driver_t* driver = (painter_driver_t*)device;
+    uint16_t          l      = x + entry->left;
+    uint16_t          t      = y + entry->top;
+    if (!driver->driver_vtable->viewport(device, l, t, l + entry->width - 1, t + entry->height - 1)) {
+        qp_dprintf("qp_internal_cache_blit: fail (could not set viewport)\n");
+        return false;
+    }
+    return driver->driver_vtable->pixdata(device, qp_internal_cache_data(entry), ((uint32_t)entry->width) * entry->height);
+}
+
+void qp_internal_cache_invalidate(const void* asset) {
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_CACHE_ENTRIES; ++i) {
+        if (cache_entries[i].key.asset == asset) {
+            qp_internal_cache_release(&cache_entries[i]);
+        }
+    }
+}
+
+#endif // QUANTUM_PAINTER_CACHE_SIZE > 0
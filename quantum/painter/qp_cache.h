@@ -0,0 +1,65 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "qp_internal.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter decoded asset cache
+
+// Identifies a decoded glyph or frame -- the native pixels depend on the target device and, for assets without their
+// own palette, the colors used to draw them
+typedef struct qp_internal_cache_key_t {
+    painter_device_t device;
+    const void*      asset; // font or image handle
+    uint32_t         id;    // code point or frame number
+    qp_pixel_t       fg_hsv888;
+    qp_pixel_t       bg_hsv888;
+} qp_internal_cache_key_t;
+
+typedef struct qp_internal_cache_entry_t {
+    qp_internal_cache_key_t key;
+
+    // Location of the pixel data relative to the drawing position
+    uint16_t left;
+    uint16_t top;
+    uint16_t width;
+    uint16_t height;
+
+    // Frame delay, for animations
+    uint16_t delay;
+
+    uint16_t last_used;
+    uint32_t offset; // start of the pixel data in the arena
+    uint32_t length; // length of the pixel data, 0 when free
+} qp_internal_cache_entry_t;
+
+#if QUANTUM_PAINTER_CACHE_SIZE > 0
+
+// Finds the entry matching the key, marking it as recently used. Returns NULL if not present.
+qp_internal_cache_entry_t* qp_internal_cache_find(const qp_internal_cache_key_t* key);
+
+// Makes space for width x height native pixels, evicting the least recently used entries as required. Returns NULL if
+// the pixels could never fit. The caller fills in the pixel data, then either keeps the entry or releases it on failure.
+qp_internal_cache_entry_t* qp_internal_cache_allocate(const qp_internal_cache_key_t* key, uint16_t width, uint16_t height);
+
+// Frees an entry, such as one that could not be decoded
+void qp_internal_cache_release(qp_internal_cache_entry_t* entry);
+
+// The native pixel data held by an entry
+uint8_t* qp_internal_cache_data(const qp_internal_cache_entry_t* entry);
+
+// Sends the entry's pixel data to the device, relative to the supplied position. Expects comms to be started.
+bool qp_internal_cache_blit(painter_device_t device, const qp_internal_cache_entry_t* entry, uint16_t x, uint16_t y);
+
+// Drops every entry decoded from the asset, for when its handle is closed and may be reused
+void qp_internal_cache_invalidate(const void* asset);
+
+#else // QUANTUM_PAINTER_CACHE_SIZE > 0
+
+#    define qp_internal_cache_invalidate(asset) \
+        do {                                    \
+        } while (0)
+
+#endif // QUANTUM_PAINTER_CACHE_SIZE > 0
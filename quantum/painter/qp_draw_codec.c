@@ -9,9 +9,6 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Palette / Monochrome-format decoder
 
-static const qp_pixel_t qp_pixel_white = {.hsv888 = {.h = 0, .s = 0, .v = 255}};
-static const qp_pixel_t qp_pixel_black = {.hsv888 = {.h = 0, .s = 0, .v = 0}};
-
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel) {
 #if !(QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)
 #    if !(QUANTUM_PAINTER_SUPPORTS_256_PALETTE)
@@ -29,190 +26,283 @@ bool qp_internal_bpp_capable(uint8_t bits_per_pixel) {
     return true;
 }
 
-bool qp_internal_decode_palette(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_callback output_callback, void* output_arg) {
-    const uint8_t pixel_bitmask    = (1 << bits_per_pixel) - 1;
-    const uint8_t pixels_per_byte  = 8 / bits_per_pixel;
-    uint32_t      remaining_pixels = pixel_count; // don't try to derive from byte_count, we may not use an entire byte
-    while (remaining_pixels > 0) {
-        int16_t byteval = input_callback(input_arg);
-        if (byteval < 0) {
-            return false;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Block-based pull of spans of bytes, push of blocks of pixels
+
+// Reads the next span of up to max_bytes decompressed bytes into the buffer, returning the number of bytes or -1 on
+// failure. A repeating span is returned as a single byte in the buffer, with *repeating set.
+static int16_t qp_internal_read_span(qp_internal_byte_input_state_t* state, uint8_t* buffer, uint8_t max_bytes, bool* repeating) {
+    *repeating = false;
+
+    if (state->compression == IMAGE_UNCOMPRESSED) {
+        return qp_stream_read(buffer, 1, max_bytes, state->src_stream) == max_bytes ? max_bytes : -1;
+    }
+
+    // Work out if we're parsing the initial marker byte
+    if (state->rle.mode == MARKER_BYTE) {
+        int16_t c = qp_stream_get(state->src_stream);
+        if (c < 0) {
+            return -1;
         }
-        uint8_t loop_pixels = remaining_pixels < pixels_per_byte ? remaining_pixels : pixels_per_byte;
-        for (uint8_t q = 0; q < loop_pixels; ++q) {
-            if (!output_callback(palette, byteval & pixel_bitmask, output_arg)) {
-                return false;
+        if (c >= 128) {
+            state->rle.mode   = NON_REPEATING_RUN;
+            state->rle.remain = c - 127;
+        } else {
+            state->rle.mode   = REPEATING_RUN;
+            state->rle.remain = c;
+            state->curr       = qp_stream_get(state->src_stream);
+            if (state->curr < 0 || state->rle.remain == 0) {
+                return -1;
             }
-            byteval >>= bits_per_pixel;
         }
-        remaining_pixels -= loop_pixels;
     }
-    return true;
-}
 
-bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_pixel_output_callback output_callback, void* output_arg) {
-    return qp_internal_decode_recolor(device, pixel_count, bits_per_pixel, input_callback, input_arg, qp_pixel_white, qp_pixel_black, output_callback, output_arg);
+    uint8_t count = MIN(max_bytes, state->rle.remain);
+    if (state->rle.mode == REPEATING_RUN) {
+        buffer[0]  = state->curr;
+        *repeating = true;
+    } else if (qp_stream_read(buffer, 1, count, state->src_stream) != count) {
+        return -1;
+    }
+
+    // Swap back to querying the marker byte once the run is exhausted
+    state->rle.remain -= count;
+    if (state->rle.remain == 0) {
+        state->rle.mode = MARKER_BYTE;
+    }
+    return count;
 }
 
-bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg) {
-    painter_driver_t* driver = (painter_driver_t*)device;
-    int16_t           steps  = 1 << bits_per_pixel; // number of items we need to interpolate
-    if (qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, steps)) {
-        if (!driver->driver_vtable->palette_convert(device, steps, qp_internal_global_pixel_lookup_table)) {
-            return false;
-        }
+// Unpacks palette indices from the least significant bits of each byte first
+static inline void qp_internal_unpack_indices(const uint8_t* src, uint8_t byte_count, uint8_t bits_per_pixel, uint8_t* indices) {
+    switch (bits_per_pixel) {
+        case 1:
+            for (uint8_t i = 0; i < byte_count; ++i) {
+                uint8_t b = src[i];
+                for (uint8_t q = 0; q < 8; ++q, b >>= 1) {
+                    *indices++ = b & 0x01;
+                }
+            }
+            break;
+        case 2:
+            for (uint8_t i = 0; i < byte_count; ++i) {
+                uint8_t b  = src[i];
+                *indices++ = b & 0x03;
+                *indices++ = (b >> 2) & 0x03;
+                *indices++ = (b >> 4) & 0x03;
+                *indices++ = b >> 6;
+            }
+            break;
+        case 4:
+            for (uint8_t i = 0; i < byte_count; ++i) {
+                *indices++ = src[i] & 0x0F;
+                *indices++ = src[i] >> 4;
+            }
+            break;
+        case 8:
+            memcpy(indices, src, byte_count);
+            break;
     }
+}
+
+// Where decoded native pixels are written -- either the global pixdata buffer, which is sent to the display whenever it
+// fills up, or a caller-supplied buffer large enough for the whole asset
+typedef struct qp_internal_block_output_t {
+    painter_device_t device;
+    uint8_t*         buffer;
+    uint32_t         write_pos;  // in pixels for palette decoding, in bytes for native pixel data
+    uint32_t         flush_size; // write_pos at which the buffer is sent to the display, 0 to never send
+} qp_internal_block_output_t;
+
+static bool qp_internal_block_flush(qp_internal_block_output_t* output, uint32_t pixel_count) {
+    painter_driver_t* driver = (painter_driver_t*)output->device;
+    output->write_pos        = 0;
+    return driver->driver_vtable->pixdata(output->device, output->buffer, pixel_count);
+}
 
-    return qp_internal_decode_palette(device, pixel_count, bits_per_pixel, input_callback, input_arg, qp_internal_global_pixel_lookup_table, output_callback, output_arg);
+// Space left before the output needs flushing
+static inline uint32_t qp_internal_block_space(qp_internal_block_output_t* output, uint32_t wanted) {
+    return output->flush_size ? MIN(wanted, output->flush_size - output->write_pos) : wanted;
 }
 
-bool qp_internal_send_bytes(painter_device_t device, uint32_t byte_count, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_byte_output_callback output_callback, void* output_arg) {
-    uint32_t remaining_bytes = byte_count;
-    while (remaining_bytes > 0) {
-        int16_t byteval = input_callback(input_arg);
-        if (byteval < 0) {
+static bool qp_internal_block_append_pixels(qp_internal_block_output_t* output, qp_pixel_t* palette, uint8_t* indices, uint32_t pixel_count) {
+    painter_driver_t* driver = (painter_driver_t*)output->device;
+    while (pixel_count > 0) {
+        uint32_t n = qp_internal_block_space(output, pixel_count);
+        if (!driver->driver_vtable->append_pixels(output->device, output->buffer, palette, output->write_pos, n, indices)) {
             return false;
         }
-        if (!output_callback(byteval, output_arg)) {
+        output->write_pos += n;
+        indices += n;
+        pixel_count -= n;
+        if (output->write_pos == output->flush_size && !qp_internal_block_flush(output, output->write_pos)) {
             return false;
         }
-        remaining_bytes -= 1;
     }
     return true;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Progressive pull of bytes, push of pixels
-
-static inline int16_t qp_drawimage_byte_uncompressed_decoder(void* cb_arg) {
-    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
-    state->curr                           = qp_stream_get(state->src_stream);
-    return state->curr;
-}
-
-static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
-    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
-
-    // Work out if we're parsing the initial marker byte
-    if (state->rle.mode == MARKER_BYTE) {
-        uint8_t c = qp_stream_get(state->src_stream);
-        if (c >= 128) {
-            state->rle.mode   = NON_REPEATING_RUN; // non-repeated run
-            state->rle.remain = c - 127;
-        } else {
-            state->rle.mode   = REPEATING_RUN; // repeated run
-            state->rle.remain = c;
+// Writes the same palette entry pixel_count times. Byte-aligned native pixels are converted once and then copied.
+static bool qp_internal_block_fill_pixels(qp_internal_block_output_t* output, qp_pixel_t* palette, uint8_t index, uint32_t pixel_count) {
+    painter_driver_t* driver          = (painter_driver_t*)output->device;
+    uint8_t           bytes_per_pixel = driver->native_bits_per_pixel / 8;
+    if (driver->native_bits_per_pixel % 8 != 0) {
+        uint8_t indices[QP_DECODE_BLOCK_BYTES * 8];
+        memset(indices, index, sizeof(indices));
+        while (pixel_count > 0) {
+            uint32_t n = MIN(pixel_count, sizeof(indices));
+            if (!qp_internal_block_append_pixels(output, palette, indices, n)) {
+                return false;
+            }
+            pixel_count -= n;
         }
-
-        state->curr = qp_stream_get(state->src_stream);
+        return true;
     }
 
-    // Work out which byte we're returning
-    uint8_t c = state->curr;
+    while (pixel_count > 0) {
+        uint32_t n = qp_internal_block_space(output, pixel_count);
+        if (!driver->driver_vtable->append_pixels(output->device, output->buffer, palette, output->write_pos, 1, &index)) {
+            return false;
+        }
 
-    // Decrement the counter of the bytes remaining
-    state->rle.remain--;
+        // Double up the converted pixels until the span is filled
+        uint8_t* start  = &output->buffer[output->write_pos * bytes_per_pixel];
+        uint32_t filled = 1;
+        while (filled < n) {
+            uint32_t copy = MIN(filled, n - filled);
+            memcpy(&start[filled * bytes_per_pixel], start, copy * bytes_per_pixel);
+            filled += copy;
+        }
 
-    if (state->rle.remain > 0) {
-        // If we're in a non-repeating run, queue up the next byte
-        if (state->rle.mode == NON_REPEATING_RUN) {
-            state->curr = qp_stream_get(state->src_stream);
+        output->write_pos += n;
+        pixel_count -= n;
+        if (output->write_pos == output->flush_size && !qp_internal_block_flush(output, output->write_pos)) {
+            return false;
         }
-    } else {
-        // Swap back to querying the marker byte mode
-        state->rle.mode = MARKER_BYTE;
     }
-
-    return c;
+    return true;
 }
 
-bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg) {
-    qp_internal_pixel_output_state_t* state  = (qp_internal_pixel_output_state_t*)cb_arg;
-    painter_driver_t*                 driver = (painter_driver_t*)state->device;
+static bool qp_internal_block_decode_palette(qp_internal_block_output_t* output, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_state_t* input_state, qp_pixel_t* palette) {
+    const uint8_t pixels_per_byte = 8 / bits_per_pixel;
+    uint8_t       bytes[QP_DECODE_BLOCK_BYTES];
+    uint8_t       indices[QP_DECODE_BLOCK_BYTES * 8];
+
+    while (pixel_count > 0) {
+        // Don't read past the end of this asset's pixel data
+        uint32_t bytes_left = (pixel_count + pixels_per_byte - 1) / pixels_per_byte;
+        bool     repeating;
+        int16_t  byte_count = qp_internal_read_span(input_state, bytes, MIN(bytes_left, QP_DECODE_BLOCK_BYTES), &repeating);
+        if (byte_count < 0) {
+            return false;
+        }
+
+        // Any bits past the last pixel of the final byte are padding
+        uint32_t span_pixels = MIN((uint32_t)byte_count * pixels_per_byte, pixel_count);
+        qp_internal_unpack_indices(bytes, repeating ? 1 : byte_count, bits_per_pixel, indices);
 
-    if (!driver->driver_vtable->append_pixels(state->device, qp_internal_global_pixdata_buffer, palette, state->pixel_write_pos++, 1, &index)) {
-        return false;
-    }
+        if (repeating) {
+            // RLE runs where every pixel in the byte is the same become fills
+            bool uniform = true;
+            for (uint8_t i = 1; i < pixels_per_byte; ++i) {
+                uniform &= indices[i] == indices[0];
+            }
+            if (uniform) {
+                if (!qp_internal_block_fill_pixels(output, palette, indices[0], span_pixels)) {
+                    return false;
+                }
+                pixel_count -= span_pixels;
+                continue;
+            }
 
-    // If we've hit the transmit limit, send out the entire buffer and reset the write position
-    if (state->pixel_write_pos == state->max_pixels) {
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
+            // Otherwise repeat the byte's pattern across the block
+            for (uint32_t filled = pixels_per_byte; filled < (uint32_t)byte_count * pixels_per_byte; filled *= 2) {
+                memcpy(&indices[filled], indices, MIN(filled, (uint32_t)byte_count * pixels_per_byte - filled));
+            }
+        }
+
+        if (!qp_internal_block_append_pixels(output, palette, indices, span_pixels)) {
             return false;
         }
-        state->pixel_write_pos = 0;
+        pixel_count -= span_pixels;
     }
-
     return true;
 }
 
-bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
-    qp_internal_byte_output_state_t* state  = (qp_internal_byte_output_state_t*)cb_arg;
-    painter_driver_t*                driver = (painter_driver_t*)state->device;
+static bool qp_internal_block_send_bytes(qp_internal_block_output_t* output, uint32_t byte_count, qp_internal_byte_input_state_t* input_state) {
+    painter_driver_t* driver = (painter_driver_t*)output->device;
+    uint8_t           bytes[QP_DECODE_BLOCK_BYTES];
 
-    if (!driver->driver_vtable->append_pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos++, byteval)) {
-        return false;
-    }
-
-    // If we've hit the transmit limit, send out the entire buffer and reset the write position
-    if (state->byte_write_pos == state->max_bytes) {
-        painter_driver_t* driver = (painter_driver_t*)state->device;
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
+    while (byte_count > 0) {
+        bool    repeating;
+        int16_t span_bytes = qp_internal_read_span(input_state, bytes, MIN(byte_count, QP_DECODE_BLOCK_BYTES), &repeating);
+        if (span_bytes < 0) {
             return false;
         }
-        state->byte_write_pos = 0;
+        for (int16_t i = 0; i < span_bytes; ++i) {
+            if (!driver->driver_vtable->append_pixdata(output->device, output->buffer, output->write_pos++, bytes[repeating ? 0 : i])) {
+                return false;
+            }
+            if (output->write_pos == output->flush_size && !qp_internal_block_flush(output, output->write_pos * 8 / driver->native_bits_per_pixel)) {
+                return false;
+            }
+        }
+        byte_count -= span_bytes;
     }
-
     return true;
 }
 
-// Helper shared between image and font rendering -- uses either (qp_internal_decode_palette + qp_internal_pixel_appender) or (qp_internal_send_bytes) to send data data to the display based on the asset's native-ness
-bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state) {
-    painter_driver_t* driver = (painter_driver_t*)device;
-
-    bool ret = false;
+static bool qp_internal_block_decode(qp_internal_block_output_t* output, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_state_t* input_state) {
+    painter_driver_t* driver = (painter_driver_t*)output->device;
 
     // Non-native pixel format
     if (bpp <= 8) {
-        // Set up the output state
-        qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
-
-        // Decode the pixel data and stream to the display
-        ret = qp_internal_decode_palette(device, pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
-        // Any leftovers need transmission as well.
-        if (ret && output_state.pixel_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
-        }
+        return qp_internal_block_decode_palette(output, pixel_count, bpp, input_state, qp_internal_global_pixel_lookup_table);
     }
 
     // Native pixel format
-    else if (bpp != driver->native_bits_per_pixel) {
+    if (bpp != driver->native_bits_per_pixel) {
         qp_dprintf("Asset's bpp (%d) doesn't match the target display's native_bits_per_pixel (%d)\n", bpp, driver->native_bits_per_pixel);
         return false;
-    } else {
-        // Set up the output state
-        qp_internal_byte_output_state_t output_state = {.device = device, .byte_write_pos = 0, .max_bytes = qp_internal_num_pixels_in_buffer(device) * driver->native_bits_per_pixel / 8};
-
-        // Stream the raw pixel data to the display
-        uint32_t byte_count = pixel_count * bpp / 8;
-        ret                 = qp_internal_send_bytes(device, byte_count, input_callback, input_state, qp_internal_byte_appender, &output_state);
-        // Any leftovers need transmission as well.
-        if (ret && output_state.byte_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
-        }
     }
+    if (output->flush_size) {
+        output->flush_size = output->flush_size * bpp / 8;
+    }
+    return qp_internal_block_send_bytes(output, pixel_count * bpp / 8, input_state);
+}
+
+// Helper shared between image and font rendering -- decodes the asset's pixel data in blocks to the display's native format, sending it to the display whenever the pixdata buffer is full
+bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_state_t* input_state) {
+    painter_driver_t*          driver = (painter_driver_t*)device;
+    qp_internal_block_output_t output = {.device = device, .buffer = qp_internal_global_pixdata_buffer, .write_pos = 0, .flush_size = qp_internal_num_pixels_in_buffer(device)};
 
+    bool ret = qp_internal_block_decode(&output, bpp, pixel_count, input_state);
+
+    // Any leftovers need transmission as well.
+    if (ret && output.write_pos > 0) {
+        uint32_t leftover_pixels = bpp <= 8 ? output.write_pos : output.write_pos * 8 / driver->native_bits_per_pixel;
+        ret &= qp_internal_block_flush(&output, leftover_pixels);
+    }
     return ret;
 }
 
-qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression) {
+// Same as qp_internal_appender, but decodes the whole asset into the supplied buffer of native pixels instead of sending it to the display
+bool qp_internal_decode_to_buffer(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_state_t* input_state, uint8_t* buffer) {
+    qp_internal_block_output_t output = {.device = device, .buffer = buffer, .write_pos = 0, .flush_size = 0};
+    return qp_internal_block_decode(&output, bpp, pixel_count, input_state);
+}
+
+bool qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression) {
     switch (compression) {
         case IMAGE_UNCOMPRESSED:
-            return qp_drawimage_byte_uncompressed_decoder;
+            input_state->compression = compression;
+            return true;
         case IMAGE_COMPRESSED_RLE:
-            input_state->rle.mode   = MARKER_BYTE;
-            input_state->rle.remain = 0;
-            return qp_drawimage_byte_rle_decoder;
+            input_state->compression = compression;
+            input_state->rle.mode    = MARKER_BYTE;
+            input_state->rle.remain  = 0;
+            return true;
         default:
-            return NULL;
+            return false;
     }
 }
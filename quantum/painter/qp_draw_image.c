@@ -4,6 +4,7 @@
 #include "qp_internal.h"
 #include "qp_draw.h"
 #include "qp_comms.h"
+#include "qp_cache.h"
 #include "qgf.h"
 #include "deferred_exec.h"
 
@@ -96,6 +97,7 @@ bool qp_close_image(painter_image_handle_t image) {
     }
 
     // Free up this image for use elsewhere.
+    qp_internal_cache_invalidate(qgf_image);
     qgf_image->validate_ok = false;
     qp_stream_close(&qgf_image->stream);
     return true;
@@ -222,6 +224,23 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
+#if QUANTUM_PAINTER_CACHE_SIZE > 0
+    // Send the frame directly if it's already been decoded
+    qp_internal_cache_key_t    key   = {.device = device, .asset = qgf_image, .id = frame_number, .fg_hsv888 = fg_hsv888, .bg_hsv888 = bg_hsv888};
+    qp_internal_cache_entry_t *entry = qp_internal_cache_find(&key);
+    if (entry) {
+        if (!qp_comms_start(device)) {
+            qp_dprintf("qp_drawimage_recolor: fail (could not start comms)\n");
+            return false;
+        }
+        bool ret          = qp_internal_cache_blit(device, entry, x, y);
+        frame_info->delay = entry->delay;
+        qp_dprintf("qp_drawimage_recolor: %s (cached)\n", ret ? "ok" : "fail");
+        qp_comms_stop(device);
+        return ret;
+    }
+#endif // QUANTUM_PAINTER_CACHE_SIZE > 0
+
     // Read the frame info
     if (!qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, frame_info)) {
         qp_dprintf("qp_drawimage_recolor: fail (could not read frame %d)\n", frame_number);
@@ -255,16 +274,35 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
     }
 
     // Set up the input state
-    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qgf_image->stream};
-    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme);
-    if (input_callback == NULL) {
+    qp_internal_byte_input_state_t input_state = {.device = device, .src_stream = &qgf_image->stream};
+    if (!qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme)) {
         qp_dprintf("qp_drawimage_recolor: fail (invalid image compression scheme)\n");
         qp_comms_stop(device);
         return false;
     }
 
+#if QUANTUM_PAINTER_CACHE_SIZE > 0
+    // Decode into the cache if there's room, then send it from there
+    entry = qp_internal_cache_allocate(&key, r - l + 1, b - t + 1);
+    if (entry) {
+        entry->left  = l - x;
+        entry->top   = t - y;
+        entry->delay = frame_info->delay;
+        if (!qp_internal_decode_to_buffer(device, frame_info->bpp, pixel_count, &input_state, qp_internal_cache_data(entry))) {
+            qp_dprintf("qp_drawimage_recolor: fail (could not decode frame %d)\n", frame_number);
+            qp_internal_cache_release(entry);
+            qp_comms_stop(device);
+            return false;
+        }
+        bool ret = driver->driver_vtable->pixdata(device, qp_internal_cache_data(entry), pixel_count);
+        qp_dprintf("qp_drawimage_recolor: %s\n", ret ? "ok" : "fail");
+        qp_comms_stop(device);
+        return ret;
+    }
+#endif // QUANTUM_PAINTER_CACHE_SIZE > 0
+
     // Decode and stream pixels
-    bool ret = qp_internal_appender(device, frame_info->bpp, pixel_count, input_callback, &input_state);
+    bool ret = qp_internal_appender(device, frame_info->bpp, pixel_count, &input_state);
 
     qp_dprintf("qp_drawimage_recolor: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
@@ -7,6 +7,7 @@
 #include "qp_internal.h"
 #include "qp_draw.h"
 #include "qp_comms.h"
+#include "qp_cache.h"
 #include "qff.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -152,6 +153,7 @@ bool qp_close_font(painter_font_handle_t font) {
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
     // Free up this font for use elsewhere.
+    qp_internal_cache_invalidate(qff_font);
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
     return true;
@@ -163,6 +165,9 @@ bool qp_close_font(painter_font_handle_t font) {
 // Callback to be invoked for each codepoint detected in the UTF8 input string
 typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg);
 
+// Optional callback invoked before looking up each codepoint in the font, setting `handled` if the glyph needs nothing from the font
+typedef bool (*code_point_cached_handler)(qff_font_handle_t *qff_font, uint32_t code_point, bool *handled, void *cb_arg);
+
 // Helper that sets up the palette (if required) and returns the offset in the stream that the data starts
 static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t *data_offset) {
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -293,7 +298,7 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
 }
 
 // Function to iterate over each UTF8 codepoint, invoking the callback for each decoded glyph
-static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const char *str, code_point_handler handler, void *cb_arg) {
+static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const char *str, code_point_cached_handler cached_handler, code_point_handler handler, void *cb_arg) {
     while (*str) {
         int32_t code_point = 0;
         str                = decode_utf8(str, &code_point);
@@ -302,6 +307,15 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
             return false;
         }
 
+        bool handled = false;
+        if (cached_handler && !cached_handler(qff_font, code_point, &handled, cb_arg)) {
+            qp_dprintf("Failed to execute cached glyph handler.\n");
+            return false;
+        }
+        if (handled) {
+            continue;
+        }
+
         uint8_t width;
         if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
             qp_dprintf("Failed to prepare glyph for rendering.\n");
@@ -339,14 +353,35 @@ static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_f
 
 // Callback state
 typedef struct code_point_iter_drawglyph_state_t {
-    painter_device_t                  device;
-    int16_t                           xpos;
-    int16_t                           ypos;
-    qp_internal_byte_input_callback   input_callback;
-    qp_internal_byte_input_state_t   *input_state;
-    qp_internal_pixel_output_state_t *output_state;
+    painter_device_t                device;
+    int16_t                         xpos;
+    int16_t                         ypos;
+    qp_internal_byte_input_state_t *input_state;
+    qp_pixel_t                      fg_hsv888;
+    qp_pixel_t                      bg_hsv888;
 } code_point_iter_drawglyph_state_t;
 
+#if QUANTUM_PAINTER_CACHE_SIZE > 0
+static inline qp_internal_cache_key_t qp_font_glyph_cache_key(qff_font_handle_t *qff_font, uint32_t code_point, code_point_iter_drawglyph_state_t *state) {
+    return (qp_internal_cache_key_t){.device = state->device, .asset = qff_font, .id = code_point, .fg_hsv888 = state->fg_hsv888, .bg_hsv888 = state->bg_hsv888};
+}
+
+// Codepoint handler callback: drawing glyphs which have already been decoded
+static inline bool qp_font_code_point_handler_drawcached(qff_font_handle_t *qff_font, uint32_t code_point, bool *handled, void *cb_arg) {
+    code_point_iter_drawglyph_state_t *state = (code_point_iter_drawglyph_state_t *)cb_arg;
+    qp_internal_cache_key_t            key   = qp_font_glyph_cache_key(qff_font, code_point, state);
+    qp_internal_cache_entry_t         *entry = qp_internal_cache_find(&key);
+    if (!entry) {
+        return true;
+    }
+
+    *handled = true;
+    bool ret = qp_internal_cache_blit(state->device, entry, state->xpos, state->ypos);
+    state->xpos += entry->width;
+    return ret;
+}
+#endif // QUANTUM_PAINTER_CACHE_SIZE > 0
+
 // Codepoint handler callback: drawing
 static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
     code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
@@ -355,8 +390,22 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
     // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
     state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
 
-    // Reset the output state
-    state->output_state->pixel_write_pos = 0;
+    uint32_t pixel_count = ((uint32_t)width) * height;
+
+#if QUANTUM_PAINTER_CACHE_SIZE > 0
+    // Decode into the cache if there's room, then send it from there
+    qp_internal_cache_key_t    key   = qp_font_glyph_cache_key(qff_font, code_point, state);
+    qp_internal_cache_entry_t *entry = qp_internal_cache_allocate(&key, width, height);
+    if (entry) {
+        if (!qp_internal_decode_to_buffer(state->device, qff_font->bpp, pixel_count, state->input_state, qp_internal_cache_data(entry))) {
+            qp_internal_cache_release(entry);
+            return false;
+        }
+        bool ret = qp_internal_cache_blit(state->device, entry, state->xpos, state->ypos);
+        state->xpos += width;
+        return ret;
+    }
+#endif // QUANTUM_PAINTER_CACHE_SIZE > 0
 
     // Configure where we're going to be rendering to
     driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + width - 1, state->ypos + height - 1);
@@ -365,8 +414,7 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
     state->xpos += width;
 
     // Decode the pixel data for the glyph, and stream it
-    uint32_t pixel_count = ((uint32_t)width) * height;
-    return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state);
+    return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_state);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -382,7 +430,7 @@ int16_t qp_textwidth(painter_font_handle_t font, const char *str) {
     // Create the codepoint iterator state
     code_point_iter_calcwidth_state_t state = {.width = 0};
     // Iterate each codepoint, return the calculated width if successful.
-    return qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_calcwidth, &state) ? state.width : 0;
+    return qp_iterate_code_points(qff_font, str, NULL, qp_font_code_point_handler_calcwidth, &state) ? state.width : 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -416,17 +464,16 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
         return 0;
     }
 
-    // Set up the byte input state and input callback
-    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qff_font->stream};
-    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, qff_font->compression_scheme);
-    if (input_callback == NULL) {
+    // Set up the byte input state
+    qp_internal_byte_input_state_t input_state = {.device = device, .src_stream = &qff_font->stream};
+    if (!qp_internal_prepare_input_state(&input_state, qff_font->compression_scheme)) {
         qp_dprintf("qp_drawtext_recolor: fail (invalid font compression scheme)\n");
         qp_comms_stop(device);
         return false;
     }
 
-    // Set up the pixel output state
-    qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
+    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
 
     // Set up the codepoint iteration state
     code_point_iter_drawglyph_state_t state = {// Common
@@ -434,14 +481,12 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
                                                .xpos   = x,
                                                .ypos   = y,
                                                // Input
-                                               .input_callback = input_callback,
-                                               .input_state    = &input_state,
-                                               // Output
-                                               .output_state = &output_state};
+                                               .input_state = &input_state,
+                                               // Colors
+                                               .fg_hsv888 = fg_hsv888,
+                                               .bg_hsv888 = bg_hsv888};
 
-    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
-    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
-    uint32_t   data_offset;
+    uint32_t data_offset;
     if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
         qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
         qp_comms_stop(device);
@@ -449,7 +494,11 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
     }
 
     // Iterate the codepoints with the drawglyph callback
-    bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
+#if QUANTUM_PAINTER_CACHE_SIZE > 0
+    bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawcached, qp_font_code_point_handler_drawglyph, &state);
+#else  // QUANTUM_PAINTER_CACHE_SIZE > 0
+    bool ret = qp_iterate_code_points(qff_font, str, NULL, qp_font_code_point_handler_drawglyph, &state);
+#endif // QUANTUM_PAINTER_CACHE_SIZE > 0
 
     qp_dprintf("qp_drawtext_recolor: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
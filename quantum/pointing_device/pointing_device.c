@@ -42,6 +42,7 @@
 #if defined(SPLIT_POINTING_ENABLE)
 #    include "transactions.h"
 #    include "keyboard.h"
+#    include "sync_timer.h"
 
 report_mouse_t shared_mouse_report = {};
 uint16_t       shared_cpi          = 0;
@@ -88,6 +89,40 @@ static pointing_device_status_t pointing_device_status     = POINTING_DEVICE_STA
 static uint16_t hires_scroll_resolution;
 #endif
 
+#if defined(SPLIT_POINTING_FUSION)
+#    if !defined(POINTING_DEVICE_ACCUMULATOR_ENABLE)
+#        error SPLIT_POINTING_FUSION requires POINTING_DEVICE_ACCUMULATOR_ENABLE
+#    endif
+static pointing_device_fusion_t motion_fusion = {
+    .local_motion  = {.numerator = 1, .denominator = 1},
+    .remote_motion = {.numerator = 1, .denominator = 1},
+};
+
+/**
+ * @brief Takes in the motion published by the other side
+ *
+ * NOTE : Only available when using SPLIT_POINTING_FUSION
+ *
+ * @param[in] motion pointing_device_motion_t
+ */
+void pointing_device_set_shared_motion(const pointing_device_motion_t *motion) {
+    pointing_device_fusion_set_remote(&motion_fusion, motion);
+}
+#elif defined(POINTING_DEVICE_ACCUMULATOR_ENABLE)
+#    if defined(SPLIT_POINTING_ENABLE)
+#        error POINTING_DEVICE_ACCUMULATOR_ENABLE requires SPLIT_POINTING_FUSION when sharing the pointing device report between sides.
+#    endif
+static pointing_device_accumulator_t motion_accumulator = {.numerator = 1, .denominator = 1};
+#endif
+
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+#    if defined(SPLIT_POINTING_ENABLE)
+#        error POINTING_DEVICE_MOTION_INTERRUPT not supported when sharing the pointing device report between sides.
+#    endif
+// Starts out set so that whatever the sensor gathered before init is read
+static volatile bool motion_detected = true;
+#endif
+
 #define POINTING_DEVICE_DRIVER_CONCAT(name) name##_pointing_device_driver
 #define POINTING_DEVICE_DRIVER(name) POINTING_DEVICE_DRIVER_CONCAT(name)
 
@@ -230,6 +265,93 @@ void pointing_device_set_status(pointing_device_status_t status) {
     pointing_device_status = status;
 }
 
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+/**
+ * @brief Flags that the sensor has motion to be read
+ *
+ * Meant to be called from the interrupt handler of the sensor's motion pin, the next pointing device task then reads the sensor.
+ *
+ * NOTE : Only available when using POINTING_DEVICE_MOTION_INTERRUPT
+ */
+void pointing_device_motion_detected(void) {
+    motion_detected = true;
+}
+#endif
+
+/**
+ * @brief Checks whether the sensor has motion to be read
+ *
+ * Consumes the flag set by pointing_device_motion_detected or checks the motion pin, if either is configured.
+ *
+ * @return true if the sensor should be read
+ */
+static inline bool pointing_device_motion_pending(void) {
+#if defined(POINTING_DEVICE_MOTION_INTERRUPT)
+    // Cleared before reading, so motion flagged during the read isn't lost
+    if (!motion_detected) {
+        return false;
+    }
+    motion_detected = false;
+    return true;
+#elif defined(POINTING_DEVICE_MOTION_PIN)
+#    if defined(SPLIT_POINTING_ENABLE)
+#        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
+#    endif
+#    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+    return !gpio_read_pin(POINTING_DEVICE_MOTION_PIN);
+#    else
+    return gpio_read_pin(POINTING_DEVICE_MOTION_PIN);
+#    endif
+#else
+    return true;
+#endif
+}
+
+#ifdef POINTING_DEVICE_ACCUMULATOR_ENABLE
+/**
+ * @brief Reads the sensor and adds its motion to the accumulator
+ *
+ * Called on every pointing device task, independent of POINTING_DEVICE_TASK_THROTTLE_MS, so the sensor is read as often as the
+ * main loop allows and reports to the host carry the sum of all reads since the previous one.
+ */
+static void pointing_device_accumulate(void) {
+#    if defined(SPLIT_POINTING_ENABLE)
+    if (!(POINTING_DEVICE_THIS_SIDE)) {
+        return;
+    }
+#    endif
+    if (pointing_device_get_status() != POINTING_DEVICE_STATUS_SUCCESS || !pointing_device_motion_pending()) {
+        return;
+    }
+    report_mouse_t sample = {.buttons = local_mouse_report.buttons};
+    sample                     = pointing_device_driver->get_report(sample);
+    local_mouse_report.buttons = sample.buttons;
+#    if defined(SPLIT_POINTING_FUSION)
+    pointing_device_fusion_add_local(&motion_fusion, sample, sync_timer_read());
+#    else
+    pointing_device_accumulator_add(&motion_accumulator, sample);
+#    endif
+}
+
+/**
+ * @brief Sets the factor sensor motion is scaled by before it is sent to the host
+ *
+ * Fractions of a count left over by scaling are carried into the following reports.
+ *
+ * NOTE : Only available when using POINTING_DEVICE_ACCUMULATOR_ENABLE
+ *
+ * @param[in] numerator uint8_t
+ * @param[in] denominator uint8_t
+ */
+void pointing_device_set_motion_scale(uint8_t numerator, uint8_t denominator) {
+#    if defined(SPLIT_POINTING_FUSION)
+    pointing_device_fusion_set_scale(&motion_fusion, numerator, denominator);
+#    else
+    pointing_device_accumulator_set_scale(&motion_accumulator, numerator, denominator);
+#    endif
+}
+#endif
+
 /**
  * @brief Sends processed mouse report to host
  *
@@ -303,6 +425,10 @@ __attribute__((weak)) bool pointing_device_task(void) {
     };
 #endif
 
+#ifdef POINTING_DEVICE_ACCUMULATOR_ENABLE
+    pointing_device_accumulate();
+#endif
+
 #if (POINTING_DEVICE_TASK_THROTTLE_MS > 0)
     static uint32_t last_exec = 0;
     if (timer_elapsed32(last_exec) < POINTING_DEVICE_TASK_THROTTLE_MS) {
@@ -316,36 +442,37 @@ __attribute__((weak)) bool pointing_device_task(void) {
     }
 
     // Gather report info
-#ifdef POINTING_DEVICE_MOTION_PIN
-#    if defined(SPLIT_POINTING_ENABLE)
-#        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
+#if defined(SPLIT_POINTING_FUSION)
+#    if defined(SPLIT_POINTING_STREAM)
+    // Don't wait for the next sync for the other side's latest motion
+    transactions_pointing_fetch();
 #    endif
-#    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
-    if (!gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
-#    else
-    if (gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
+    pointing_device_fusion_take(&motion_fusion, sync_timer_read(), &local_mouse_report, &shared_mouse_report);
+#    if defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
+    if (!(POINTING_DEVICE_THIS_SIDE)) {
+        local_mouse_report = shared_mouse_report;
+    }
 #    endif
-    {
-#endif
-
-#if defined(SPLIT_POINTING_ENABLE)
-#    if defined(POINTING_DEVICE_COMBINED)
+#elif defined(POINTING_DEVICE_ACCUMULATOR_ENABLE)
+    local_mouse_report = pointing_device_accumulator_take(&motion_accumulator, local_mouse_report);
+#else
+    if (pointing_device_motion_pending()) {
+#    if defined(SPLIT_POINTING_ENABLE)
+#        if defined(POINTING_DEVICE_COMBINED)
         static uint8_t old_buttons = 0;
         local_mouse_report.buttons = old_buttons;
         local_mouse_report         = pointing_device_driver->get_report(local_mouse_report);
         old_buttons                = local_mouse_report.buttons;
-#    elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
+#        elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
         local_mouse_report = POINTING_DEVICE_THIS_SIDE ? pointing_device_driver->get_report(local_mouse_report) : shared_mouse_report;
+#        else
+#            error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
+#        endif
 #    else
-#        error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
-#    endif
-#else
-    local_mouse_report = pointing_device_driver->get_report(local_mouse_report);
-#endif // defined(SPLIT_POINTING_ENABLE)
-
-#ifdef POINTING_DEVICE_MOTION_PIN
+        local_mouse_report = pointing_device_driver->get_report(local_mouse_report);
+#    endif // defined(SPLIT_POINTING_ENABLE)
     }
-#endif
+#endif // defined(POINTING_DEVICE_ACCUMULATOR_ENABLE)
 
     // allow kb to intercept and modify report
 #if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
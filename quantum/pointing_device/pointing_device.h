@@ -33,6 +33,14 @@ typedef struct {
 #    include "pointing_device_auto_mouse.h"
 #endif
 
+#ifdef POINTING_DEVICE_ACCUMULATOR_ENABLE
+#    include "pointing_device_accumulator.h"
+#endif
+
+#ifdef SPLIT_POINTING_FUSION
+#    include "pointing_device_fusion.h"
+#endif
+
 #if defined(POINTING_DEVICE_DRIVER_adns5050)
 #    include "drivers/sensors/adns5050.h"
 #    define POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
@@ -140,9 +148,30 @@ void           pointing_device_keycode_handler(uint16_t keycode, bool pressed);
 uint16_t pointing_device_get_hires_scroll_resolution(void);
 #endif
 
+#ifdef POINTING_DEVICE_MOTION_INTERRUPT
+void pointing_device_motion_detected(void);
+#endif
+
+#ifdef POINTING_DEVICE_ACCUMULATOR_ENABLE
+void pointing_device_set_motion_scale(uint8_t numerator, uint8_t denominator);
+// The sensor is read on every task call, this only limits how often reports are sent
+#    if !defined(POINTING_DEVICE_TASK_THROTTLE_MS)
+#        if defined(USB_POLLING_INTERVAL_MS)
+#            define POINTING_DEVICE_TASK_THROTTLE_MS USB_POLLING_INTERVAL_MS
+#        else
+#            define POINTING_DEVICE_TASK_THROTTLE_MS 1
+#        endif
+#    endif
+#endif
+
 #if defined(SPLIT_POINTING_ENABLE)
 void     pointing_device_set_shared_report(report_mouse_t report);
 uint16_t pointing_device_get_shared_cpi(void);
+#    if defined(SPLIT_POINTING_FUSION)
+void pointing_device_set_shared_motion(const pointing_device_motion_t *motion);
+#    elif defined(SPLIT_POINTING_STREAM)
+#        error SPLIT_POINTING_STREAM requires SPLIT_POINTING_FUSION
+#    endif
 #    if !defined(POINTING_DEVICE_TASK_THROTTLE_MS)
 #        define POINTING_DEVICE_TASK_THROTTLE_MS 1
 #    endif
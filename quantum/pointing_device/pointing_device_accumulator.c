@@ -0,0 +1,104 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef POINTING_DEVICE_ACCUMULATOR_ENABLE
+
+#    include "pointing_device_accumulator.h"
+
+static inline int32_t accumulate(int32_t total, int32_t motion, int32_t limit) {
+    total += motion;
+    if (total > limit) {
+        return limit;
+    } else if (total < -limit) {
+        return -limit;
+    }
+    return total;
+}
+
+/**
+ * @brief Removes the whole counts from `total`, as many as fit in a report
+ * field between `min` and `max`, leaving the rest for the next report.
+ */
+static inline int32_t take_counts(int32_t *total, int32_t unit, int32_t min, int32_t max) {
+    // Division truncates towards zero, so the remainder keeps the sign of the motion
+    int32_t counts = *total / unit;
+    if (counts > max) {
+        counts = max;
+    } else if (counts < min) {
+        counts = min;
+    }
+    *total -= counts * unit;
+    return counts;
+}
+
+void pointing_device_accumulator_init(pointing_device_accumulator_t *accumulator, uint8_t numerator, uint8_t denominator) {
+    accumulator->numerator   = 1;
+    accumulator->denominator = 1;
+    pointing_device_accumulator_clear(accumulator);
+    pointing_device_accumulator_set_scale(accumulator, numerator, denominator);
+}
+
+/**
+ * @brief Sets the factor X and Y motion is multiplied by, e.g. 1 / 4 to send
+ * 400 CPI to the host from a sensor running at 1600 CPI.
+ *
+ * Pending whole counts are kept, any pending fraction is dropped.
+ */
+void pointing_device_accumulator_set_scale(pointing_device_accumulator_t *accumulator, uint8_t numerator, uint8_t denominator) {
+    if (numerator == 0 || denominator == 0) {
+        return;
+    }
+    accumulator->x           = accumulator->x / accumulator->denominator * denominator;
+    accumulator->y           = accumulator->y / accumulator->denominator * denominator;
+    accumulator->numerator   = numerator;
+    accumulator->denominator = denominator;
+}
+
+/**
+ * @brief Adds motion in sensor counts, which may be more than one report can hold.
+ */
+void pointing_device_accumulator_add_counts(pointing_device_accumulator_t *accumulator, int16_t x, int16_t y, int16_t h, int16_t v) {
+    const int32_t xy_limit = (int32_t)POINTING_DEVICE_ACCUMULATOR_MAX_REPORTS * MOUSE_REPORT_XY_MAX * accumulator->denominator;
+    const int32_t hv_limit = (int32_t)POINTING_DEVICE_ACCUMULATOR_MAX_REPORTS * MOUSE_REPORT_HV_MAX;
+
+    accumulator->x = accumulate(accumulator->x, (int32_t)x * accumulator->numerator, xy_limit);
+    accumulator->y = accumulate(accumulator->y, (int32_t)y * accumulator->numerator, xy_limit);
+    accumulator->h = accumulate(accumulator->h, h, hv_limit);
+    accumulator->v = accumulate(accumulator->v, v, hv_limit);
+}
+
+/**
+ * @brief Adds the motion of one sensor read.
+ */
+void pointing_device_accumulator_add(pointing_device_accumulator_t *accumulator, report_mouse_t sample) {
+    pointing_device_accumulator_add_counts(accumulator, sample.x, sample.y, sample.h, sample.v);
+}
+
+/**
+ * @brief Moves as much of the accumulated motion as fits into the motion
+ * fields of `mouse_report`, replacing what was there. Buttons are left as is.
+ */
+report_mouse_t pointing_device_accumulator_take(pointing_device_accumulator_t *accumulator, report_mouse_t mouse_report) {
+    mouse_report.x = take_counts(&accumulator->x, accumulator->denominator, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX);
+    mouse_report.y = take_counts(&accumulator->y, accumulator->denominator, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX);
+    mouse_report.h = take_counts(&accumulator->h, 1, MOUSE_REPORT_HV_MIN, MOUSE_REPORT_HV_MAX);
+    mouse_report.v = take_counts(&accumulator->v, 1, MOUSE_REPORT_HV_MIN, MOUSE_REPORT_HV_MAX);
+    return mouse_report;
+}
+
+/**
+ * @brief Whether taking a report now would move the cursor or scroll.
+ */
+bool pointing_device_accumulator_has_motion(const pointing_device_accumulator_t *accumulator) {
+    const int32_t unit = accumulator->denominator;
+    return accumulator->x >= unit || accumulator->x <= -unit || accumulator->y >= unit || accumulator->y <= -unit || accumulator->h != 0 || accumulator->v != 0;
+}
+
+void pointing_device_accumulator_clear(pointing_device_accumulator_t *accumulator) {
+    accumulator->x = 0;
+    accumulator->y = 0;
+    accumulator->h = 0;
+    accumulator->v = 0;
+}
+
+#endif // POINTING_DEVICE_ACCUMULATOR_ENABLE
@@ -0,0 +1,39 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "report.h"
+
+#ifndef POINTING_DEVICE_ACCUMULATOR_MAX_REPORTS
+#    define POINTING_DEVICE_ACCUMULATOR_MAX_REPORTS 4
+#endif
+
+/*
+ * Sums the motion of every sensor read between two reports to the host.
+ *
+ * X and Y are multiplied by numerator / denominator on the way in and kept in
+ * units of 1 / denominator counts, so the fraction left over by scaling is
+ * carried into the next report rather than truncated. Motion that doesn't fit
+ * in one report is carried as well, up to POINTING_DEVICE_ACCUMULATOR_MAX_REPORTS
+ * full reports; anything beyond that is dropped, so the cursor doesn't keep
+ * moving long after the sensor has stopped.
+ */
+typedef struct {
+    int32_t x;
+    int32_t y;
+    int32_t h;
+    int32_t v;
+    uint8_t numerator;
+    uint8_t denominator;
+} pointing_device_accumulator_t;
+
+void           pointing_device_accumulator_init(pointing_device_accumulator_t *accumulator, uint8_t numerator, uint8_t denominator);
+void           pointing_device_accumulator_set_scale(pointing_device_accumulator_t *accumulator, uint8_t numerator, uint8_t denominator);
+void           pointing_device_accumulator_add_counts(pointing_device_accumulator_t *accumulator, int16_t x, int16_t y, int16_t h, int16_t v);
+void           pointing_device_accumulator_add(pointing_device_accumulator_t *accumulator, report_mouse_t sample);
+report_mouse_t pointing_device_accumulator_take(pointing_device_accumulator_t *accumulator, report_mouse_t mouse_report);
+bool           pointing_device_accumulator_has_motion(const pointing_device_accumulator_t *accumulator);
+void           pointing_device_accumulator_clear(pointing_device_accumulator_t *accumulator);
@@ -0,0 +1,119 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef SPLIT_POINTING_FUSION
+
+#    include <string.h>
+#    include "pointing_device_fusion.h"
+
+static inline int16_t add_saturated(int16_t total, int16_t motion) {
+    int32_t sum = (int32_t)total + motion;
+    if (sum > INT16_MAX) {
+        return INT16_MAX;
+    } else if (sum < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return sum;
+}
+
+static void release_oldest_local(pointing_device_fusion_t *fusion) {
+    pointing_device_fusion_sample_t *sample = &fusion->local[fusion->local_head];
+    pointing_device_accumulator_add_counts(&fusion->local_motion, sample->x, sample->y, sample->h, sample->v);
+    fusion->local_head = (fusion->local_head + 1) % POINTING_DEVICE_FUSION_HISTORY_SIZE;
+    fusion->local_count--;
+}
+
+void pointing_device_fusion_init(pointing_device_fusion_t *fusion) {
+    memset(fusion, 0, sizeof(pointing_device_fusion_t));
+    pointing_device_accumulator_init(&fusion->local_motion, 1, 1);
+    pointing_device_accumulator_init(&fusion->remote_motion, 1, 1);
+}
+
+void pointing_device_fusion_set_scale(pointing_device_fusion_t *fusion, uint8_t numerator, uint8_t denominator) {
+    pointing_device_accumulator_set_scale(&fusion->local_motion, numerator, denominator);
+    pointing_device_accumulator_set_scale(&fusion->remote_motion, numerator, denominator);
+}
+
+/**
+ * @brief Records a read of the local sensor made at sync_timer time `time`.
+ * Reads within the same millisecond are merged.
+ */
+void pointing_device_fusion_add_local(pointing_device_fusion_t *fusion, report_mouse_t sample, uint16_t time) {
+    if (!sample.x && !sample.y && !sample.h && !sample.v) {
+        return;
+    }
+    if (fusion->local_count) {
+        pointing_device_fusion_sample_t *newest = &fusion->local[(fusion->local_head + fusion->local_count - 1) % POINTING_DEVICE_FUSION_HISTORY_SIZE];
+        if (newest->time == time) {
+            newest->x = add_saturated(newest->x, sample.x);
+            newest->y = add_saturated(newest->y, sample.y);
+            newest->h = add_saturated(newest->h, sample.h);
+            newest->v = add_saturated(newest->v, sample.v);
+            return;
+        }
+    }
+    if (fusion->local_count == POINTING_DEVICE_FUSION_HISTORY_SIZE) {
+        release_oldest_local(fusion);
+    }
+    pointing_device_fusion_sample_t *entry = &fusion->local[(fusion->local_head + fusion->local_count) % POINTING_DEVICE_FUSION_HISTORY_SIZE];
+    entry->time                            = time;
+    entry->x                               = sample.x;
+    entry->y                               = sample.y;
+    entry->h                               = sample.h;
+    entry->v                               = sample.v;
+    fusion->local_count++;
+}
+
+/**
+ * @brief Takes in the latest motion published by the remote half.
+ *
+ * The first totals received, and totals from another session (i.e. the
+ * remote half restarted), only set the baseline for the following ones.
+ * Motion beyond what the accumulator can carry is clamped by it.
+ */
+void pointing_device_fusion_set_remote(pointing_device_fusion_t *fusion, const pointing_device_motion_t *motion) {
+    // Differences of the wrapping totals, which stay right across a wrap
+    int16_t x = (int16_t)(uint16_t)(motion->x - fusion->remote.x);
+    int16_t y = (int16_t)(uint16_t)(motion->y - fusion->remote.y);
+    int16_t h = (int16_t)(uint16_t)(motion->h - fusion->remote.h);
+    int16_t v = (int16_t)(uint16_t)(motion->v - fusion->remote.v);
+
+    bool resync    = !fusion->remote_synced || motion->session != fusion->remote.session;
+    fusion->remote = *motion;
+    if (resync) {
+        fusion->remote_synced = true;
+        return;
+    }
+    if (x || y || h || v) {
+        pointing_device_accumulator_add_counts(&fusion->remote_motion, x, y, h, v);
+        fusion->remote_moving = true;
+    }
+}
+
+/**
+ * @brief Fills in the motion of both halves for the report sent at sync_timer
+ * time `now`, each into the motion fields of its report.
+ *
+ * The remote report gets the remote buttons, the local report keeps its own.
+ */
+void pointing_device_fusion_take(pointing_device_fusion_t *fusion, uint16_t now, report_mouse_t *local_report, report_mouse_t *remote_report) {
+    uint16_t sample_time = now;
+    if (fusion->remote_moving) {
+        int16_t behind = (int16_t)(uint16_t)(now - fusion->remote.time);
+        if (behind >= SPLIT_POINTING_FUSION_MAX_DELAY_MS) {
+            // Stopped, or too far behind to wait for
+            fusion->remote_moving = false;
+        } else if (behind > 0) {
+            sample_time = fusion->remote.time;
+        }
+    }
+    while (fusion->local_count && (int16_t)(uint16_t)(fusion->local[fusion->local_head].time - sample_time) <= 0) {
+        release_oldest_local(fusion);
+    }
+
+    *local_report          = pointing_device_accumulator_take(&fusion->local_motion, *local_report);
+    remote_report->buttons = fusion->remote.buttons;
+    *remote_report         = pointing_device_accumulator_take(&fusion->remote_motion, *remote_report);
+}
+
+#endif // SPLIT_POINTING_FUSION
@@ -0,0 +1,69 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "report.h"
+#include "pointing_device_accumulator.h"
+
+#ifndef SPLIT_POINTING_FUSION_MAX_DELAY_MS
+#    define SPLIT_POINTING_FUSION_MAX_DELAY_MS 4
+#endif
+
+// One entry per millisecond the local sensor may be held back for, plus the current one
+#define POINTING_DEVICE_FUSION_HISTORY_SIZE ((SPLIT_POINTING_FUSION_MAX_DELAY_MS) + 2)
+
+/*
+ * Motion as published by the half that isn't the master: running totals of
+ * every sensor read, wrapping, and the sync_timer time of the last read that
+ * moved. The master takes the difference to the totals it saw last, so no
+ * motion is lost or counted twice however its reads line up with the sensor
+ * reads on the other half.
+ *
+ * The session is handed out by the master and starts at 0 when the other half
+ * boots, so totals that started over after a restart are told apart from
+ * motion however small or large they are.
+ */
+typedef struct {
+    uint16_t time;
+    uint16_t x;
+    uint16_t y;
+    uint16_t h;
+    uint16_t v;
+    uint8_t  buttons;
+    uint8_t  session;
+} pointing_device_motion_t;
+
+typedef struct {
+    uint16_t time;
+    int16_t  x;
+    int16_t  y;
+    int16_t  h;
+    int16_t  v;
+} pointing_device_fusion_sample_t;
+
+/*
+ * Fuses the motion of both halves at a common sample time. Remote motion only
+ * reaches the master some time after it was read, so while the remote sensor
+ * is moving, local reads made after the remote's latest sample are held back
+ * until the remote catches up, for at most SPLIT_POINTING_FUSION_MAX_DELAY_MS.
+ * When only one half is moving nothing is held back.
+ */
+typedef struct {
+    pointing_device_fusion_sample_t local[POINTING_DEVICE_FUSION_HISTORY_SIZE]; // held back local reads, oldest first
+    uint8_t                         local_head;
+    uint8_t                         local_count;
+    pointing_device_accumulator_t   local_motion;
+    pointing_device_motion_t        remote;
+    pointing_device_accumulator_t   remote_motion;
+    bool                            remote_synced;
+    bool                            remote_moving;
+} pointing_device_fusion_t;
+
+void pointing_device_fusion_init(pointing_device_fusion_t *fusion);
+void pointing_device_fusion_set_scale(pointing_device_fusion_t *fusion, uint8_t numerator, uint8_t denominator);
+void pointing_device_fusion_add_local(pointing_device_fusion_t *fusion, report_mouse_t sample, uint16_t time);
+void pointing_device_fusion_set_remote(pointing_device_fusion_t *fusion, const pointing_device_motion_t *motion);
+void pointing_device_fusion_take(pointing_device_fusion_t *fusion, uint16_t now, report_mouse_t *local_report, report_mouse_t *remote_report);
@@ -0,0 +1,235 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <random>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "pointing_device_fusion.h"
+}
+
+class PointingDeviceFusion : public ::testing::Test {
+   protected:
+    pointing_device_fusion_t fusion;
+    pointing_device_motion_t remote = {};
+    report_mouse_t           local_report;
+    report_mouse_t           remote_report;
+
+    void SetUp() override {
+        pointing_device_fusion_init(&fusion);
+    }
+
+    void read_local(uint16_t time, int16_t x, int16_t y = 0) {
+        report_mouse_t sample = {};
+        sample.x              = x;
+        sample.y              = y;
+        pointing_device_fusion_add_local(&fusion, sample, time);
+    }
+
+    // A read of the remote sensor, published as running totals
+    void read_remote(uint16_t time, int16_t x, int16_t y = 0) {
+        remote.x += x;
+        remote.y += y;
+        if (x || y) {
+            remote.time = time;
+        }
+        pointing_device_fusion_set_remote(&fusion, &remote);
+    }
+
+    void take(uint16_t now) {
+        local_report  = {};
+        remote_report = {};
+        pointing_device_fusion_take(&fusion, now, &local_report, &remote_report);
+    }
+};
+
+TEST_F(PointingDeviceFusion, LocalMotionIsNotHeldBackOnItsOwn) {
+    read_remote(100, 0);
+    read_local(100, 10, -3);
+    take(100);
+    EXPECT_EQ(local_report.x, 10);
+    EXPECT_EQ(local_report.y, -3);
+    EXPECT_EQ(remote_report.x, 0);
+}
+
+TEST_F(PointingDeviceFusion, RemoteMotionIsTakenOnce) {
+    read_remote(100, 0);
+    read_remote(101, 5, -2);
+    read_remote(102, 4, 0);
+    take(103);
+    EXPECT_EQ(remote_report.x, 9);
+    EXPECT_EQ(remote_report.y, -2);
+
+    // The same totals again, e.g. from a forced resync
+    pointing_device_fusion_set_remote(&fusion, &remote);
+    take(104);
+    EXPECT_EQ(remote_report.x, 0);
+    EXPECT_EQ(remote_report.y, 0);
+}
+
+TEST_F(PointingDeviceFusion, FirstTotalsAreOnlyABaseline) {
+    remote.x = 500;
+    remote.y = 12345;
+    read_remote(100, 0);
+    take(100);
+    EXPECT_EQ(remote_report.x, 0);
+    EXPECT_EQ(remote_report.y, 0);
+    read_remote(101, 3, 3);
+    take(101);
+    EXPECT_EQ(remote_report.x, 3);
+    EXPECT_EQ(remote_report.y, 3);
+}
+
+TEST_F(PointingDeviceFusion, TotalsWrapAround) {
+    remote.x = 65530;
+    remote.y = 4;
+    read_remote(100, 0);
+    read_remote(101, 10, -10);
+    take(101);
+    EXPECT_EQ(remote_report.x, 10);
+    EXPECT_EQ(remote_report.y, -10);
+}
+
+TEST_F(PointingDeviceFusion, RestartedRemoteIsResynced) {
+    remote.session = 1;
+    remote.x       = 20000;
+    read_remote(100, 0);
+    // The remote half restarted and counts from zero again, until it's handed a session
+    remote = {};
+    read_remote(101, 5);
+    take(101);
+    EXPECT_EQ(remote_report.x, 0);
+    remote.session = 1;
+    read_remote(102, 5);
+    take(102);
+    EXPECT_EQ(remote_report.x, 0);
+    read_remote(103, 5);
+    take(103);
+    EXPECT_EQ(remote_report.x, 5);
+}
+
+TEST_F(PointingDeviceFusion, RestartWithSmallTotalsIsResynced) {
+    remote.session = 1;
+    read_remote(100, 0);
+    read_remote(101, 100, -50);
+    take(101);
+    EXPECT_EQ(remote_report.x, 100);
+    EXPECT_EQ(remote_report.y, -50);
+
+    // Totals this close to zero could pass for motion
+    remote = {};
+    read_remote(102, 3);
+    take(102);
+    EXPECT_EQ(remote_report.x, 0);
+    EXPECT_EQ(remote_report.y, 0);
+}
+
+TEST_F(PointingDeviceFusion, FastMotionIsClampedNotDropped) {
+    read_remote(100, 0);
+    read_remote(101, 20000, -20000);
+    int32_t x = 0, y = 0;
+    for (uint16_t time = 101; time < 101 + 2 * POINTING_DEVICE_ACCUMULATOR_MAX_REPORTS; time++) {
+        take(time);
+        x += remote_report.x;
+        y += remote_report.y;
+    }
+    // Up to what the accumulator carries, all of it with extended reports
+    const int32_t limit = (int32_t)POINTING_DEVICE_ACCUMULATOR_MAX_REPORTS * MOUSE_REPORT_XY_MAX;
+    EXPECT_EQ(x, std::min<int32_t>(20000, limit));
+    EXPECT_EQ(y, -std::min<int32_t>(20000, limit));
+}
+
+TEST_F(PointingDeviceFusion, LocalMotionWaitsForMovingRemote) {
+    read_remote(98, 0);
+    read_remote(100, 3);
+    read_local(100, 1);
+    read_local(101, 2);
+    read_local(102, 4);
+
+    // The remote has only told us about its motion up to 100
+    take(102);
+    EXPECT_EQ(remote_report.x, 3);
+    EXPECT_EQ(local_report.x, 1);
+
+    read_remote(102, 3);
+    take(103);
+    EXPECT_EQ(remote_report.x, 3);
+    EXPECT_EQ(local_report.x, 6);
+}
+
+TEST_F(PointingDeviceFusion, LocalMotionIsHeldBackForAtMostTheMaximumDelay) {
+    read_remote(98, 0);
+    read_remote(100, 3);
+    take(100);
+    for (uint16_t time = 100; time < 100 + SPLIT_POINTING_FUSION_MAX_DELAY_MS; time++) {
+        read_local(time, 1);
+        take(time);
+        EXPECT_EQ(local_report.x, time == 100 ? 1 : 0) << "at " << time;
+    }
+
+    // The remote stopped, everything held back goes out at once
+    take(100 + SPLIT_POINTING_FUSION_MAX_DELAY_MS);
+    EXPECT_EQ(local_report.x, SPLIT_POINTING_FUSION_MAX_DELAY_MS - 1);
+
+    // And from then on nothing is held back
+    read_local(101 + SPLIT_POINTING_FUSION_MAX_DELAY_MS, 7);
+    take(101 + SPLIT_POINTING_FUSION_MAX_DELAY_MS);
+    EXPECT_EQ(local_report.x, 7);
+}
+
+TEST_F(PointingDeviceFusion, ButtonsComeFromTheirOwnSide) {
+    remote.buttons = 0x02;
+    read_remote(100, 0);
+    local_report         = {};
+    local_report.buttons = 0x01;
+    remote_report        = {};
+    pointing_device_fusion_take(&fusion, 100, &local_report, &remote_report);
+    EXPECT_EQ(local_report.buttons, 0x01);
+    EXPECT_EQ(remote_report.buttons, 0x02);
+}
+
+TEST_F(PointingDeviceFusion, ScaleCarriesFractionsOnBothSides) {
+    pointing_device_fusion_set_scale(&fusion, 1, 2);
+    read_remote(100, 0);
+    read_local(100, 1);
+    read_remote(100, 1);
+    take(110);
+    EXPECT_EQ(local_report.x, 0);
+    EXPECT_EQ(remote_report.x, 0);
+    read_local(110, 1);
+    read_remote(110, 1);
+    take(120);
+    EXPECT_EQ(local_report.x, 1);
+    EXPECT_EQ(remote_report.x, 1);
+}
+
+TEST_F(PointingDeviceFusion, NothingIsLostOrRepeated) {
+    // Both sensors read every millisecond, the remote totals arrive a few
+    // milliseconds late and irregularly, reports go out every millisecond
+    std::mt19937 rng(1);
+    int          local_read = 0, remote_read = 0, local_sent = 0, remote_sent = 0;
+    read_remote(0, 0);
+    for (uint16_t time = 1; time < 20000; time++) {
+        int16_t x = (int16_t)(rng() % 21) - 10;
+        read_local(time, x);
+        local_read += x;
+
+        if (rng() % 3 == 0) {
+            // Every remote read since the last time the master looked
+            int16_t dx = (int16_t)(rng() % 41) - 20;
+            read_remote(time - rng() % 3, dx);
+            remote_read += dx;
+        }
+
+        take(time);
+        local_sent += local_report.x;
+        remote_sent += remote_report.x;
+    }
+    take(20000 + SPLIT_POINTING_FUSION_MAX_DELAY_MS);
+    local_sent += local_report.x;
+    remote_sent += remote_report.x;
+
+    EXPECT_EQ(local_sent, local_read);
+    EXPECT_EQ(remote_sent, remote_read);
+}
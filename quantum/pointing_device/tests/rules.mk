@@ -0,0 +1,16 @@
+pointing_device_fusion_DEFS := \
+	-DPOINTING_DEVICE_ACCUMULATOR_ENABLE \
+	-DSPLIT_POINTING_FUSION
+pointing_device_fusion_SRC := \
+	$(QUANTUM_PATH)/pointing_device/pointing_device_accumulator.c \
+	$(QUANTUM_PATH)/pointing_device/pointing_device_fusion.c \
+	$(QUANTUM_PATH)/pointing_device/tests/pointing_device_fusion_tests.cpp
+pointing_device_fusion_INC := \
+	$(QUANTUM_PATH)/pointing_device \
+	$(TMK_PATH)/protocol
+
+pointing_device_fusion_extended_DEFS := \
+	$(pointing_device_fusion_DEFS) \
+	-DMOUSE_EXTENDED_REPORT
+pointing_device_fusion_extended_SRC := $(pointing_device_fusion_SRC)
+pointing_device_fusion_extended_INC := $(pointing_device_fusion_INC)
@@ -0,0 +1 @@
+TEST_LIST += pointing_device_fusion pointing_device_fusion_extended
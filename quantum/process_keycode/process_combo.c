@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -25,6 +26,7 @@
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "action_util.h"
+#include "host.h"
 #include "keymap_introspection.h"
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
@@ -149,6 +151,88 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
         } while (0)
 #endif
 
+#ifdef COMBO_KEY_INDEX
+/* Buckets are walked with 8-bit indices */
+_Static_assert(COMBO_KEY_INDEX_BUCKETS > 0 && COMBO_KEY_INDEX_BUCKETS <= 255, "COMBO_KEY_INDEX_BUCKETS must be between 1 and 255");
+
+/* Combo indices grouped by the bucket of each of their keycodes, ascending
+ * within a bucket so that candidates are visited in key_combos order. */
+static uint16_t combo_key_index[COMBO_KEY_INDEX_LENGTH];
+static uint16_t combo_key_index_start[COMBO_KEY_INDEX_BUCKETS + 1];
+/* Buckets whose combos may hold state that clear_combos() has to reset. */
+static uint8_t  combo_key_index_dirty[(COMBO_KEY_INDEX_BUCKETS + 7) / 8];
+static uint16_t combo_key_index_combo_count = 0;
+static bool     combo_key_index_built       = false;
+static bool     combo_key_index_overflow    = false;
+
+#    define COMBO_KEY_BUCKET(keycode) ((keycode) % COMBO_KEY_INDEX_BUCKETS)
+#    define COMBO_KEY_BUCKET_IS_DIRTY(bucket) (combo_key_index_dirty[(bucket) / 8] & (1 << ((bucket) % 8)))
+#    define COMBO_KEY_BUCKET_SET_DIRTY(bucket)                       \
+        do {                                                         \
+            combo_key_index_dirty[(bucket) / 8] |= 1 << ((bucket) % 8); \
+        } while (0)
+
+/* Returns true if an earlier key of the combo already falls into the same bucket. */
+static bool combo_key_bucket_seen(const uint16_t *keys, uint8_t key_count, uint8_t bucket) {
+    for (uint8_t i = 0; i < key_count; i++) {
+        if (COMBO_KEY_BUCKET(pgm_read_word(&keys[i])) == bucket) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void combo_key_index_build(void) {
+    uint16_t count = combo_count();
+
+    memset(combo_key_index_start, 0, sizeof(combo_key_index_start));
+    for (uint16_t idx = 0; idx < count; idx++) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+        for (uint8_t i = 0; (key = pgm_read_word(&keys[i])) != COMBO_END; i++) {
+            if (!combo_key_bucket_seen(keys, i, COMBO_KEY_BUCKET(key))) {
+                combo_key_index_start[COMBO_KEY_BUCKET(key) + 1]++;
+            }
+        }
+    }
+    for (uint8_t bucket = 0; bucket < COMBO_KEY_INDEX_BUCKETS; bucket++) {
+        combo_key_index_start[bucket + 1] += combo_key_index_start[bucket];
+    }
+
+    combo_key_index_combo_count = count;
+    combo_key_index_built       = true;
+    combo_key_index_overflow    = combo_key_index_start[COMBO_KEY_INDEX_BUCKETS] > COMBO_KEY_INDEX_LENGTH;
+    // Combos may already hold state from before the rebuild
+    memset(combo_key_index_dirty, 0xFF, sizeof(combo_key_index_dirty));
+    if (combo_key_index_overflow) {
+        return;
+    }
+
+    /* Fill using the bucket starts as write cursors, then shift them back. */
+    for (uint16_t idx = 0; idx < count; idx++) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+        for (uint8_t i = 0; (key = pgm_read_word(&keys[i])) != COMBO_END; i++) {
+            if (!combo_key_bucket_seen(keys, i, COMBO_KEY_BUCKET(key))) {
+                combo_key_index[combo_key_index_start[COMBO_KEY_BUCKET(key)]++] = idx;
+            }
+        }
+    }
+    for (uint8_t bucket = COMBO_KEY_INDEX_BUCKETS; bucket > 0; bucket--) {
+        combo_key_index_start[bucket] = combo_key_index_start[bucket - 1];
+    }
+    combo_key_index_start[0] = 0;
+}
+
+/* Returns true if the index can be used, (re)building it when the combo count changed. */
+static bool combo_key_index_ready(void) {
+    if (!combo_key_index_built || combo_key_index_combo_count != combo_count()) {
+        combo_key_index_build();
+    }
+    return !combo_key_index_overflow;
+}
+#endif
+
 static inline void release_combo(uint16_t combo_index, combo_t *combo) {
     if (combo->keycode) {
         keyrecord_t record = {
@@ -199,14 +283,32 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
     return COMBO_TERM;
 }
 
+static inline void clear_combo(combo_t *combo) {
+    if (!COMBO_ACTIVE(combo)) {
+        RESET_COMBO_STATE(combo);
+    }
+}
+
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
-    for (index = 0; index < combo_count(); ++index) {
-        combo_t *combo = combo_get(index);
-        if (!COMBO_ACTIVE(combo)) {
-            RESET_COMBO_STATE(combo);
+#ifdef COMBO_KEY_INDEX
+    if (combo_key_index_ready()) {
+        // Only combos sharing a bucket with a key seen since the last clear can hold state
+        for (uint8_t bucket = 0; bucket < COMBO_KEY_INDEX_BUCKETS; bucket++) {
+            if (!COMBO_KEY_BUCKET_IS_DIRTY(bucket)) {
+                continue;
+            }
+            for (index = combo_key_index_start[bucket]; index < combo_key_index_start[bucket + 1]; ++index) {
+                clear_combo(combo_get(combo_key_index[index]));
+            }
         }
+        memset(combo_key_index_dirty, 0, sizeof(combo_key_index_dirty));
+        return;
+    }
+#endif
+    for (index = 0; index < combo_count(); ++index) {
+        clear_combo(combo_get(index));
     }
 }
 
@@ -256,6 +358,7 @@ static inline void dump_key_buffer(void) {
         // only delay once and for a non-tapping key
         if (!delay_done && !is_tap_record(record)) {
             delay_done = true;
+            host_flush_reports();
             wait_ms(TAP_CODE_DELAY);
         }
 #endif
@@ -264,7 +367,6 @@ static inline void dump_key_buffer(void) {
     key_buffer_next = key_buffer_size = 0;
 }
 
-#define NO_COMBO_KEYS_ARE_DOWN (0 == COMBO_STATE(combo))
 #define ALL_COMBO_KEYS_ARE_DOWN(state, key_count) (((1 << key_count) - 1) == state)
 #define ONLY_ONE_KEY_IS_DOWN(state) !(state & (state - 1))
 #define KEY_NOT_YET_RELEASED(state, key_index) ((1 << key_index) & state)
@@ -556,8 +658,7 @@ static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode,
 }
 
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    uint8_t is_combo_key          = COMBO_KEY_NOT_PRESSED;
-    bool    no_combo_keys_pressed = true;
+    uint8_t is_combo_key = COMBO_KEY_NOT_PRESSED;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -585,10 +686,21 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_KEY_INDEX
+    if (combo_key_index_ready()) {
+        // Only visit the combos that may contain this keycode
+        uint8_t bucket = COMBO_KEY_BUCKET(keycode);
+        COMBO_KEY_BUCKET_SET_DIRTY(bucket);
+        for (uint16_t i = combo_key_index_start[bucket]; i < combo_key_index_start[bucket + 1]; ++i) {
+            uint16_t idx = combo_key_index[i];
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -39,6 +39,15 @@
 #    define COMBO_BUFFER_LENGTH 4
 #endif
 
+#ifdef COMBO_KEY_INDEX
+#    ifndef COMBO_KEY_INDEX_LENGTH
+#        define COMBO_KEY_INDEX_LENGTH 256
+#    endif
+#    ifndef COMBO_KEY_INDEX_BUCKETS
+#        define COMBO_KEY_INDEX_BUCKETS 64
+#    endif
+#endif
+
 typedef struct combo_t {
     const uint16_t *keys;
     uint16_t        keycode;
@@ -21,6 +21,7 @@
 #include "action_layer.h"
 #include "keycodes.h"
 #include "debug.h"
+#include "host.h"
 #include "wait.h"
 
 #ifdef BACKLIGHT_ENABLE
@@ -145,6 +146,7 @@ void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_
         process_record(macro_buffer);
         macro_buffer += direction;
 #ifdef DYNAMIC_MACRO_DELAY
+        host_flush_reports();
         wait_ms(DYNAMIC_MACRO_DELAY);
 #endif
     }
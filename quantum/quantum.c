@@ -93,6 +93,14 @@
 #    include "process_oneshot.h"
 #endif
 
+#ifdef NVM_WRITE_BACK_ENABLE
+#    include "nvm_write_back.h"
+#endif
+
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_ASYNC_CONSOLIDATION)
+#    include "wear_leveling.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -157,6 +165,7 @@ __attribute__((weak)) void unregister_code16(uint16_t code) {
  */
 __attribute__((weak)) void tap_code16_delay(uint16_t code, uint16_t delay) {
     register_code16(code);
+    host_flush_reports();
     wait_ms(delay);
     unregister_code16(code);
 }
@@ -211,6 +220,7 @@ __attribute__((weak)) void suspend_wakeup_init_modules(void) {}
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+    host_flush_reports();
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -233,6 +243,13 @@ void shutdown_quantum(bool jump_to_bootloader) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#ifdef NVM_WRITE_BACK_ENABLE
+    nvm_write_back_flush();
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_ASYNC_CONSOLIDATION)
+    // The main loop won't get to finish a pending consolidation
+    wear_leveling_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -295,9 +312,18 @@ void post_process_record_quantum(keyrecord_t *record) {
     post_process_record_kb(keycode, record);
 }
 
+/** \brief Calls a keycode handler only when the keycode is in the range it handles
+ *
+ * Handlers return true for any keycode outside their range, so skipping them
+ * leaves the result and ordering of the chain unchanged.
+ */
+#define PROCESS_KEYCODE_RANGE(handler, first, last) (keycode < (first) || keycode > (last) || handler(keycode, record))
+
 /** \brief Core keycode function
  *
- * Hands off handling to other quantum/process_keycode/ functions
+ * Hands off handling to other quantum/process_keycode/ functions. Handlers
+ * that need to see every key event are called directly; handlers that only
+ * act on their own keycodes are wrapped in PROCESS_KEYCODE_RANGE.
  */
 bool process_record_quantum(keyrecord_t *record) {
     uint16_t keycode = get_record_keycode(record, true);
@@ -360,28 +386,28 @@ bool process_record_quantum(keyrecord_t *record) {
             process_record_modules(keycode, record) && // modules must run before kb
             process_record_kb(keycode, record) &&
 #if defined(VIA_ENABLE)
-            process_record_via(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_record_via, QK_MACRO, QK_MACRO_MAX) &&
 #endif
 #if defined(SECURE_ENABLE)
-            process_secure(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_secure, QK_SECURE_LOCK, QK_SECURE_REQUEST) &&
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_sequencer, QK_SEQUENCER, QK_SEQUENCER_MAX) &&
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_midi, QK_MIDI, QK_MIDI_MAX) &&
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_audio, QK_AUDIO, QK_AUDIO_MAX) &&
 #endif
 #if defined(BACKLIGHT_ENABLE)
-            process_backlight(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_backlight, QK_LIGHTING, QK_LIGHTING_MAX) &&
 #endif
 #if defined(LED_MATRIX_ENABLE)
-            process_led_matrix(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_led_matrix, QK_LIGHTING, QK_LIGHTING_MAX) &&
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_steno, QK_STENO, QK_STENO_MAX) &&
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
             process_music(keycode, record) &&
@@ -405,46 +431,47 @@ bool process_record_quantum(keyrecord_t *record) {
             process_auto_shift(keycode, record) &&
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_dynamic_tapping_term, QK_DYNAMIC_TAPPING_TERM_PRINT, QK_DYNAMIC_TAPPING_TERM_DOWN) &&
 #endif
 #ifdef SPACE_CADET_ENABLE
             process_space_cadet(keycode, record) &&
 #endif
 #ifdef MAGIC_ENABLE
-            process_magic(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_magic, QK_MAGIC, QK_MAGIC_MAX) &&
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_grave_esc, QK_GRAVE_ESCAPE, QK_GRAVE_ESCAPE) &&
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_underglow(keycode, record) &&
+            // Also handles QK_VELOCIKEY_TOGGLE, which lives in the quantum block
+            PROCESS_KEYCODE_RANGE(process_underglow, QK_LIGHTING, QK_VELOCIKEY_TOGGLE) &&
 #endif
 #if defined(RGB_MATRIX_ENABLE)
-            process_rgb_matrix(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_rgb_matrix, QK_LIGHTING, QK_LIGHTING_MAX) &&
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_joystick, QK_JOYSTICK, QK_JOYSTICK_MAX) &&
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_programmable_button, QK_PROGRAMMABLE_BUTTON, QK_PROGRAMMABLE_BUTTON_MAX) &&
 #endif
 #ifdef AUTOCORRECT_ENABLE
             process_autocorrect(keycode, record) &&
 #endif
 #ifdef TRI_LAYER_ENABLE
-            process_tri_layer(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_tri_layer, QK_TRI_LAYER_LOWER, QK_TRI_LAYER_UPPER) &&
 #endif
 #if !defined(NO_ACTION_LAYER)
-            process_default_layer(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_default_layer, QK_PERSISTENT_DEF_LAYER, QK_PERSISTENT_DEF_LAYER_MAX) &&
 #endif
 #ifdef LAYER_LOCK_ENABLE
             process_layer_lock(keycode, record) &&
 #endif
 #ifdef CONNECTION_ENABLE
-            process_connection(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_connection, QK_CONNECTION, QK_CONNECTION_MAX) &&
 #endif
 #ifndef NO_ACTION_ONESHOT
-            process_oneshot(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(process_oneshot, QK_ONE_SHOT_ON, QK_ONE_SHOT_TOGGLE) &&
 #endif
             process_quantum(keycode, record))) {
         return false;
@@ -531,6 +558,13 @@ void suspend_power_down_quantum(void) {
     pointing_device_task();
 #    endif
 #endif
+#ifdef NVM_WRITE_BACK_ENABLE
+    // Power may go away while suspended
+    nvm_write_back_flush();
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_ASYNC_CONSOLIDATION)
+    wear_leveling_flush();
+#endif
 }
 
 __attribute__((weak)) void suspend_wakeup_init_quantum(void) {
@@ -38,6 +38,45 @@ __attribute__((weak)) rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// Converts a whole batch at once for the effect runners. By default each
+// entry goes through rgb_matrix_hsv_to_rgb(), so overriding that alone still
+// applies to batched effects. Keyboards can override this as well to convert
+// the batch with hsv_to_rgb_batch() instead, applying the same adjustment. The
+// hsv buffer may be modified in place.
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_batch(hsv_t *hsv, rgb_t *rgb, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        rgb[i] = rgb_matrix_hsv_to_rgb(hsv[i]);
+    }
+}
+
+// Scratch buffer used by the effect runners so colour conversion happens once
+// per group of LEDs instead of once per LED.
+#define RGB_MATRIX_HSV_BATCH_SIZE 16
+
+typedef struct {
+    uint8_t count;
+    uint8_t index[RGB_MATRIX_HSV_BATCH_SIZE];
+    hsv_t   hsv[RGB_MATRIX_HSV_BATCH_SIZE];
+} rgb_matrix_hsv_batch_t;
+
+static void rgb_matrix_hsv_batch_flush(rgb_matrix_hsv_batch_t *batch) {
+    rgb_t rgb[RGB_MATRIX_HSV_BATCH_SIZE];
+
+    rgb_matrix_hsv_to_rgb_batch(batch->hsv, rgb, batch->count);
+    for (uint8_t i = 0; i < batch->count; i++) {
+        rgb_matrix_set_color(batch->index[i], rgb[i].r, rgb[i].g, rgb[i].b);
+    }
+    batch->count = 0;
+}
+
+static inline void rgb_matrix_hsv_batch_push(rgb_matrix_hsv_batch_t *batch, uint8_t index, hsv_t hsv) {
+    batch->index[batch->count] = index;
+    batch->hsv[batch->count]   = hsv;
+    if (++batch->count == RGB_MATRIX_HSV_BATCH_SIZE) {
+        rgb_matrix_hsv_batch_flush(batch);
+    }
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -22,6 +22,7 @@
 #include "quantum_keycodes.h"
 #include "keycode.h"
 #include "action.h"
+#include "host.h"
 #include "wait.h"
 
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
@@ -146,6 +147,14 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 // Note: we bit-pack in "reverse" order to optimize loading
 #define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
 
+// Reports held back for coalescing go out before a delay, so that the host sees it
+static void send_string_wait(uint32_t ms) {
+    if (ms) {
+        host_flush_reports();
+    }
+    wait_ms(ms);
+}
+
 void send_string(const char *string) {
     send_string_with_delay(string, TAP_CODE_DELAY);
 }
@@ -180,10 +189,10 @@ void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t inte
                     ascii_code = getter(arg);
                 }
 
-                wait_ms(ms);
+                send_string_wait(ms);
             }
 
-            wait_ms(interval);
+            send_string_wait(interval);
 
             // if we had a delay that terminated with a null, we're done
             if (ascii_code == 0) break;
@@ -228,30 +237,30 @@ void send_char_with_delay(char ascii_code, uint8_t interval) {
 
     if (is_shifted) {
         register_code(KC_LEFT_SHIFT);
-        wait_ms(interval);
+        send_string_wait(interval);
     }
 
     if (is_altgred) {
         register_code(KC_RIGHT_ALT);
-        wait_ms(interval);
+        send_string_wait(interval);
     }
 
     tap_code_delay(keycode, interval);
-    wait_ms(interval);
+    send_string_wait(interval);
 
     if (is_altgred) {
         unregister_code(KC_RIGHT_ALT);
-        wait_ms(interval);
+        send_string_wait(interval);
     }
 
     if (is_shifted) {
         unregister_code(KC_LEFT_SHIFT);
-        wait_ms(interval);
+        send_string_wait(interval);
     }
 
     if (is_dead) {
         tap_code(KC_SPACE);
-        wait_ms(interval);
+        send_string_wait(interval);
     }
 }
 
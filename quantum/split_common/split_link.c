@@ -0,0 +1,164 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "split_link.h"
+#include "transaction_id_define.h"
+#include "timer.h"
+#include "debug.h"
+#include "print.h"
+
+// Weight of a single cycle in the error rate; a link that always fails settles just below 256
+#define SPLIT_LINK_ERROR_WEIGHT 31
+#define SPLIT_LINK_ERROR_DECAY 3
+
+static split_link_status_t split_link;
+static uint8_t             skip_cycles   = 0;
+static bool                cycle_skipped = false;
+
+bool split_link_cycle_begin(void) {
+    cycle_skipped = skip_cycles > 0;
+    if (cycle_skipped) {
+        skip_cycles--;
+        split_link.skipped++;
+        return false;
+    }
+    return true;
+}
+
+bool split_link_cycle_skipped(void) {
+    return cycle_skipped;
+}
+
+void split_link_cycle_end(bool okay) {
+#if defined(SPLIT_LINK_STATS_ENABLE) && defined(SPLIT_LINK_STATS_PRINT_INTERVAL)
+    static uint32_t last_print = 0;
+    if (debug_enable && timer_elapsed32(last_print) >= SPLIT_LINK_STATS_PRINT_INTERVAL) {
+        last_print = timer_read32();
+        split_link_stats_print();
+    }
+#endif
+
+    split_link.cycles++;
+    split_link.error_rate -= split_link.error_rate >> SPLIT_LINK_ERROR_DECAY;
+    if (okay) {
+        split_link.backoff = 0;
+        return;
+    }
+
+    split_link.failures++;
+    split_link.error_rate += SPLIT_LINK_ERROR_WEIGHT;
+#ifdef SPLIT_LINK_ADAPTIVE_RETRY
+    split_link.backoff = ((uint16_t)split_link.error_rate * (SPLIT_LINK_MAX_BACKOFF)) >> 8;
+    skip_cycles        = split_link.backoff;
+#endif
+}
+
+uint8_t split_link_retries(void) {
+#ifdef SPLIT_LINK_ADAPTIVE_RETRY
+    return split_link.error_rate < SPLIT_LINK_RETRY_THRESHOLD ? SPLIT_TRANSACTION_RETRIES : 0;
+#else
+    return SPLIT_TRANSACTION_RETRIES;
+#endif
+}
+
+void split_link_get_status(split_link_status_t *status) {
+    *status = split_link;
+}
+
+void split_link_reset(void) {
+    memset(&split_link, 0, sizeof(split_link));
+    skip_cycles   = 0;
+    cycle_skipped = false;
+}
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+
+static split_link_transaction_stats_t transaction_stats[NUM_TOTAL_TRANSACTIONS];
+
+// The last successful transfer, so a checksum failure reported right after it can take it back
+static int8_t  last_success_id = -1;
+static uint8_t last_success_bucket;
+
+__attribute__((weak)) uint32_t split_link_stats_timestamp(void) {
+    return timer_read_us();
+}
+
+static inline void saturating_increment(uint16_t *counter) {
+    if (*counter < UINT16_MAX) {
+        (*counter)++;
+    }
+}
+
+void split_link_stats_record(int8_t transaction_id, split_link_result_t result, uint32_t latency_us) {
+    if (transaction_id < 0 || transaction_id >= NUM_TOTAL_TRANSACTIONS) {
+        return;
+    }
+    split_link_transaction_stats_t *stats = &transaction_stats[transaction_id];
+    switch (result) {
+        case SPLIT_LINK_OK: {
+            saturating_increment(&stats->success);
+            uint8_t bucket = 0;
+            while (bucket < SPLIT_LINK_STATS_BUCKETS - 1 && latency_us >= (64UL << bucket)) {
+                bucket++;
+            }
+            saturating_increment(&stats->latency[bucket]);
+            last_success_id     = transaction_id;
+            last_success_bucket = bucket;
+            break;
+        }
+        case SPLIT_LINK_CRC_ERROR:
+            // The transfer itself was already counted as a success, with a latency sample
+            if (last_success_id == transaction_id) {
+                if (stats->success > 0) {
+                    stats->success--;
+                }
+                if (stats->latency[last_success_bucket] > 0) {
+                    stats->latency[last_success_bucket]--;
+                }
+            }
+            saturating_increment(&stats->crc_errors);
+            break;
+        case SPLIT_LINK_TIMEOUT:
+            saturating_increment(&stats->timeouts);
+            break;
+    }
+    if (result != SPLIT_LINK_OK) {
+        last_success_id = -1;
+    }
+}
+
+void split_link_stats_get(int8_t transaction_id, split_link_transaction_stats_t *stats) {
+    if (transaction_id < 0 || transaction_id >= NUM_TOTAL_TRANSACTIONS) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = transaction_stats[transaction_id];
+}
+
+void split_link_stats_reset(void) {
+    memset(transaction_stats, 0, sizeof(transaction_stats));
+    last_success_id     = -1;
+    split_link.cycles   = 0;
+    split_link.failures = 0;
+    split_link.skipped  = 0;
+}
+
+void split_link_stats_print(void) {
+#    ifdef CONSOLE_ENABLE
+    xprintf("split link: cycles=%lu failed=%lu skipped=%lu error_rate=%u backoff=%u\n", split_link.cycles, split_link.failures, split_link.skipped, split_link.error_rate, split_link.backoff);
+    for (uint8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        const split_link_transaction_stats_t *stats = &transaction_stats[id];
+        if (stats->success == 0 && stats->crc_errors == 0 && stats->timeouts == 0) {
+            continue;
+        }
+        xprintf("  #%u: ok=%u crc=%u timeout=%u latency", id, stats->success, stats->crc_errors, stats->timeouts);
+        for (uint8_t bucket = 0; bucket < SPLIT_LINK_STATS_BUCKETS; bucket++) {
+            xprintf(" %u", stats->latency[bucket]);
+        }
+        xprintf("\n");
+    }
+#    endif
+}
+
+#endif // SPLIT_LINK_STATS_ENABLE
@@ -0,0 +1,116 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Split transport link quality.
+
+    The master keeps an exponentially weighted rate of failed sync cycles.
+    By default a failed transaction is retried up to SPLIT_TRANSACTION_RETRIES
+    times, with a growing wait before each retry.
+
+    With SPLIT_LINK_ADAPTIVE_RETRY, a failed transaction is retried straight
+    away while the error rate is low, as the failure was most likely a one-off
+    glitch. Once it climbs, retries stop and every failed cycle is followed by
+    a number of skipped cycles proportional to the error rate, so a noisy link
+    costs a lower sync rate instead of stalling the main loop.
+
+    With SPLIT_LINK_STATS_ENABLE, every transaction also records its outcome
+    and latency, readable with split_link_stats_get(), over VIA, and on the
+    console.
+*/
+
+#ifndef SPLIT_TRANSACTION_RETRIES
+#    ifdef SPLIT_LINK_ADAPTIVE_RETRY
+#        define SPLIT_TRANSACTION_RETRIES 2
+#    else
+#        define SPLIT_TRANSACTION_RETRIES 9
+#    endif
+#endif
+
+#ifndef SPLIT_LINK_MAX_BACKOFF
+#    define SPLIT_LINK_MAX_BACKOFF 4
+#endif
+
+#ifndef SPLIT_LINK_RETRY_THRESHOLD
+#    define SPLIT_LINK_RETRY_THRESHOLD 64
+#endif
+
+#define SPLIT_LINK_STATS_BUCKETS 8
+
+typedef struct {
+    uint8_t  error_rate; // failed cycles, exponentially weighted, 0-255
+    uint8_t  backoff;    // cycles skipped after the last failure
+    uint32_t cycles;     // sync cycles attempted
+    uint32_t failures;   // sync cycles that failed
+    uint32_t skipped;    // sync cycles skipped while backing off
+} split_link_status_t;
+
+typedef enum {
+    SPLIT_LINK_OK,
+    SPLIT_LINK_CRC_ERROR, // the transfer completed, but its payload failed validation
+    SPLIT_LINK_TIMEOUT,   // the transport reported a failure
+} split_link_result_t;
+
+typedef struct {
+    uint16_t success;
+    uint16_t crc_errors;
+    uint16_t timeouts;
+    uint16_t latency[SPLIT_LINK_STATS_BUCKETS]; // successful transfers, bucket n is below 64us << n, the last one open-ended
+} split_link_transaction_stats_t;
+
+/**
+ * @brief Whether this sync cycle should talk to the slave at all, or be
+ * skipped while backing off.
+ */
+bool split_link_cycle_begin(void);
+
+/**
+ * @brief Whether the last sync cycle was skipped by split_link_cycle_begin(),
+ * as opposed to having failed. A skipped cycle is not a connection error.
+ */
+bool split_link_cycle_skipped(void);
+
+/**
+ * @brief Feeds the outcome of a sync cycle into the error rate.
+ */
+void split_link_cycle_end(bool okay);
+
+/**
+ * @brief How many times a failed transaction may be retried within the
+ * current cycle. Always SPLIT_TRANSACTION_RETRIES without
+ * SPLIT_LINK_ADAPTIVE_RETRY.
+ */
+uint8_t split_link_retries(void);
+
+void split_link_get_status(split_link_status_t *status);
+
+/**
+ * @brief Forgets the link history and any pending backoff.
+ */
+void split_link_reset(void);
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+/**
+ * @brief Current time in microseconds, used for transaction latencies.
+ */
+uint32_t split_link_stats_timestamp(void);
+
+void split_link_stats_record(int8_t transaction_id, split_link_result_t result, uint32_t latency_us);
+
+void split_link_stats_get(int8_t transaction_id, split_link_transaction_stats_t *stats);
+
+/**
+ * @brief Clears the per-transaction statistics and the link counters.
+ */
+void split_link_stats_reset(void);
+
+/**
+ * @brief Prints the link status and every transaction that saw traffic to the console.
+ */
+void split_link_stats_print(void);
+#endif // SPLIT_LINK_STATS_ENABLE
@@ -29,6 +29,10 @@
 #    include "eeconfig.h"
 #endif
 
+#ifdef SPLIT_COMMON_TRANSACTIONS
+#    include "split_link.h"
+#endif
+
 #if defined(RGBLIGHT_ENABLE) && defined(RGBLED_SPLIT)
 #    include "rgblight.h"
 #endif
@@ -248,6 +252,12 @@ bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t sl
 
     __attribute__((unused)) bool okay = transport_master(master_matrix, slave_matrix);
 #if SPLIT_MAX_CONNECTION_ERRORS > 0
+#    ifdef SPLIT_COMMON_TRANSACTIONS
+    if (!okay && split_link_cycle_skipped()) {
+        // Backing off after a failure: the slave state is left as it was, and the link is neither failing nor recovering
+        return is_transport_connected();
+    }
+#    endif // SPLIT_COMMON_TRANSACTIONS
     if (!okay) {
         if (connection_errors < UINT8_MAX) {
             connection_errors++;
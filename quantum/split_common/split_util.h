@@ -4,6 +4,7 @@
 #include <stdint.h>
 
 #include "matrix.h"
+#include "keyboard.h"
 
 extern volatile bool isLeftHand;
 
@@ -16,3 +17,9 @@ bool is_transport_connected(void);
 void split_watchdog_update(bool done);
 void split_watchdog_task(void);
 bool split_watchdog_check(void);
+
+#ifdef SPLIT_MATRIX_EVENTS
+// oldest slave key event the master has received but the matrix task has not consumed yet
+bool split_matrix_event_peek(keyevent_t *event);
+void split_matrix_event_drop(void);
+#endif // SPLIT_MATRIX_EVENTS
@@ -0,0 +1,84 @@
+split_transactions_DEFS := \
+	-DSPLIT_KEYBOARD \
+	-DMATRIX_ROWS=8 \
+	-DMATRIX_COLS=8 \
+	-DSPLIT_TRANSPORT_MIRROR \
+	-DSPLIT_LAYER_STATE_ENABLE \
+	-DSPLIT_LED_STATE_ENABLE \
+	-DSPLIT_MODS_ENABLE \
+	-DSPLIT_LINK_STATS_ENABLE \
+	-DSPLIT_LINK_ADAPTIVE_RETRY \
+	-DSPLIT_COMMON_TRANSACTIONS
+split_transactions_SRC := \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/sync_timer.c \
+	$(QUANTUM_PATH)/split_common/split_link.c \
+	$(QUANTUM_PATH)/split_common/split_util.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/transport.c \
+	$(QUANTUM_PATH)/split_common/tests/transactions_tests.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers/serial_loopback.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+split_transactions_INC := \
+	$(QUANTUM_PATH)/split_common \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers \
+	$(DRIVER_PATH)
+
+split_transactions_batched_DEFS := \
+	$(split_transactions_DEFS) \
+	-DSPLIT_TRANSPORT_BATCHING
+split_transactions_batched_SRC := $(split_transactions_SRC)
+split_transactions_batched_INC := $(split_transactions_INC)
+
+split_transactions_events_DEFS := \
+	$(split_transactions_DEFS) \
+	-DSPLIT_MATRIX_EVENTS
+split_transactions_events_SRC := $(split_transactions_SRC)
+split_transactions_events_INC := $(split_transactions_INC)
+
+split_transactions_batched_events_DEFS := \
+	$(split_transactions_DEFS) \
+	-DSPLIT_TRANSPORT_BATCHING \
+	-DSPLIT_MATRIX_EVENTS
+split_transactions_batched_events_SRC := $(split_transactions_SRC)
+split_transactions_batched_events_INC := $(split_transactions_INC)
+
+split_transactions_pointing_DEFS := \
+	$(split_transactions_DEFS) \
+	-DPOINTING_DEVICE_ENABLE \
+	-DSPLIT_POINTING_ENABLE \
+	-DPOINTING_DEVICE_ACCUMULATOR_ENABLE \
+	-DSPLIT_POINTING_FUSION \
+	-DSPLIT_POINTING_STREAM
+split_transactions_pointing_SRC := $(split_transactions_SRC)
+split_transactions_pointing_INC := \
+	$(split_transactions_INC) \
+	$(QUANTUM_PATH)/pointing_device
+
+split_transactions_encoded_DEFS := \
+	-DSPLIT_KEYBOARD \
+	-DMATRIX_ROWS=8 \
+	-DMATRIX_COLS=32 \
+	-DSPLIT_TRANSPORT_MIRROR \
+	-DSPLIT_LAYER_STATE_ENABLE \
+	-DSPLIT_LED_STATE_ENABLE \
+	-DSPLIT_MODS_ENABLE \
+	-DSPLIT_COMMON_TRANSACTIONS \
+	-DSPLIT_TRANSPORT_ENCODING
+split_transactions_encoded_SRC := \
+	$(split_transactions_SRC) \
+	$(QUANTUM_PATH)/split_common/transaction_codec.c
+split_transactions_encoded_INC := $(split_transactions_INC)
+
+split_transactions_batched_encoded_DEFS := \
+	$(split_transactions_encoded_DEFS) \
+	-DSPLIT_TRANSPORT_BATCHING
+split_transactions_batched_encoded_SRC := $(split_transactions_encoded_SRC)
+split_transactions_batched_encoded_INC := $(split_transactions_INC)
+
+split_transaction_codec_SRC := \
+	$(QUANTUM_PATH)/split_common/transaction_codec.c \
+	$(QUANTUM_PATH)/split_common/tests/transaction_codec_tests.cpp
+split_transaction_codec_INC := \
+	$(QUANTUM_PATH)/split_common
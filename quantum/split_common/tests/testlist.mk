@@ -0,0 +1,9 @@
+TEST_LIST += \
+	split_transactions \
+	split_transactions_batched \
+	split_transactions_events \
+	split_transactions_batched_events \
+	split_transactions_pointing \
+	split_transactions_encoded \
+	split_transactions_batched_encoded \
+	split_transaction_codec
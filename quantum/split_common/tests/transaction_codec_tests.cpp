@@ -0,0 +1,107 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <random>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "transaction_codec.h"
+}
+
+class TransactionCodec : public ::testing::Test {
+   protected:
+    const split_transaction_codec_t *codec = &split_codec_xor_rle;
+
+    uint8_t encode(const uint8_t *previous, const uint8_t *current, uint8_t length, uint8_t *out, uint8_t out_size = 255) {
+        uint8_t out_length = 0;
+        EXPECT_TRUE(codec->encode(previous, current, length, out, out_size, &out_length));
+        return out_length;
+    }
+};
+
+TEST_F(TransactionCodec, UnchangedPayloadEncodesToNothing) {
+    uint8_t data[16] = {1, 2, 3, 4};
+    uint8_t out[32];
+    EXPECT_EQ(encode(data, data, sizeof(data), out), 0);
+}
+
+TEST_F(TransactionCodec, SingleByteChange) {
+    uint8_t previous[16] = {};
+    uint8_t current[16]  = {};
+    current[9]           = 0x42;
+    uint8_t out[32];
+    // Skip nine, then one literal; the unchanged tail is left out
+    ASSERT_EQ(encode(previous, current, sizeof(current), out), 3);
+    EXPECT_EQ(out[0], 0x80 | 8);
+    EXPECT_EQ(out[1], 0);
+    EXPECT_EQ(out[2], 0x42);
+
+    EXPECT_TRUE(codec->decode(previous, sizeof(previous), out, 3, true));
+    EXPECT_EQ(memcmp(previous, current, sizeof(current)), 0);
+}
+
+TEST_F(TransactionCodec, LoneUnchangedByteStaysInLiteral) {
+    uint8_t previous[4] = {0, 0, 0, 0};
+    uint8_t current[4]  = {1, 0, 1, 0};
+    uint8_t out[8];
+    ASSERT_EQ(encode(previous, current, sizeof(current), out), 4);
+    EXPECT_EQ(out[0], 2);
+}
+
+TEST_F(TransactionCodec, DoesNotOverflowOutput) {
+    uint8_t previous[16] = {};
+    uint8_t current[16];
+    memset(current, 0xFF, sizeof(current));
+    uint8_t out[8];
+    uint8_t out_length;
+    EXPECT_FALSE(codec->encode(previous, current, sizeof(current), out, sizeof(out), &out_length));
+}
+
+TEST_F(TransactionCodec, RejectsMalformedInput) {
+    uint8_t data[8] = {};
+    // Skips past the end
+    const uint8_t skip[] = {0x80 | 8};
+    EXPECT_FALSE(codec->decode(data, sizeof(data), skip, sizeof(skip), false));
+    // Literal run longer than the input
+    const uint8_t literal[] = {3, 1, 2};
+    EXPECT_FALSE(codec->decode(data, sizeof(data), literal, sizeof(literal), false));
+    // Literal run past the end of the payload
+    const uint8_t past_end[] = {0x80 | 6, 1, 1, 2};
+    EXPECT_FALSE(codec->decode(data, sizeof(data), past_end, sizeof(past_end), false));
+}
+
+TEST_F(TransactionCodec, DecodingTwiceRestoresOriginal) {
+    uint8_t previous[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t current[8]  = {1, 9, 3, 4, 5, 6, 0, 8};
+    uint8_t data[8];
+    uint8_t out[16];
+    uint8_t length = encode(previous, current, sizeof(current), out);
+    memcpy(data, previous, sizeof(data));
+    EXPECT_TRUE(codec->decode(data, sizeof(data), out, length, true));
+    EXPECT_EQ(memcmp(data, current, sizeof(data)), 0);
+    EXPECT_TRUE(codec->decode(data, sizeof(data), out, length, true));
+    EXPECT_EQ(memcmp(data, previous, sizeof(data)), 0);
+}
+
+TEST_F(TransactionCodec, RandomRoundTrips) {
+    std::mt19937 rng(1234);
+    for (int iteration = 0; iteration < 20000; iteration++) {
+        uint8_t length = 1 + rng() % 200;
+        uint8_t previous[200], current[200], data[200];
+        for (uint8_t i = 0; i < length; i++) {
+            previous[i] = rng();
+            // Mostly unchanged, with changes both scattered and in runs
+            current[i] = (rng() % 4 == 0) ? (uint8_t)rng() : previous[i];
+        }
+        uint8_t out[255];
+        uint8_t out_length;
+        if (!codec->encode(previous, current, length, out, sizeof(out), &out_length)) {
+            continue;
+        }
+        memcpy(data, previous, length);
+        ASSERT_TRUE(codec->decode(data, length, out, out_length, false));
+        ASSERT_TRUE(codec->decode(data, length, out, out_length, true));
+        ASSERT_EQ(memcmp(data, current, length), 0) << "iteration " << iteration;
+    }
+}
@@ -0,0 +1,745 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "transactions.h"
+#include "serial_loopback.h"
+#include "split_link.h"
+#include "split_util.h"
+#include "timer.h"
+#include "sync_timer.h"
+#include "crc.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+
+#ifdef SPLIT_TRANSPORT_BATCHING
+void slave_batch_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+#endif
+
+layer_state_t layer_state         = 0;
+layer_state_t default_layer_state = 0;
+
+static uint8_t master_mods;
+static uint8_t master_leds;
+static uint8_t slave_mods;
+static uint8_t slave_leds;
+
+uint8_t get_mods(void) {
+    return master_mods;
+}
+uint8_t get_weak_mods(void) {
+    return 0;
+}
+uint8_t get_oneshot_mods(void) {
+    return 0;
+}
+uint8_t get_oneshot_locked_mods(void) {
+    return 0;
+}
+void set_mods(uint8_t mods) {
+    slave_mods = mods;
+}
+void set_weak_mods(uint8_t mods) {}
+void set_oneshot_mods(uint8_t mods) {}
+void set_oneshot_locked_mods(uint8_t mods) {}
+
+uint8_t host_keyboard_leds(void) {
+    return master_leds;
+}
+void set_split_host_keyboard_leds(uint8_t led_state) {
+    slave_leds = led_state;
+}
+
+bool is_keyboard_master(void) {
+    return true;
+}
+bool usb_vbus_state(void) {
+    return true;
+}
+void usb_disconnect(void) {}
+
+#ifdef SPLIT_TRANSPORT_ENCODING
+#    include "transaction_codec.h"
+
+// Replaces the default codec with one that counts its calls before handing them on
+static int codec_encodes;
+static int codec_decodes;
+
+static bool counting_encode(const uint8_t *previous, const uint8_t *current, uint8_t length, uint8_t *out, uint8_t out_size, uint8_t *out_length) {
+    codec_encodes++;
+    return split_codec_xor_rle.encode(previous, current, length, out, out_size, out_length);
+}
+static bool counting_decode(uint8_t *data, uint8_t length, const uint8_t *in, uint8_t in_length, bool apply) {
+    codec_decodes++;
+    return split_codec_xor_rle.decode(data, length, in, in_length, apply);
+}
+static const split_transaction_codec_t counting_codec = {
+    .encode = counting_encode,
+    .decode = counting_decode,
+};
+
+const split_transaction_codec_t *split_transport_encoding_codec(void) {
+    return &counting_codec;
+}
+#endif
+
+#if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+static report_mouse_t           slave_sensor;
+static pointing_device_motion_t shared_motion;
+static int                      shared_motion_updates;
+
+static report_mouse_t slave_sensor_get_report(report_mouse_t mouse_report) {
+    // The sensor hands out what moved since it was last read
+    mouse_report = slave_sensor;
+    slave_sensor = {};
+    return mouse_report;
+}
+
+static const pointing_device_driver_t slave_sensor_driver = {.get_report = slave_sensor_get_report};
+const pointing_device_driver_t       *pointing_device_driver = &slave_sensor_driver;
+
+void pointing_device_set_shared_motion(const pointing_device_motion_t *motion) {
+    shared_motion = *motion;
+    shared_motion_updates++;
+}
+uint16_t pointing_device_get_shared_cpi(void) {
+    return 0;
+}
+#endif
+}
+
+#define HALF_ROWS ((MATRIX_ROWS) / 2)
+
+class SplitTransactions : public ::testing::Test {
+   protected:
+    matrix_row_t master_matrix[HALF_ROWS]          = {};
+    matrix_row_t slave_matrix[HALF_ROWS]           = {};
+    matrix_row_t master_matrix_on_slave[HALF_ROWS] = {};
+    matrix_row_t slave_matrix_on_master[HALF_ROWS] = {};
+
+    void SetUp() override {
+        set_time(0);
+        serial_loopback_reset();
+        split_link_reset();
+#ifdef SPLIT_LINK_STATS_ENABLE
+        split_link_stats_reset();
+#endif
+        layer_state = default_layer_state = 0;
+        master_mods = master_leds = slave_mods = slave_leds = 0;
+#if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+        slave_sensor          = {};
+        shared_motion_updates = 0;
+#endif
+#ifdef SPLIT_MATRIX_EVENTS
+        keyevent_t event;
+        while (transactions_slave_matrix_event_peek(&event)) {
+            transactions_slave_matrix_event_drop();
+        }
+#endif
+        // Let the forced resync of every transaction happen up front
+        advance_time(1000);
+    }
+
+    layer_state_t slave_layer_state = 0;
+
+    // One scan on each half: the slave publishes its state, then the master syncs.
+    bool sync(uint32_t ms = 1) {
+        // Both halves share the layer state globals in this process
+        layer_state_t master_layer_state = layer_state;
+        serial_loopback_slave_begin();
+        transactions_slave(master_matrix_on_slave, slave_matrix);
+        serial_loopback_slave_end();
+        slave_layer_state = layer_state;
+        layer_state       = master_layer_state;
+
+        bool okay = transactions_master(master_matrix, slave_matrix_on_master);
+        advance_time(ms);
+        return okay;
+    }
+
+    // As sync(), but through the connection check the master's matrix scan goes through
+    bool sync_if_connected(uint32_t ms = 1) {
+        layer_state_t master_layer_state = layer_state;
+        serial_loopback_slave_begin();
+        transactions_slave(master_matrix_on_slave, slave_matrix);
+        serial_loopback_slave_end();
+        slave_layer_state = layer_state;
+        layer_state       = master_layer_state;
+
+        bool connected = transport_master_if_connected(master_matrix, slave_matrix_on_master);
+        advance_time(ms);
+        return connected;
+    }
+
+    // A scan on the slave only, without the master looking
+    void slave_scan(uint32_t ms = 1) {
+        layer_state_t master_layer_state = layer_state;
+        serial_loopback_slave_begin();
+        transactions_slave(master_matrix_on_slave, slave_matrix);
+        serial_loopback_slave_end();
+        layer_state = master_layer_state;
+        advance_time(ms);
+    }
+};
+
+TEST_F(SplitTransactions, SlaveMatrixReachesMaster) {
+    slave_matrix[0] = 0x81;
+    slave_matrix[3] = 0x10;
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(slave_matrix_on_master[0], 0x81);
+    EXPECT_EQ(slave_matrix_on_master[3], 0x10);
+}
+
+TEST_F(SplitTransactions, MasterStateReachesSlave) {
+    master_matrix[1] = 0x42;
+    master_mods      = 0x05;
+    master_leds      = 0x02;
+    layer_state      = 0x0C;
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(master_matrix_on_slave[1], 0x42);
+    EXPECT_EQ(slave_mods, 0x05);
+    EXPECT_EQ(slave_leds, 0x02);
+    EXPECT_EQ(slave_layer_state, 0x0C);
+}
+
+TEST_F(SplitTransactions, RecoversFromTransientFailures) {
+    master_mods     = 0x11;
+    slave_matrix[2] = 0x04;
+    serial_loopback_fail_next(2);
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(slave_mods, 0x11);
+    EXPECT_EQ(slave_matrix_on_master[2], 0x04);
+    EXPECT_EQ(serial_loopback_get_stats().failures, 2);
+}
+
+#ifdef SPLIT_LINK_ADAPTIVE_RETRY
+TEST_F(SplitTransactions, FlakyLinkBacksOffInsteadOfStalling) {
+    EXPECT_TRUE(sync());
+    // A dead link: no retries once the error rate is up, and cycles get skipped
+    serial_loopback_fail_next(1000);
+    uint32_t attempts = 0;
+    for (int i = 0; i < 40; i++) {
+        serial_loopback_stats_t before = serial_loopback_get_stats();
+        EXPECT_FALSE(sync());
+        attempts += serial_loopback_get_stats().transactions - before.transactions;
+    }
+    split_link_status_t status;
+    split_link_get_status(&status);
+    EXPECT_GT(status.error_rate, SPLIT_LINK_RETRY_THRESHOLD);
+    EXPECT_EQ(status.backoff, SPLIT_LINK_MAX_BACKOFF - 1);
+    EXPECT_GT(status.skipped, 20);
+    // Far fewer than the up to ten blocking retries per cycle this used to cost
+    EXPECT_LT(attempts, 30);
+
+    // Once the link is back, the sync rate and retries recover
+    serial_loopback_reset();
+    for (int i = 0; i < SPLIT_LINK_MAX_BACKOFF; i++) {
+        sync();
+    }
+    slave_matrix[0] = 0x42;
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(slave_matrix_on_master[0], 0x42);
+    for (int i = 0; i < 40; i++) {
+        EXPECT_TRUE(sync());
+    }
+    split_link_get_status(&status);
+    EXPECT_LT(status.error_rate, SPLIT_LINK_RETRY_THRESHOLD);
+    EXPECT_EQ(split_link_retries(), SPLIT_TRANSACTION_RETRIES);
+}
+
+TEST_F(SplitTransactions, SkippedCyclesAreNotConnectionErrors) {
+    // SPLIT_MAX_CONNECTION_ERRORS
+    const uint32_t max_connection_errors = 10;
+
+    slave_matrix[0] = 0x24;
+    EXPECT_TRUE(sync_if_connected());
+    EXPECT_TRUE(sync_if_connected());
+    EXPECT_EQ(slave_matrix_on_master[0], 0x24);
+
+    // Fail just short of a disconnect, with the link backing off in between
+    serial_loopback_fail_next(1000);
+    split_link_status_t status;
+    do {
+        EXPECT_TRUE(sync_if_connected());
+        EXPECT_TRUE(is_transport_connected());
+        split_link_get_status(&status);
+    } while (status.failures < max_connection_errors - 1);
+    EXPECT_GT(status.skipped, 0);
+    EXPECT_EQ(slave_matrix_on_master[0], 0x24);
+
+    // Once the link is back, the slave state follows again
+    serial_loopback_reset();
+    slave_matrix[0] = 0x42;
+    for (int i = 0; i < SPLIT_LINK_MAX_BACKOFF + 2; i++) {
+        EXPECT_TRUE(sync_if_connected());
+    }
+    EXPECT_EQ(slave_matrix_on_master[0], 0x42);
+}
+#else  // SPLIT_LINK_ADAPTIVE_RETRY
+TEST_F(SplitTransactions, FailedTransactionIsRetriedWithoutSkippingCycles) {
+    EXPECT_TRUE(sync());
+    serial_loopback_fail_next(1000);
+    for (int i = 0; i < 5; i++) {
+        serial_loopback_stats_t before = serial_loopback_get_stats();
+        EXPECT_FALSE(sync());
+        // The first transaction of the cycle, then every retry of it
+        EXPECT_EQ(serial_loopback_get_stats().transactions - before.transactions, SPLIT_TRANSACTION_RETRIES + 1);
+    }
+    split_link_status_t status;
+    split_link_get_status(&status);
+    EXPECT_EQ(status.backoff, 0);
+    EXPECT_EQ(status.skipped, 0);
+    EXPECT_EQ(split_link_retries(), SPLIT_TRANSACTION_RETRIES);
+}
+#endif // SPLIT_LINK_ADAPTIVE_RETRY
+
+TEST_F(SplitTransactions, IsolatedFailureIsRetriedWithinTheCycle) {
+    EXPECT_TRUE(sync());
+    serial_loopback_fail_next(1);
+    EXPECT_TRUE(sync());
+    split_link_status_t status;
+    split_link_get_status(&status);
+    EXPECT_EQ(status.failures, 0);
+    EXPECT_EQ(status.skipped, 0);
+}
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+TEST_F(SplitTransactions, LinkStatsPerTransaction) {
+    EXPECT_TRUE(sync());
+    serial_loopback_fail_next(1);
+    EXPECT_TRUE(sync());
+
+    // A checksum that doesn't match the data it describes
+    serial_loopback_slave_begin();
+    transactions_slave(master_matrix_on_slave, slave_matrix);
+#    ifdef SPLIT_MATRIX_EVENTS
+    split_shmem->smatrix_events.head.checksum ^= 0xFF;
+#    else
+    split_shmem->smatrix.checksum ^= 0xFF;
+#    endif
+    serial_loopback_slave_end();
+    transactions_master(master_matrix, slave_matrix_on_master);
+
+    split_link_transaction_stats_t stats;
+#    ifdef SPLIT_MATRIX_EVENTS
+    const int8_t checksum_id = GET_SLAVE_MATRIX_EVENTS_HEAD;
+#    else
+    const int8_t checksum_id = GET_SLAVE_MATRIX_CHECKSUM;
+#    endif
+#    ifdef SPLIT_TRANSPORT_BATCHING
+    split_link_stats_get(EXECUTE_BATCH, &stats);
+    const uint16_t batch_timeouts = stats.timeouts;
+#    else
+    const uint16_t batch_timeouts = 0;
+#    endif
+    split_link_stats_get(checksum_id, &stats);
+    EXPECT_GE(stats.success, 2);
+    EXPECT_EQ(stats.timeouts + batch_timeouts, 1);
+    EXPECT_EQ(stats.crc_errors, 0);
+    EXPECT_EQ(stats.latency[0], stats.success);
+
+    split_link_stats_get(GET_SLAVE_MATRIX_DATA, &stats);
+    EXPECT_GE(stats.crc_errors, 1);
+    // Only transfers that passed validation leave a latency sample
+    uint16_t samples = 0;
+    for (uint8_t bucket = 0; bucket < SPLIT_LINK_STATS_BUCKETS; bucket++) {
+        samples += stats.latency[bucket];
+    }
+    EXPECT_EQ(samples, stats.success);
+
+    split_link_stats_reset();
+    split_link_stats_get(checksum_id, &stats);
+    EXPECT_EQ(stats.success, 0);
+}
+#endif
+
+TEST_F(SplitTransactions, IdleCycleIsOneRoundTrip) {
+    EXPECT_TRUE(sync());
+#if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_FUSION)
+    // Once the slave has published the pointing session it was handed
+    EXPECT_TRUE(sync());
+#endif
+    serial_loopback_stats_t before = serial_loopback_get_stats();
+    EXPECT_TRUE(sync());
+#if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    // Plus the pointing checksum
+    EXPECT_EQ(serial_loopback_get_stats().transactions - before.transactions, 2);
+#else
+    EXPECT_EQ(serial_loopback_get_stats().transactions - before.transactions, 1);
+#endif
+}
+
+TEST_F(SplitTransactions, DirtyCycleRoundTrips) {
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    master_matrix[0] = 1;
+    master_mods      = 2;
+    master_leds      = 3;
+    layer_state      = 4;
+    serial_loopback_stats_t before = serial_loopback_get_stats();
+    EXPECT_TRUE(sync());
+#ifdef SPLIT_TRANSPORT_BATCHING
+    // The frame shape changed, so its lengths are announced first
+    EXPECT_EQ(serial_loopback_get_stats().transactions - before.transactions, 2);
+#elif defined(SPLIT_TRANSPORT_ENCODING)
+    // The mirrored matrix goes out encoded, after announcing its length
+    EXPECT_EQ(serial_loopback_get_stats().transactions - before.transactions, 6);
+#elif defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    EXPECT_EQ(serial_loopback_get_stats().transactions - before.transactions, 6);
+#else
+    EXPECT_EQ(serial_loopback_get_stats().transactions - before.transactions, 5);
+#endif
+}
+
+#ifdef SPLIT_TRANSPORT_BATCHING
+TEST_F(SplitTransactions, BatchedFrameIsAppliedInOrder) {
+    EXPECT_TRUE(sync());
+    // The master's layer state and mods go out in the same frame as the matrix read
+    layer_state     = 0x30;
+    master_mods     = 0x44;
+    slave_matrix[1] = 0x99;
+    serial_loopback_stats_t before = serial_loopback_get_stats();
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(slave_matrix_on_master[1], 0x99);
+    // Lengths, the frame with the checksum read, then the matrix itself
+    EXPECT_EQ(serial_loopback_get_stats().transactions - before.transactions, 3);
+    // The slave applies them on its next scan
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(slave_layer_state, 0x30);
+    EXPECT_EQ(slave_mods, 0x44);
+}
+
+TEST_F(SplitTransactions, WritesOfAFailedFrameAreSentAgain) {
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    layer_state = 0x30;
+    master_mods = 0x44;
+    serial_loopback_fail_next(100);
+    EXPECT_FALSE(sync());
+
+    // Long before the forced sync would pick them up
+    serial_loopback_fail_next(0);
+    for (int i = 0; i < SPLIT_LINK_MAX_BACKOFF + 2; i++) {
+        sync();
+    }
+    EXPECT_EQ(slave_layer_state, 0x30);
+    EXPECT_EQ(slave_mods, 0x44);
+}
+#endif
+
+#ifdef SPLIT_MATRIX_EVENTS
+TEST_F(SplitTransactions, SlaveEventsKeepOrderAndTiming) {
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    const uint16_t press_time = timer_read();
+    slave_matrix[2]           = 0x08;
+    // Published by the slave now, but the master only gets to it a few ms later
+    serial_loopback_slave_begin();
+    transactions_slave(master_matrix_on_slave, slave_matrix);
+    serial_loopback_slave_end();
+    advance_time(3);
+    slave_matrix[2] = 0x00;
+    slave_matrix[1] = 0x01;
+    EXPECT_TRUE(sync());
+
+    // The tap is seen as two events even though the master never sees the key down in a matrix snapshot
+    EXPECT_EQ(slave_matrix_on_master[2], 0x00);
+    EXPECT_EQ(slave_matrix_on_master[1], 0x01);
+    keyevent_t event;
+    ASSERT_TRUE(transactions_slave_matrix_event_peek(&event));
+    EXPECT_EQ(event.key.row, 2);
+    EXPECT_EQ(event.key.col, 3);
+    EXPECT_TRUE(event.pressed);
+    EXPECT_EQ(event.time, press_time);
+    transactions_slave_matrix_event_drop();
+    // Changes from the same scan are reported in matrix order
+    ASSERT_TRUE(transactions_slave_matrix_event_peek(&event));
+    EXPECT_EQ(event.key.row, 1);
+    EXPECT_TRUE(event.pressed);
+    EXPECT_EQ(event.time, (uint16_t)(press_time + 3));
+    transactions_slave_matrix_event_drop();
+    ASSERT_TRUE(transactions_slave_matrix_event_peek(&event));
+    EXPECT_EQ(event.key.row, 2);
+    EXPECT_FALSE(event.pressed);
+    EXPECT_EQ(event.time, (uint16_t)(press_time + 3));
+    transactions_slave_matrix_event_drop();
+    EXPECT_FALSE(transactions_slave_matrix_event_peek(&event));
+}
+
+TEST_F(SplitTransactions, SlaveEventsAreFetchedInWindows) {
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    // A full ring is more than one window, so it takes several reads
+    for (uint8_t i = 0; i < SPLIT_MATRIX_EVENTS_SIZE; i++) {
+        slave_matrix[0] ^= 1 << i;
+        slave_scan();
+    }
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(slave_matrix_on_master[0], slave_matrix[0]);
+    keyevent_t event;
+    for (uint8_t i = 0; i < SPLIT_MATRIX_EVENTS_SIZE; i++) {
+        ASSERT_TRUE(transactions_slave_matrix_event_peek(&event));
+        EXPECT_EQ(event.key.row, 0);
+        EXPECT_EQ(event.key.col, i);
+        EXPECT_TRUE(event.pressed);
+        transactions_slave_matrix_event_drop();
+    }
+    EXPECT_FALSE(transactions_slave_matrix_event_peek(&event));
+}
+
+TEST_F(SplitTransactions, SlaveEventOverflowFallsBackToSnapshot) {
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    // More changes than the ring holds between two master reads
+    for (uint8_t i = 0; i <= SPLIT_MATRIX_EVENTS_SIZE; i++) {
+        slave_matrix[i % HALF_ROWS] ^= 1 << (i % 8);
+        serial_loopback_slave_begin();
+        transactions_slave(master_matrix_on_slave, slave_matrix);
+        serial_loopback_slave_end();
+    }
+    EXPECT_TRUE(sync());
+    for (uint8_t row = 0; row < HALF_ROWS; row++) {
+        EXPECT_EQ(slave_matrix_on_master[row], slave_matrix[row]);
+    }
+    keyevent_t event;
+    EXPECT_FALSE(transactions_slave_matrix_event_peek(&event));
+
+    // The stream picks up again after the snapshot
+    slave_matrix[0] ^= 0x80;
+    EXPECT_TRUE(sync());
+    ASSERT_TRUE(transactions_slave_matrix_event_peek(&event));
+    EXPECT_EQ(event.key.row, 0);
+    EXPECT_EQ(event.key.col, 7);
+    transactions_slave_matrix_event_drop();
+    EXPECT_EQ(slave_matrix_on_master[0], slave_matrix[0]);
+}
+
+TEST_F(SplitTransactions, SlaveEventsSurviveFailedReads) {
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    slave_matrix[3] = 0x02;
+    // Retried within the same cycle, without replaying anything twice
+    serial_loopback_fail_next(2);
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(slave_matrix_on_master[3], 0x02);
+    keyevent_t event;
+    ASSERT_TRUE(transactions_slave_matrix_event_peek(&event));
+    EXPECT_EQ(event.key.row, 3);
+    EXPECT_EQ(event.key.col, 1);
+    transactions_slave_matrix_event_drop();
+    EXPECT_FALSE(transactions_slave_matrix_event_peek(&event));
+}
+#endif
+
+#ifdef SPLIT_TRANSPORT_ENCODING
+TEST_F(SplitTransactions, MirrorIsSentEncoded) {
+    EXPECT_TRUE(sync());
+    split_transport_encoding_stats_t before = transactions_encoding_get_stats();
+    master_matrix[2] |= 0x00010000;
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(master_matrix_on_slave[2], master_matrix[2]);
+    master_matrix[2] |= 0x00020000;
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(master_matrix_on_slave[2], master_matrix[2]);
+
+    split_transport_encoding_stats_t after = transactions_encoding_get_stats();
+    EXPECT_EQ(after.encoded - before.encoded, 2);
+    EXPECT_EQ(after.raw - before.raw, 0);
+#    ifdef SPLIT_TRANSPORT_BATCHING
+    // 16 byte matrix sent as a 6 byte delta, batch frames carry the length themselves
+    EXPECT_EQ(after.bytes_saved - before.bytes_saved, (16 - 6) * 2);
+#    else
+    // 16 byte matrix sent as a 6 byte delta, the first one also pays for announcing the length
+    EXPECT_EQ(after.bytes_saved - before.bytes_saved, (16 - 6 - 2) + (16 - 6));
+#    endif
+}
+
+TEST_F(SplitTransactions, CodecCanBeReplaced) {
+    EXPECT_TRUE(sync());
+    codec_encodes = codec_decodes = 0;
+    master_matrix[1] |= 0x00000100;
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(master_matrix_on_slave[1], master_matrix[1]);
+    EXPECT_EQ(codec_encodes, 1);
+    // Checked, then applied
+    EXPECT_EQ(codec_decodes, 2);
+}
+
+TEST_F(SplitTransactions, DriftedSlaveCopyIsRepairedByForcedSync) {
+    EXPECT_TRUE(sync());
+    master_matrix[0] = 0x11;
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(master_matrix_on_slave[0], 0x11);
+
+    // Corrupt the slave's copy behind the master's back
+    serial_loopback_slave_begin();
+    split_shmem->mmatrix.matrix[1] = 0xDEAD;
+    serial_loopback_slave_end();
+
+    // The delta no longer lands on what the master encoded against, so the slave leaves its copy alone
+    master_matrix[3] = 0x22;
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(master_matrix_on_slave[0], 0x11);
+    EXPECT_EQ(master_matrix_on_slave[1], 0xDEAD);
+    EXPECT_EQ(master_matrix_on_slave[3], 0);
+
+    // FORCED_SYNC_THROTTLE_MS
+    advance_time(100);
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(master_matrix_on_slave[1], 0);
+    EXPECT_EQ(master_matrix_on_slave[3], 0x22);
+}
+
+#    ifdef SPLIT_TRANSPORT_BATCHING
+TEST_F(SplitTransactions, EncodedWriteOfAFailedFrameIsSentAgain) {
+    EXPECT_TRUE(sync());
+    master_matrix[0] = 0x11;
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+
+    // Encoded against a copy the slave never gets
+    master_matrix[2] = 0x22;
+    serial_loopback_fail_next(100);
+    EXPECT_FALSE(sync());
+
+    serial_loopback_fail_next(0);
+    master_matrix[3] = 0x33;
+    for (int i = 0; i < SPLIT_LINK_MAX_BACKOFF + 2; i++) {
+        sync();
+    }
+    EXPECT_EQ(master_matrix_on_slave[0], 0x11);
+    EXPECT_EQ(master_matrix_on_slave[2], 0x22);
+    EXPECT_EQ(master_matrix_on_slave[3], 0x33);
+}
+
+TEST_F(SplitTransactions, OversizedEncodedLengthInFrameIsRejected) {
+    const uint8_t m2s_length = SPLIT_BATCH_M2S_BUFFER_SIZE;
+    const uint8_t s2m_length = 1;
+    uint8_t       saved_m2s  = split_transaction_table[EXECUTE_BATCH].initiator2target_buffer_size;
+    uint8_t       saved_s2m  = split_transaction_table[EXECUTE_BATCH].target2initiator_buffer_size;
+
+    serial_loopback_slave_begin();
+    split_transaction_table[EXECUTE_BATCH].initiator2target_buffer_size = m2s_length;
+    split_transaction_table[EXECUTE_BATCH].target2initiator_buffer_size = s2m_length;
+
+    // One encoded entry whose length byte claims more than the encoding buffer holds, but still fits the frame
+    uint8_t *frame = split_shmem->batch_m2s_buffer;
+    memset(frame, 0xAA, m2s_length);
+    frame[1] = PUT_ENCODED_DATA;
+    frame[2] = m2s_length - 2;
+    frame[3] = PUT_MASTER_MATRIX;
+    frame[0] = crc8(&frame[1], m2s_length - 1);
+    ASSERT_GT(frame[2], SPLIT_TRANSPORT_ENCODING_BUFFER_SIZE);
+
+    split_batch_info_t info_before = split_shmem->batch_info;
+    slave_batch_exec_callback(0, NULL, 0, NULL);
+    EXPECT_EQ(memcmp(&split_shmem->batch_info, &info_before, sizeof(info_before)), 0);
+    // Answered as a rejected frame
+    uint8_t *response = split_shmem->batch_s2m_buffer;
+    EXPECT_EQ(response[0], (uint8_t)~(crc8(&response[1], s2m_length - 1) ^ frame[0]));
+
+    split_transaction_table[EXECUTE_BATCH].initiator2target_buffer_size = saved_m2s;
+    split_transaction_table[EXECUTE_BATCH].target2initiator_buffer_size = saved_s2m;
+    serial_loopback_slave_end();
+}
+#    endif
+#endif
+
+#if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+TEST_F(SplitTransactions, SlaveMotionArrivesAsRunningTotals) {
+    EXPECT_TRUE(sync());
+    pointing_device_motion_t start = shared_motion;
+
+    // Three sensor reads on the slave before the master looks again
+    slave_sensor.x = 5;
+    slave_scan();
+    slave_sensor.x = -2;
+    slave_sensor.y = 7;
+    slave_scan();
+    uint16_t last_read = sync_timer_read();
+    slave_sensor.x     = 1;
+    slave_scan();
+    slave_scan();
+
+    serial_loopback_slave_begin();
+    serial_loopback_slave_end();
+    EXPECT_TRUE(transactions_master(master_matrix, slave_matrix_on_master));
+    EXPECT_EQ((int16_t)(shared_motion.x - start.x), 4);
+    EXPECT_EQ((int16_t)(shared_motion.y - start.y), 7);
+    EXPECT_EQ(shared_motion.time, last_read);
+}
+
+TEST_F(SplitTransactions, RestartedSlaveIsHandedTheSessionAgain) {
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    uint8_t session = shared_motion.session;
+    EXPECT_NE(session, 0);
+
+    // The slave restarts, and its totals start over in session 0
+    serial_loopback_slave_begin();
+    memset(&split_shmem->pointing, 0, sizeof(split_shmem->pointing));
+    serial_loopback_slave_end();
+    slave_sensor.x = 3;
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(shared_motion.session, 0);
+    EXPECT_EQ(shared_motion.x, 3);
+
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(shared_motion.session, session);
+}
+
+#    ifdef SPLIT_POINTING_STREAM
+TEST_F(SplitTransactions, SlaveMotionCanBeFetchedBetweenSyncs) {
+    EXPECT_TRUE(sync());
+    pointing_device_motion_t start   = shared_motion;
+    int                      updates = shared_motion_updates;
+
+    slave_sensor.x = 3;
+    slave_scan();
+    EXPECT_TRUE(transactions_pointing_fetch());
+    EXPECT_EQ(shared_motion_updates, updates + 1);
+    EXPECT_EQ((int16_t)(shared_motion.x - start.x), 3);
+
+    // Nothing new, so only the checksum is read and the totals stay the same
+    serial_loopback_stats_t before = serial_loopback_get_stats();
+    EXPECT_TRUE(transactions_pointing_fetch());
+    EXPECT_EQ((int16_t)(shared_motion.x - start.x), 3);
+    EXPECT_EQ(serial_loopback_get_stats().transactions - before.transactions, 1);
+}
+#    endif
+#endif
+
+TEST_F(SplitTransactions, TypingKeepsBothHalvesInSync) {
+    for (uint32_t i = 0; i < 10000; i++) {
+        // The slave applies the master's state one sync after it was sent
+        matrix_row_t  sent_matrix[HALF_ROWS];
+        uint8_t       sent_mods        = master_mods;
+        layer_state_t sent_layer_state = layer_state;
+        memcpy(sent_matrix, master_matrix, sizeof(sent_matrix));
+
+        // Typing: the slave matrix changes every 20 ms, master mods and layers less often
+        if (i % 20 == 0) slave_matrix[i % HALF_ROWS] ^= 1 << (i % 7);
+        if (i % 20 == 10) master_matrix[i % HALF_ROWS] ^= 1 << (i % 5);
+        if (i % 150 == 0) master_mods ^= 0x02;
+        if (i % 400 == 0) layer_state ^= 0x04;
+        ASSERT_TRUE(sync());
+
+        ASSERT_EQ(memcmp(slave_matrix_on_master, slave_matrix, sizeof(slave_matrix)), 0) << "at cycle " << i;
+        ASSERT_EQ(memcmp(master_matrix_on_slave, sent_matrix, sizeof(sent_matrix)), 0) << "at cycle " << i;
+        ASSERT_EQ(slave_mods, sent_mods) << "at cycle " << i;
+        ASSERT_EQ(slave_layer_state, sent_layer_state) << "at cycle " << i;
+    }
+}
@@ -0,0 +1,95 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "transaction_codec.h"
+
+#define XOR_RLE_SKIP 0x80
+#define XOR_RLE_MAX_RUN 128
+
+static bool xor_rle_encode(const uint8_t *previous, const uint8_t *current, uint8_t length, uint8_t *out, uint8_t out_size, uint8_t *out_length) {
+    uint8_t pos = 0;
+    uint8_t len = 0;
+
+    while (pos < length) {
+        uint8_t unchanged = 0;
+        while (pos + unchanged < length && previous[pos + unchanged] == current[pos + unchanged]) {
+            unchanged++;
+        }
+        if (pos + unchanged == length) {
+            break;
+        }
+
+        // A lone unchanged byte is cheaper carried inside a literal run than skipped
+        if (unchanged > 1) {
+            while (unchanged > 0) {
+                uint8_t run = unchanged < XOR_RLE_MAX_RUN ? unchanged : XOR_RLE_MAX_RUN;
+                if (len >= out_size) {
+                    return false;
+                }
+                out[len++] = XOR_RLE_SKIP | (run - 1);
+                pos += run;
+                unchanged -= run;
+            }
+        }
+
+        uint8_t run = 0;
+        while (pos + run < length && run < XOR_RLE_MAX_RUN) {
+            if (previous[pos + run] == current[pos + run]) {
+                // Stop at two unchanged bytes in a row, or at the unchanged tail
+                if (pos + run + 1 >= length || previous[pos + run + 1] == current[pos + run + 1]) {
+                    break;
+                }
+            }
+            run++;
+        }
+
+        if (len + 1 + run > out_size) {
+            return false;
+        }
+        out[len++] = run - 1;
+        for (uint8_t i = 0; i < run; i++) {
+            out[len++] = previous[pos + i] ^ current[pos + i];
+        }
+        pos += run;
+    }
+
+    *out_length = len;
+    return true;
+}
+
+static bool xor_rle_decode(uint8_t *data, uint8_t length, const uint8_t *in, uint8_t in_length, bool apply) {
+    uint8_t pos = 0;
+    uint8_t i   = 0;
+
+    while (i < in_length) {
+        uint8_t token = in[i++];
+        uint8_t run   = (token & ~XOR_RLE_SKIP) + 1;
+        if (run > length - pos) {
+            return false;
+        }
+        if (token & XOR_RLE_SKIP) {
+            pos += run;
+            continue;
+        }
+        if (run > in_length - i) {
+            return false;
+        }
+        if (apply) {
+            for (uint8_t j = 0; j < run; j++) {
+                data[pos + j] ^= in[i + j];
+            }
+        }
+        pos += run;
+        i += run;
+    }
+    return true;
+}
+
+const split_transaction_codec_t split_codec_xor_rle = {
+    .encode = xor_rle_encode,
+    .decode = xor_rle_decode,
+};
+
+__attribute__((weak)) const split_transaction_codec_t *split_transport_encoding_codec(void) {
+    return &split_codec_xor_rle;
+}
@@ -0,0 +1,43 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Encoder/decoder pair used to shrink a master-to-slave transaction
+ * payload, given the copy of it the slave already holds.
+ */
+typedef struct split_transaction_codec_t {
+    /**
+     * @brief Encodes `current` against `previous` into `out`.
+     *
+     * @return false The encoding does not fit in `out_size` bytes
+     */
+    bool (*encode)(const uint8_t *previous, const uint8_t *current, uint8_t length, uint8_t *out, uint8_t out_size, uint8_t *out_length);
+    /**
+     * @brief Applies an encoding produced by `encode` to `data` in place, or
+     * with `apply` false, only checks that it is well formed.
+     */
+    bool (*decode)(uint8_t *data, uint8_t length, const uint8_t *in, uint8_t in_length, bool apply);
+} split_transaction_codec_t;
+
+/**
+ * @brief XOR-delta + RLE codec.
+ *
+ * The payload is XORed with the previous copy, then written as a sequence of
+ * runs. A token with the top bit set skips `(token & 0x7F) + 1` unchanged
+ * bytes, otherwise `token + 1` XOR bytes follow. Trailing unchanged bytes are
+ * not encoded at all. Decoding the same data twice restores the original, so
+ * a rejected update can be undone.
+ */
+extern const split_transaction_codec_t split_codec_xor_rle;
+
+/**
+ * @brief The codec used by `SPLIT_TRANSPORT_ENCODING`. Defaults to
+ * `split_codec_xor_rle`; override to use another one. Both halves must
+ * return the same codec.
+ */
+const split_transaction_codec_t *split_transport_encoding_codec(void);
@@ -26,6 +26,11 @@ enum serial_transaction_id {
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_MATRIX_EVENTS
+    GET_SLAVE_MATRIX_EVENTS_HEAD,
+    GET_SLAVE_MATRIX_EVENTS_DATA,
+#endif // SPLIT_MATRIX_EVENTS
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -85,6 +90,9 @@ enum serial_transaction_id {
     GET_POINTING_CHECKSUM,
     GET_POINTING_DATA,
     PUT_POINTING_CPI,
+#    ifdef SPLIT_POINTING_FUSION
+    PUT_POINTING_SESSION,
+#    endif // SPLIT_POINTING_FUSION
 #endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
@@ -99,6 +107,16 @@ enum serial_transaction_id {
     PUT_ACTIVITY,
 #endif // SPLIT_ACTIVITY_ENABLE
 
+#if defined(SPLIT_TRANSPORT_ENCODING)
+    PUT_ENCODED_INFO,
+    PUT_ENCODED_DATA,
+#endif // defined(SPLIT_TRANSPORT_ENCODING)
+
+#if defined(SPLIT_TRANSPORT_BATCHING)
+    PUT_BATCH_INFO,
+    EXECUTE_BATCH,
+#endif // defined(SPLIT_TRANSPORT_BATCHING)
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
@@ -125,3 +143,36 @@ enum serial_transaction_id {
 
 // Ensure we only use 5 bits for transaction
 STATIC_ASSERT(NUM_TOTAL_TRANSACTIONS <= (1 << 5), "Max number of usable transactions exceeded");
+
+#if defined(SPLIT_TRANSPORT_ENCODING)
+#    define SPLIT_ENCODE(id) (1UL << (id))
+
+#    ifdef SPLIT_TRANSPORT_MIRROR
+#        define SPLIT_ENCODE_MASTER_MATRIX SPLIT_ENCODE(PUT_MASTER_MATRIX)
+#    else
+#        define SPLIT_ENCODE_MASTER_MATRIX 0
+#    endif
+#    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+#        define SPLIT_ENCODE_RGBLIGHT SPLIT_ENCODE(PUT_RGBLIGHT)
+#    else
+#        define SPLIT_ENCODE_RGBLIGHT 0
+#    endif
+#    if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+#        define SPLIT_ENCODE_LED_MATRIX SPLIT_ENCODE(PUT_LED_MATRIX)
+#    else
+#        define SPLIT_ENCODE_LED_MATRIX 0
+#    endif
+#    if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#        define SPLIT_ENCODE_RGB_MATRIX SPLIT_ENCODE(PUT_RGB_MATRIX)
+#    else
+#        define SPLIT_ENCODE_RGB_MATRIX 0
+#    endif
+
+// Master-to-slave transactions that are sent delta-encoded whenever that is smaller than the payload itself.
+// Keyboards can pick their own set, e.g. `#define SPLIT_TRANSPORT_ENCODED_IDS (SPLIT_ENCODE(PUT_RGB_MATRIX) | SPLIT_ENCODE(PUT_LAYER_STATE))`
+#    ifndef SPLIT_TRANSPORT_ENCODED_IDS
+#        define SPLIT_TRANSPORT_ENCODED_IDS (SPLIT_ENCODE_MASTER_MATRIX | SPLIT_ENCODE_RGBLIGHT | SPLIT_ENCODE_LED_MATRIX | SPLIT_ENCODE_RGB_MATRIX)
+#    endif // SPLIT_TRANSPORT_ENCODED_IDS
+
+#    define split_transaction_is_encoded(id) (((SPLIT_TRANSPORT_ENCODED_IDS) >> (id)) & 1)
+#endif // defined(SPLIT_TRANSPORT_ENCODING)
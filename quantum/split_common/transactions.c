@@ -28,6 +28,8 @@
 #include "transactions.h"
 #include "transport.h"
 #include "transaction_id_define.h"
+#include "transaction_codec.h"
+#include "split_link.h"
 #include "split_util.h"
 #include "synchronization_util.h"
 
@@ -81,9 +83,28 @@
 
 #define trans_initiator2target_cb(cb) {0, 0, 0, 0, cb}
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#ifdef SPLIT_LINK_STATS_ENABLE
+static bool split_link_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    uint32_t start = split_link_stats_timestamp();
+    bool     okay  = transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+    split_link_stats_record(id, okay ? SPLIT_LINK_OK : SPLIT_LINK_TIMEOUT, split_link_stats_timestamp() - start);
+    return okay;
+}
+#    define split_link_crc_error(id) split_link_stats_record(id, SPLIT_LINK_CRC_ERROR, 0)
+#else // SPLIT_LINK_STATS_ENABLE
+#    define split_link_execute_transaction transport_execute_transaction
+#    define split_link_crc_error(id)
+#endif // SPLIT_LINK_STATS_ENABLE
+
+#ifdef SPLIT_TRANSPORT_BATCHING
+#    define transport_transaction split_batch_execute_transaction
+#else // SPLIT_TRANSPORT_BATCHING
+#    define transport_transaction split_link_execute_transaction
+#endif // SPLIT_TRANSPORT_BATCHING
+
+#define transport_write(id, data, length) transport_transaction(id, data, length, NULL, 0)
+#define transport_read(id, data, length) transport_transaction(id, NULL, 0, data, length)
+#define transport_exec(id) transport_transaction(id, NULL, 0, NULL, 0)
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -91,20 +112,463 @@ void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *i
 void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+////////////////////////////////////////////////////
+// Batched frames
+
+#ifdef SPLIT_TRANSPORT_BATCHING
+
+/* While transactions_master() runs, transactions are appended to a single
+ * frame instead of each being a separate round-trip. The frame is exchanged
+ * when a handler needs data back from the slave, when it would overflow, and
+ * at the end of the sync cycle.
+ *
+ * master -> slave: [crc8] { [transaction id] [initiator2target payload] } ...
+ * slave -> master: [crc8 ^ frame crc8] [target2initiator payload of the read]
+ *
+ * Payload sizes come from split_transaction_table, which both halves share.
+ * Frame lengths are announced with PUT_BATCH_INFO, in the same way as RPC
+ * lengths, but only when they differ from the previous frame. A lone
+ * transaction is sent as-is, so idle cycles cost the same as without batching.
+ */
+
+// Forward-declare the batch callback handlers
+void slave_batch_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+void slave_batch_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+
+STATIC_ASSERT(SPLIT_BATCH_M2S_BUFFER_SIZE >= 2 && SPLIT_BATCH_M2S_BUFFER_SIZE <= UINT8_MAX, "SPLIT_BATCH_M2S_BUFFER_SIZE out of range");
+STATIC_ASSERT(SPLIT_BATCH_S2M_BUFFER_SIZE >= 2 && SPLIT_BATCH_S2M_BUFFER_SIZE <= UINT8_MAX, "SPLIT_BATCH_S2M_BUFFER_SIZE out of range");
+
+static struct {
+    bool    active;
+    uint8_t entries;
+    int8_t  first_id;
+    uint8_t m2s_length;
+    uint8_t s2m_length;
+    int8_t  read_id;
+    void   *read_buffer;
+    uint8_t read_length;
+    uint8_t  announced_m2s_length;
+    uint8_t  announced_s2m_length;
+    uint32_t queued; // transactions written in this frame
+    uint8_t  m2s_buffer[SPLIT_BATCH_M2S_BUFFER_SIZE];
+} split_batch;
+
+// Writes whose frame has not been delivered yet. The local copy of their shared
+// memory already holds the new data, so they are sent again in full on the next
+// cycle rather than waiting for the forced sync.
+static uint32_t split_batch_unconfirmed = 0;
+
+static void split_batch_begin(void) {
+    split_batch.active     = true;
+    split_batch.entries    = 0;
+    split_batch.m2s_length = 1;
+    split_batch.s2m_length = 1;
+    split_batch.read_id    = -1;
+    split_batch.queued     = 0;
+}
+
+static void split_batch_delivered(void) {
+    split_batch_unconfirmed &= ~split_batch.queued;
+    split_batch_begin();
+}
+
+static void split_batch_end(void) {
+    split_batch.active = false;
+}
+
+#    ifdef SPLIT_TRANSPORT_ENCODING
+// Encoded payloads carry their own length in the first byte instead of announcing it up front
+#        define split_batch_is_variable_length(id) ((id) == PUT_ENCODED_DATA)
+#        define split_batch_is_valid_length(length) ((length) >= SPLIT_ENCODING_HEADER_SIZE && (length) <= SPLIT_TRANSPORT_ENCODING_BUFFER_SIZE)
+#    else
+#        define split_batch_is_variable_length(id) false
+#        define split_batch_is_valid_length(length) false
+#    endif
+
+static bool split_batch_flush(void) {
+    if (split_batch.entries == 0) {
+        return true;
+    }
+
+    // A frame of one is no better than the plain transaction
+    if (split_batch.entries == 1 && !split_batch_is_variable_length(split_batch.first_id)) {
+        split_transaction_desc_t *trans = &split_transaction_table[split_batch.first_id];
+        bool                      okay  = split_link_execute_transaction(split_batch.first_id, &split_batch.m2s_buffer[2], trans->initiator2target_buffer_size, split_batch.read_buffer, split_batch.read_id >= 0 ? split_batch.read_length : 0);
+        if (okay) {
+            split_batch_delivered();
+        }
+        return okay;
+    }
+
+    uint8_t m2s_length = split_batch.m2s_length;
+    uint8_t s2m_length = split_batch.s2m_length;
+    uint8_t response[SPLIT_BATCH_S2M_BUFFER_SIZE];
+
+    split_batch.m2s_buffer[0] = crc8(&split_batch.m2s_buffer[1], m2s_length - 1);
+
+    if (m2s_length != split_batch.announced_m2s_length || s2m_length != split_batch.announced_s2m_length) {
+        split_batch_info_t info = {.payload = {.m2s_length = m2s_length, .s2m_length = s2m_length}};
+        info.checksum           = crc8(&info.payload, sizeof(info.payload));
+
+        // Make sure the local side knows how much of the frame buffers to send and receive
+        split_transaction_table[EXECUTE_BATCH].initiator2target_buffer_size = m2s_length;
+        split_transaction_table[EXECUTE_BATCH].target2initiator_buffer_size = s2m_length;
+
+        if (!split_link_execute_transaction(PUT_BATCH_INFO, &info, sizeof(info), NULL, 0)) {
+            split_batch.announced_m2s_length = 0;
+            return false;
+        }
+        split_batch.announced_m2s_length = m2s_length;
+        split_batch.announced_s2m_length = s2m_length;
+    }
+
+    bool okay = split_link_execute_transaction(EXECUTE_BATCH, split_batch.m2s_buffer, m2s_length, response, s2m_length);
+    if (okay && response[0] != (crc8(&response[1], s2m_length - 1) ^ split_batch.m2s_buffer[0])) {
+        split_link_crc_error(EXECUTE_BATCH);
+        okay = false;
+    }
+    if (!okay) {
+        // The slave may have missed the lengths or rejected the frame, announce them again on retry
+        split_batch.announced_m2s_length = 0;
+        return false;
+    }
+
+    if (split_batch.read_id >= 0) {
+        split_transaction_desc_t *trans = &split_transaction_table[split_batch.read_id];
+        memcpy(split_trans_target2initiator_buffer(trans), &response[1], trans->target2initiator_buffer_size);
+        memcpy(split_batch.read_buffer, &response[1], split_batch.read_length);
+    }
+
+    split_batch_delivered();
+    return true;
+}
+
+static void split_batch_mark_queued(int8_t id) {
+    split_batch.queued |= 1UL << id;
+    split_batch_unconfirmed |= 1UL << id;
+}
+
+static bool split_batch_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    if (!split_batch.active) {
+        if (!split_link_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length)) {
+            return false;
+        }
+        split_batch_unconfirmed &= ~(1UL << id);
+        return true;
+    }
+
+    split_transaction_desc_t *trans    = &split_transaction_table[id];
+    uint8_t                   m2s_size = trans->initiator2target_buffer_size;
+    uint8_t                   s2m_size = trans->target2initiator_buffer_size;
+
+    // Anything too large for a frame is sent on its own, after whatever was queued before it
+    if (1 + 1 + m2s_size > SPLIT_BATCH_M2S_BUFFER_SIZE || 1 + s2m_size > SPLIT_BATCH_S2M_BUFFER_SIZE) {
+        if (!split_batch_flush() || !split_link_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length)) {
+            return false;
+        }
+        split_batch_unconfirmed &= ~(1UL << id);
+        return true;
+    }
+
+    if (split_batch.m2s_length + 1 + m2s_size > SPLIT_BATCH_M2S_BUFFER_SIZE && !split_batch_flush()) {
+        return false;
+    }
+
+    // Keep the local copy of the shared memory in step, as transport_execute_transaction() does
+    if (initiator2target_length > 0) {
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, m2s_size < initiator2target_length ? m2s_size : initiator2target_length);
+        split_batch_mark_queued(id);
+    }
+
+    uint8_t queued_length = split_batch.m2s_length;
+    if (split_batch.entries++ == 0) {
+        split_batch.first_id = id;
+    }
+    split_batch.m2s_buffer[split_batch.m2s_length++] = id;
+    memcpy(&split_batch.m2s_buffer[split_batch.m2s_length], split_trans_initiator2target_buffer(trans), m2s_size);
+    split_batch.m2s_length += m2s_size;
+
+    if (s2m_size == 0) {
+        return true;
+    }
+
+    // The caller needs the data now, so send everything queued so far along with this read
+    split_batch.read_id     = id;
+    split_batch.read_buffer = target2initiator_buf;
+    split_batch.read_length = s2m_size < target2initiator_length ? s2m_size : target2initiator_length;
+    split_batch.s2m_length  = 1 + s2m_size;
+    if (split_batch_flush()) {
+        return true;
+    }
+
+    // Drop the read so that a retry doesn't queue it twice, but keep the writes queued before it
+    split_batch.entries--;
+    split_batch.m2s_length = queued_length;
+    split_batch.s2m_length = 1;
+    split_batch.read_id    = -1;
+    return false;
+}
+
+static bool slave_batch_process(const uint8_t *frame, uint8_t m2s_length, uint8_t *response, uint8_t s2m_length, bool apply) {
+    uint8_t in  = 1;
+    uint8_t out = 1;
+    while (in < m2s_length) {
+        uint8_t id = frame[in++];
+        if (id >= NUM_TOTAL_TRANSACTIONS || id == PUT_BATCH_INFO || id == EXECUTE_BATCH) {
+            return false;
+        }
+
+        split_transaction_desc_t *trans    = &split_transaction_table[id];
+        uint8_t                   m2s_size = trans->initiator2target_buffer_size;
+        if (split_batch_is_variable_length(id)) {
+            // The length comes from the frame itself, so make sure it fits the buffer it is copied into
+            m2s_size = in < m2s_length ? frame[in] : 0;
+            if (!split_batch_is_valid_length(m2s_size)) {
+                return false;
+            }
+        }
+        if (in + m2s_size > m2s_length || out + trans->target2initiator_buffer_size > s2m_length) {
+            return false;
+        }
+
+        if (apply) {
+            memcpy(split_trans_initiator2target_buffer(trans), &frame[in], m2s_size);
+            if (trans->slave_callback) {
+                trans->slave_callback(m2s_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+            }
+            memcpy(&response[out], split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+        }
+        in += m2s_size;
+        out += trans->target2initiator_buffer_size;
+    }
+    return out == s2m_length;
+}
+
+void slave_batch_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // As with RPC, the frame lengths have to be known before the frame itself arrives.
+    split_batch_info_t *info = &split_shmem->batch_info;
+    if (crc8(&info->payload, sizeof(info->payload)) != info->checksum) {
+        return;
+    }
+    if (info->payload.m2s_length < 1 || info->payload.m2s_length > SPLIT_BATCH_M2S_BUFFER_SIZE || info->payload.s2m_length < 1 || info->payload.s2m_length > SPLIT_BATCH_S2M_BUFFER_SIZE) {
+        return;
+    }
+
+    split_transaction_table[EXECUTE_BATCH].initiator2target_buffer_size = info->payload.m2s_length;
+    split_transaction_table[EXECUTE_BATCH].target2initiator_buffer_size = info->payload.s2m_length;
+}
+
+void slave_batch_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const uint8_t *frame      = split_shmem->batch_m2s_buffer;
+    uint8_t       *response   = split_shmem->batch_s2m_buffer;
+    uint8_t        m2s_length = split_transaction_table[EXECUTE_BATCH].initiator2target_buffer_size;
+    uint8_t        s2m_length = split_transaction_table[EXECUTE_BATCH].target2initiator_buffer_size;
+
+    if (m2s_length < 1 || s2m_length < 1) {
+        return;
+    }
+
+    // Check the whole frame before applying any of it
+    bool okay = frame[0] == crc8(&frame[1], m2s_length - 1) && slave_batch_process(frame, m2s_length, response, s2m_length, false);
+    if (okay) {
+        slave_batch_process(frame, m2s_length, response, s2m_length, true);
+    }
+
+    response[0] = crc8(&response[1], s2m_length - 1) ^ frame[0];
+    if (!okay) {
+        response[0] = ~response[0];
+    }
+}
+
+static bool split_batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    return split_batch_flush();
+}
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_MASTER() TRANSACTION_HANDLER_MASTER(split_batch)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [PUT_BATCH_INFO] = trans_initiator2target_initializer_cb(batch_info, slave_batch_info_callback), \
+    [EXECUTE_BATCH]  = {SPLIT_BATCH_M2S_BUFFER_SIZE, offsetof(split_shared_memory_t, batch_m2s_buffer), SPLIT_BATCH_S2M_BUFFER_SIZE, offsetof(split_shared_memory_t, batch_s2m_buffer), slave_batch_exec_callback},
+// clang-format on
+
+#    define transport_unconfirmed(id) ((split_batch_unconfirmed & (1UL << (id))) != 0)
+
+#else // SPLIT_TRANSPORT_BATCHING
+
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+#    define transport_unconfirmed(id) false
+
+#endif // SPLIT_TRANSPORT_BATCHING
+
+////////////////////////////////////////////////////
+// Encoded payloads
+
+#ifdef SPLIT_TRANSPORT_ENCODING
+
+/* Master-to-slave transactions selected with SPLIT_TRANSPORT_ENCODED_IDS are
+ * sent as a delta against the copy the slave already holds, whenever that is
+ * smaller than the payload itself:
+ *
+ * [length] [transaction id] [crc8 of the decoded payload] [encoded delta]
+ *
+ * Outside of a batch the length is announced with PUT_ENCODED_INFO when it
+ * differs from the previous one. The slave checks the result against the
+ * checksum and undoes the delta when it does not match. Forced syncs and
+ * retries after a failure always send the raw payload, which resynchronises
+ * both copies.
+ */
+
+// Forward-declare the encoding callback handlers
+void slave_encoding_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+void slave_encoding_data_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+
+STATIC_ASSERT(SPLIT_TRANSPORT_ENCODING_BUFFER_SIZE >= 4 && SPLIT_TRANSPORT_ENCODING_BUFFER_SIZE <= UINT8_MAX, "SPLIT_TRANSPORT_ENCODING_BUFFER_SIZE out of range");
+
+static uint8_t                          split_encoding_announced_length = 0;
+static uint32_t                         split_encoding_desynced         = 0; // transactions whose slave copy may differ from ours
+static split_transport_encoding_stats_t split_encoding_stats;
+
+static bool split_encoding_write(int8_t id, const void *data, uint8_t length) {
+    split_transaction_desc_t        *trans = &split_transaction_table[id];
+    uint8_t                         *copy  = split_trans_initiator2target_buffer(trans);
+    const split_transaction_codec_t *codec = split_transport_encoding_codec();
+    uint8_t                          buffer[SPLIT_TRANSPORT_ENCODING_BUFFER_SIZE];
+    uint8_t                          encoded_length;
+
+    // A write still waiting for its batch to be delivered may not have reached the slave's copy
+    bool encode = split_transaction_is_encoded(id) && !(split_encoding_desynced & (1UL << id)) && !transport_unconfirmed(id) && length == trans->initiator2target_buffer_size;
+    encode      = encode && codec->encode(copy, data, length, &buffer[SPLIT_ENCODING_HEADER_SIZE], sizeof(buffer) - SPLIT_ENCODING_HEADER_SIZE, &encoded_length);
+
+    uint8_t total    = SPLIT_ENCODING_HEADER_SIZE + encoded_length;
+    bool    announce = total != split_encoding_announced_length;
+#    ifdef SPLIT_TRANSPORT_BATCHING
+    announce = announce && !split_batch.active;
+#    endif // SPLIT_TRANSPORT_BATCHING
+    uint8_t cost = total + (announce ? sizeof(split_encoding_info_t) : 0);
+
+    if (!encode || cost >= length) {
+        if (!transport_write(id, data, length)) {
+            split_encoding_desynced |= 1UL << id;
+            return false;
+        }
+        split_encoding_desynced &= ~(1UL << id);
+        split_encoding_stats.raw++;
+        return true;
+    }
+
+    buffer[0] = total;
+    buffer[1] = id;
+    buffer[2] = crc8(data, length);
+
+    // Make sure the local side knows how much of the buffer to send
+    split_transaction_table[PUT_ENCODED_DATA].initiator2target_buffer_size = total;
+
+    if (announce) {
+        split_encoding_info_t info = {.payload = {.length = total}};
+        info.checksum              = crc8(&info.payload, sizeof(info.payload));
+        if (!transport_write(PUT_ENCODED_INFO, &info, sizeof(info))) {
+            split_encoding_announced_length = 0;
+            return false;
+        }
+        split_encoding_announced_length = total;
+    }
+
+    if (!transport_write(PUT_ENCODED_DATA, buffer, total)) {
+        // Whether or not the slave applied it is unknown, the next attempt goes out raw
+        split_encoding_announced_length = 0;
+        split_encoding_desynced |= 1UL << id;
+        return false;
+    }
+
+#    ifdef SPLIT_TRANSPORT_BATCHING
+    if (split_batch.active) {
+        // Only queued so far, the frame carries it as PUT_ENCODED_DATA
+        split_batch_mark_queued(id);
+    }
+#    endif // SPLIT_TRANSPORT_BATCHING
+    memcpy(copy, data, length);
+    split_encoding_stats.encoded++;
+    split_encoding_stats.bytes_saved += length - cost;
+    return true;
+}
+
+void slave_encoding_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // As with RPC, the payload length has to be known before the payload itself arrives.
+    split_encoding_info_t *info = &split_shmem->encoding_info;
+    if (crc8(&info->payload, sizeof(info->payload)) != info->checksum) {
+        return;
+    }
+    if (info->payload.length < SPLIT_ENCODING_HEADER_SIZE || info->payload.length > SPLIT_TRANSPORT_ENCODING_BUFFER_SIZE) {
+        return;
+    }
+
+    split_transaction_table[PUT_ENCODED_DATA].initiator2target_buffer_size = info->payload.length;
+}
+
+void slave_encoding_data_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const uint8_t *payload = split_shmem->encoding_buffer;
+    uint8_t        length  = payload[0];
+    int8_t         id      = payload[1];
+
+    if (length != initiator2target_buffer_size || length < SPLIT_ENCODING_HEADER_SIZE || id < 0 || id >= NUM_TOTAL_TRANSACTIONS || !split_transaction_is_encoded(id)) {
+        return;
+    }
+
+    split_transaction_desc_t        *trans = &split_transaction_table[id];
+    uint8_t                         *data  = split_trans_initiator2target_buffer(trans);
+    uint8_t                          size  = trans->initiator2target_buffer_size;
+    const split_transaction_codec_t *codec = split_transport_encoding_codec();
+
+    if (!codec->decode(data, size, &payload[SPLIT_ENCODING_HEADER_SIZE], length - SPLIT_ENCODING_HEADER_SIZE, false)) {
+        return;
+    }
+    codec->decode(data, size, &payload[SPLIT_ENCODING_HEADER_SIZE], length - SPLIT_ENCODING_HEADER_SIZE, true);
+    if (crc8(data, size) != payload[2]) {
+        // Our copy was not the one the master encoded against; decoding again puts it back
+        codec->decode(data, size, &payload[SPLIT_ENCODING_HEADER_SIZE], length - SPLIT_ENCODING_HEADER_SIZE, true);
+        return;
+    }
+
+    if (trans->slave_callback) {
+        trans->slave_callback(size, data, trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+    }
+}
+
+split_transport_encoding_stats_t transactions_encoding_get_stats(void) {
+    return split_encoding_stats;
+}
+
+// clang-format off
+#    define TRANSACTIONS_ENCODING_REGISTRATIONS \
+    [PUT_ENCODED_INFO] = trans_initiator2target_initializer_cb(encoding_info, slave_encoding_info_callback), \
+    [PUT_ENCODED_DATA] = trans_initiator2target_initializer_cb(encoding_buffer, slave_encoding_data_callback),
+// clang-format on
+
+#    define transport_write_encoded(id, data, length) split_encoding_write(id, data, length)
+
+#else // SPLIT_TRANSPORT_ENCODING
+
+#    define TRANSACTIONS_ENCODING_REGISTRATIONS
+#    define transport_write_encoded(id, data, length) transport_write(id, data, length)
+
+#endif // SPLIT_TRANSPORT_ENCODING
+
 ////////////////////////////////////////////////////
 // Helpers
 
 static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])) {
-    int num_retries = is_transport_connected() ? 10 : 1;
-    for (int iter = 1; iter <= num_retries; ++iter) {
-        if (iter > 1) {
-            for (int i = 0; i < iter * iter; ++i) {
+    uint8_t num_retries = is_transport_connected() ? split_link_retries() : 0;
+    for (uint8_t iter = 0; iter <= num_retries; ++iter) {
+#ifndef SPLIT_LINK_ADAPTIVE_RETRY
+        // Give the link a growing amount of time to recover before each retry
+        if (iter > 0) {
+            for (int i = 0; i < (iter + 1) * (iter + 1); ++i) {
                 wait_us(10);
             }
         }
-        bool this_okay = true;
-        this_okay      = handler(master_matrix, slave_matrix);
-        if (this_okay) return true;
+#endif // SPLIT_LINK_ADAPTIVE_RETRY
+        if (handler(master_matrix, slave_matrix)) return true;
     }
     dprintf("Failed to execute %s\n", prefix);
     return false;
@@ -146,7 +610,10 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
     if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
         okay &= transport_read(trans_id_retrieve, destination, length);
-        okay &= curr_checksum == crc8(equiv_shmem, length);
+        if (okay && curr_checksum != crc8(equiv_shmem, length)) {
+            split_link_crc_error(trans_id_retrieve);
+            okay = false;
+        }
         if (okay) {
             *last_update = timer_read32();
         }
@@ -157,9 +624,11 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
 }
 
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
-    bool okay = true;
-    if (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || condition) {
-        okay &= transport_write(trans_id, source, length);
+    bool okay   = true;
+    bool forced = timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || transport_unconfirmed(trans_id);
+    if (forced || condition) {
+        // Forced syncs always go out in full, so the slave's copy can't drift for long
+        okay &= forced ? transport_write(trans_id, source, length) : transport_write_encoded(trans_id, source, length);
         if (okay) {
             *last_update = timer_read32();
         }
@@ -175,6 +644,171 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_MATRIX_EVENTS
+
+STATIC_ASSERT(SPLIT_MATRIX_EVENTS_SIZE <= 128 && (SPLIT_MATRIX_EVENTS_SIZE & (SPLIT_MATRIX_EVENTS_SIZE - 1)) == 0, "SPLIT_MATRIX_EVENTS_SIZE must be a power of two no larger than 128");
+STATIC_ASSERT(SPLIT_MATRIX_EVENTS_WINDOW >= 1 && SPLIT_MATRIX_EVENTS_WINDOW <= SPLIT_MATRIX_EVENTS_SIZE, "SPLIT_MATRIX_EVENTS_WINDOW must be between 1 and SPLIT_MATRIX_EVENTS_SIZE");
+#    ifdef SPLIT_TRANSPORT_BATCHING
+STATIC_ASSERT(1 + sizeof_member(split_shared_memory_t, smatrix_events.window) <= SPLIT_BATCH_S2M_BUFFER_SIZE, "SPLIT_MATRIX_EVENTS_WINDOW is too large to fit in SPLIT_BATCH_S2M_BUFFER_SIZE");
+#    endif // SPLIT_TRANSPORT_BATCHING
+
+#    define split_matrix_events_window_checksum(window) crc8(&(window)->seq, sizeof(*(window)) - offsetof(__typeof__(*(window)), seq))
+
+// Forward-declare the events window callback handler
+void slave_matrix_events_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+
+// Events recorded by the slave, event n lives at n % SPLIT_MATRIX_EVENTS_SIZE
+static struct {
+    uint8_t              seq; // number of events recorded, wrapping
+    split_matrix_event_t events[SPLIT_MATRIX_EVENTS_SIZE];
+} split_slave_matrix_event_ring;
+
+// Slave events that have been received by the master but not yet consumed by the matrix task
+static struct {
+    uint8_t              head;
+    uint8_t              tail;
+    split_matrix_event_t events[SPLIT_MATRIX_EVENTS_SIZE];
+} split_matrix_event_queue;
+
+static void split_matrix_event_enqueue(split_matrix_event_t event) {
+    if ((uint8_t)(split_matrix_event_queue.head - split_matrix_event_queue.tail) >= SPLIT_MATRIX_EVENTS_SIZE) {
+        // Nobody is draining the queue; the matrix diff still picks the change up, just without its timestamp
+        return;
+    }
+#    ifdef DISABLE_SYNC_TIMER
+    // Without a shared timebase the slave's timestamps mean nothing to the master
+    event.time = timer_read();
+#    endif // DISABLE_SYNC_TIMER
+    split_matrix_event_queue.events[split_matrix_event_queue.head++ % SPLIT_MATRIX_EVENTS_SIZE] = event;
+}
+
+bool transactions_slave_matrix_event_peek(keyevent_t *event) {
+    if (split_matrix_event_queue.head == split_matrix_event_queue.tail) {
+        return false;
+    }
+    const split_matrix_event_t *queued = &split_matrix_event_queue.events[split_matrix_event_queue.tail % SPLIT_MATRIX_EVENTS_SIZE];
+    *event                             = (keyevent_t){.key = MAKE_KEYPOS(queued->row, queued->col), .pressed = queued->pressed, .time = queued->time, .type = KEY_EVENT};
+    return true;
+}
+
+void transactions_slave_matrix_event_drop(void) {
+    if (split_matrix_event_queue.head != split_matrix_event_queue.tail) {
+        split_matrix_event_queue.tail++;
+    }
+}
+
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t     last_update                    = 0;
+    static bool         synced                         = false;
+    static uint8_t      last_seq                       = 0;
+    static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last known-good matrix, events are applied on top of it
+    matrix_row_t        temp_matrix[(MATRIX_ROWS) / 2];
+
+    __typeof__(split_shmem->smatrix_events.head) head = {0};
+    bool okay   = transport_read(GET_SLAVE_MATRIX_EVENTS_HEAD, &head, sizeof(head));
+    bool resync = !synced || timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS;
+
+    const uint8_t pending = head.seq - last_seq;
+    if (okay && !resync && pending > 0) {
+        // Only the events not seen yet are fetched, a window at a time, so the transfer stays small enough to batch
+        split_matrix_event_t events[SPLIT_MATRIX_EVENTS_SIZE];
+        uint8_t              fetched = 0;
+        resync                       = pending > SPLIT_MATRIX_EVENTS_SIZE;
+        memcpy(temp_matrix, last_matrix, sizeof(temp_matrix));
+        while (okay && !resync && fetched < pending) {
+            uint8_t first = last_seq + fetched;
+            __typeof__(split_shmem->smatrix_events.window) window;
+            okay = transport_transaction(GET_SLAVE_MATRIX_EVENTS_DATA, &first, sizeof(first), &window, sizeof(window));
+            if (okay && window.checksum != split_matrix_events_window_checksum(&window)) {
+                split_link_crc_error(GET_SLAVE_MATRIX_EVENTS_DATA);
+            }
+            // The slave may have moved on since the head was read; only the events up to the head are replayed,
+            // so they just need to not have been overwritten yet
+            resync = !okay || window.checksum != split_matrix_events_window_checksum(&window) || window.seq != first || window.count == 0 || window.count > SPLIT_MATRIX_EVENTS_WINDOW;
+            for (uint8_t i = 0; !resync && i < window.count && fetched < pending; i++) {
+                const split_matrix_event_t *event = &window.events[i];
+                temp_matrix[event->row] ^= MATRIX_ROW_SHIFTER << event->col;
+                events[fetched++] = *event;
+            }
+        }
+        // Replaying the events has to land exactly on the slave's matrix, anything else means events were lost
+        resync = resync || crc8(temp_matrix, sizeof(temp_matrix)) != head.checksum;
+        if (!resync) {
+            for (uint8_t i = 0; i < fetched; i++) {
+                split_matrix_event_enqueue(events[i]);
+            }
+            memcpy(last_matrix, temp_matrix, sizeof(temp_matrix));
+            last_seq = head.seq;
+        }
+    } else if (okay && head.checksum != crc8(last_matrix, sizeof(last_matrix))) {
+        resync = true;
+    }
+
+    if (okay && resync) {
+        // Full snapshot; whatever happened in between is left to the matrix diff
+        okay &= transport_read(GET_SLAVE_MATRIX_DATA, temp_matrix, sizeof(temp_matrix));
+        if (okay && head.checksum != crc8(temp_matrix, sizeof(temp_matrix))) {
+            split_link_crc_error(GET_SLAVE_MATRIX_DATA);
+            okay = false;
+        }
+        if (okay) {
+            memcpy(last_matrix, temp_matrix, sizeof(temp_matrix));
+            last_seq    = head.seq;
+            last_update = timer_read32();
+            synced      = true;
+        }
+    }
+
+    // Copy out the last-known-good matrix state to the slave matrix
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_slave_matrix_events_t *events = &split_shmem->smatrix_events;
+    const uint16_t               now    = sync_timer_read();
+
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; row++) {
+        const matrix_row_t row_changes = split_shmem->smatrix.matrix[row] ^ slave_matrix[row];
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (row_changes & (MATRIX_ROW_SHIFTER << col)) {
+                split_slave_matrix_event_ring.events[split_slave_matrix_event_ring.seq++ % SPLIT_MATRIX_EVENTS_SIZE] = (split_matrix_event_t){
+                    .time    = now,
+                    .row     = row,
+                    .col     = col,
+                    .pressed = (slave_matrix[row] >> col) & 1,
+                };
+            }
+        }
+    }
+
+    memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
+    split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+
+    events->head.seq      = split_slave_matrix_event_ring.seq;
+    events->head.checksum = split_shmem->smatrix.checksum;
+}
+
+void slave_matrix_events_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    split_slave_matrix_events_t *events    = &split_shmem->smatrix_events;
+    const uint8_t                available = split_slave_matrix_event_ring.seq - events->first;
+
+    events->window.seq   = events->first;
+    events->window.count = available > SPLIT_MATRIX_EVENTS_SIZE ? 0 : (available < SPLIT_MATRIX_EVENTS_WINDOW ? available : SPLIT_MATRIX_EVENTS_WINDOW);
+    for (uint8_t i = 0; i < events->window.count; i++) {
+        events->window.events[i] = split_slave_matrix_event_ring.events[(uint8_t)(events->first + i) % SPLIT_MATRIX_EVENTS_SIZE];
+    }
+    events->window.checksum = split_matrix_events_window_checksum(&events->window);
+}
+
+// clang-format off
+#    define TRANSACTIONS_SLAVE_MATRIX_EVENTS_REGISTRATIONS \
+    [GET_SLAVE_MATRIX_EVENTS_HEAD] = trans_target2initiator_initializer(smatrix_events.head), \
+    [GET_SLAVE_MATRIX_EVENTS_DATA] = {sizeof_member(split_shared_memory_t, smatrix_events.first), offsetof(split_shared_memory_t, smatrix_events.first), sizeof_member(split_shared_memory_t, smatrix_events.window), offsetof(split_shared_memory_t, smatrix_events.window), slave_matrix_events_callback},
+// clang-format on
+
+#else // SPLIT_MATRIX_EVENTS
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -195,12 +829,17 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
     split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
 }
 
+#    define TRANSACTIONS_SLAVE_MATRIX_EVENTS_REGISTRATIONS
+
+#endif // SPLIT_MATRIX_EVENTS
+
 // clang-format off
 #define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
-    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
+    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix), \
+    TRANSACTIONS_SLAVE_MATRIX_EVENTS_REGISTRATIONS
 // clang-format on
 
 ////////////////////////////////////////////////////
@@ -297,7 +936,7 @@ static bool sync_timer_handlers_master(matrix_row_t master_matrix[], matrix_row_
     static uint32_t last_update = 0;
 
     bool okay = true;
-    if (timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS) {
+    if (timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS || transport_unconfirmed(PUT_SYNC_TIMER)) {
         uint32_t sync_timer = sync_timer_read32() + SYNC_TIMER_OFFSET;
         okay &= transport_write(PUT_SYNC_TIMER, &sync_timer, sizeof(sync_timer));
         if (okay) {
@@ -399,7 +1038,7 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t   last_update    = 0;
-    bool              mods_need_sync = timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS;
+    bool              mods_need_sync = timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS || transport_unconfirmed(PUT_MODS);
     split_mods_sync_t new_mods;
     new_mods.real_mods = get_mods();
     if (!mods_need_sync && new_mods.real_mods != split_shmem->mods.real_mods) {
@@ -702,6 +1341,43 @@ static void st7565_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
 
 #if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
+#    ifdef SPLIT_POINTING_FUSION
+static uint32_t pointing_last_update = 0;
+
+// The other half boots into session 0, so seeing it there again means it restarted and its totals started over
+static uint8_t pointing_session = 1;
+
+static bool pointing_read_motion(void) {
+    pointing_device_motion_t temp_motion;
+    bool                     okay = read_if_checksum_mismatch(GET_POINTING_CHECKSUM, GET_POINTING_DATA, &pointing_last_update, &temp_motion, &split_shmem->pointing.motion, sizeof(temp_motion));
+    if (okay) {
+        pointing_device_set_shared_motion(&temp_motion);
+        if (temp_motion.session != pointing_session) {
+            okay = transport_write(PUT_POINTING_SESSION, &pointing_session, sizeof(pointing_session));
+        }
+    }
+    return okay;
+}
+
+#        ifdef SPLIT_POINTING_STREAM
+bool transactions_pointing_fetch(void) {
+#            if defined(POINTING_DEVICE_LEFT)
+    if (is_keyboard_left()) {
+        return true;
+    }
+#            elif defined(POINTING_DEVICE_RIGHT)
+    if (!is_keyboard_left()) {
+        return true;
+    }
+#            endif
+    if (!is_transport_connected()) {
+        return false;
+    }
+    return pointing_read_motion();
+}
+#        endif // SPLIT_POINTING_STREAM
+#    endif     // SPLIT_POINTING_FUSION
+
 static bool pointing_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
 #    if defined(POINTING_DEVICE_LEFT)
     if (is_keyboard_left()) {
@@ -712,13 +1388,17 @@ static bool pointing_handlers_master(matrix_row_t master_matrix[], matrix_row_t
         return true;
     }
 #    endif
-    static uint32_t last_update     = 0;
     static uint32_t last_cpi_update = 0;
     static uint16_t last_cpi        = 0;
-    report_mouse_t  temp_state;
     uint16_t        temp_cpi;
+#    ifdef SPLIT_POINTING_FUSION
+    bool okay = pointing_read_motion();
+#    else
+    static uint32_t last_update = 0;
+    report_mouse_t  temp_state;
     bool            okay = read_if_checksum_mismatch(GET_POINTING_CHECKSUM, GET_POINTING_DATA, &last_update, &temp_state, &split_shmem->pointing.report, sizeof(temp_state));
     if (okay) pointing_device_set_shared_report(temp_state);
+#    endif
     temp_cpi = pointing_device_get_shared_cpi();
     if (temp_cpi) {
         split_shmem->pointing.cpi = temp_cpi;
@@ -742,7 +1422,8 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
         return;
     }
 #    endif
-#    if (POINTING_DEVICE_TASK_THROTTLE_MS > 0)
+    // When streaming, the sensor is read on every scan; the running totals mean the master can read them at any rate
+#    if (POINTING_DEVICE_TASK_THROTTLE_MS > 0) && !defined(SPLIT_POINTING_STREAM)
     static uint32_t last_exec = 0;
     if (timer_elapsed32(last_exec) < POINTING_DEVICE_TASK_THROTTLE_MS) {
         return;
@@ -761,9 +1442,23 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
         pointing_device_driver->set_cpi(pointing.cpi);
     }
 
+#    ifdef SPLIT_POINTING_FUSION
+    report_mouse_t report = pointing_device_driver->get_report((report_mouse_t){0});
+    if (report.x || report.y || report.h || report.v) {
+        pointing.motion.time = sync_timer_read();
+        pointing.motion.x += report.x;
+        pointing.motion.y += report.y;
+        pointing.motion.h += report.h;
+        pointing.motion.v += report.v;
+    }
+    pointing.motion.buttons = report.buttons;
+    pointing.motion.session = pointing.session;
+    pointing.checksum       = crc8(&pointing.motion, sizeof(pointing.motion));
+#    else
     pointing.report = pointing_device_driver->get_report((report_mouse_t){0});
     // Now update the checksum given that the pointing has been written to
     pointing.checksum = crc8(&pointing.report, sizeof(report_mouse_t));
+#    endif
 
     split_shared_memory_lock();
     memcpy(&split_shmem->pointing, &pointing, sizeof(split_slave_pointing_sync_t));
@@ -772,7 +1467,11 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 
 #    define TRANSACTIONS_POINTING_MASTER() TRANSACTION_HANDLER_MASTER(pointing)
 #    define TRANSACTIONS_POINTING_SLAVE() TRANSACTION_HANDLER_SLAVE(pointing)
-#    define TRANSACTIONS_POINTING_REGISTRATIONS [GET_POINTING_CHECKSUM] = trans_target2initiator_initializer(pointing.checksum), [GET_POINTING_DATA] = trans_target2initiator_initializer(pointing.report), [PUT_POINTING_CPI] = trans_initiator2target_initializer(pointing.cpi),
+#    ifdef SPLIT_POINTING_FUSION
+#        define TRANSACTIONS_POINTING_REGISTRATIONS [GET_POINTING_CHECKSUM] = trans_target2initiator_initializer(pointing.checksum), [GET_POINTING_DATA] = trans_target2initiator_initializer(pointing.motion), [PUT_POINTING_CPI] = trans_initiator2target_initializer(pointing.cpi), [PUT_POINTING_SESSION] = trans_initiator2target_initializer(pointing.session),
+#    else
+#        define TRANSACTIONS_POINTING_REGISTRATIONS [GET_POINTING_CHECKSUM] = trans_target2initiator_initializer(pointing.checksum), [GET_POINTING_DATA] = trans_target2initiator_initializer(pointing.report), [PUT_POINTING_CPI] = trans_initiator2target_initializer(pointing.cpi),
+#    endif
 
 #else // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
@@ -789,7 +1488,7 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 
 static bool watchdog_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     bool okay = true;
-    if (!split_watchdog_check()) {
+    if (!split_watchdog_check() || transport_unconfirmed(PUT_WATCHDOG)) {
         okay = transport_write(PUT_WATCHDOG, &okay, sizeof(okay));
         split_watchdog_update(okay);
     }
@@ -941,6 +1640,8 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_ENCODING_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -951,8 +1652,10 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
-bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static bool transactions_master_handlers(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifndef SPLIT_TRANSPORT_BATCHING
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
+#endif // SPLIT_TRANSPORT_BATCHING
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
     TRANSACTIONS_SYNC_TIMER_MASTER();
@@ -971,9 +1674,30 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+#ifdef SPLIT_TRANSPORT_BATCHING
+    // Reading the slave matrix last sends it in the same frame as every write queued above
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    TRANSACTIONS_BATCH_MASTER();
+#endif // SPLIT_TRANSPORT_BATCHING
     return true;
 }
 
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (!split_link_cycle_begin()) {
+        // Backing off after failures; the caller keeps the last known slave state
+        return false;
+    }
+#ifdef SPLIT_TRANSPORT_BATCHING
+    split_batch_begin();
+    bool okay = transactions_master_handlers(master_matrix, slave_matrix);
+    split_batch_end();
+#else  // SPLIT_TRANSPORT_BATCHING
+    bool okay = transactions_master_handlers(master_matrix, slave_matrix);
+#endif // SPLIT_TRANSPORT_BATCHING
+    split_link_cycle_end(okay);
+    return okay;
+}
+
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
@@ -20,6 +20,7 @@
 #include <stdbool.h>
 
 #include "matrix.h"
+#include "keyboard.h"
 #include "transaction_id_define.h"
 #include "transport.h"
 
@@ -45,6 +46,27 @@ extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
+#ifdef SPLIT_MATRIX_EVENTS
+// master-side queue of slave key events, rows are relative to the slave half
+bool transactions_slave_matrix_event_peek(keyevent_t *event);
+void transactions_slave_matrix_event_drop(void);
+#endif // SPLIT_MATRIX_EVENTS
+
+#ifdef SPLIT_TRANSPORT_ENCODING
+typedef struct split_transport_encoding_stats_t {
+    uint32_t encoded;     // writes sent delta-encoded
+    uint32_t raw;         // writes of encodable transactions that went out in full
+    uint32_t bytes_saved; // payload bytes not sent thanks to encoding, announcements included
+} split_transport_encoding_stats_t;
+
+split_transport_encoding_stats_t transactions_encoding_get_stats(void);
+#endif // SPLIT_TRANSPORT_ENCODING
+
+#ifdef SPLIT_POINTING_STREAM
+// master-side read of the other half's pointing device motion, outside of the sync cycle
+bool transactions_pointing_fetch(void);
+#endif // SPLIT_POINTING_STREAM
+
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
 
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
@@ -31,6 +31,18 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifndef SPLIT_BATCH_M2S_BUFFER_SIZE
+#    define SPLIT_BATCH_M2S_BUFFER_SIZE 64
+#endif // SPLIT_BATCH_M2S_BUFFER_SIZE
+
+#ifndef SPLIT_BATCH_S2M_BUFFER_SIZE
+#    define SPLIT_BATCH_S2M_BUFFER_SIZE 32
+#endif // SPLIT_BATCH_S2M_BUFFER_SIZE
+
+#ifndef SPLIT_TRANSPORT_ENCODING_BUFFER_SIZE
+#    define SPLIT_TRANSPORT_ENCODING_BUFFER_SIZE 32
+#endif // SPLIT_TRANSPORT_ENCODING_BUFFER_SIZE
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -57,6 +69,36 @@ typedef struct _split_slave_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
+#ifdef SPLIT_MATRIX_EVENTS
+#    ifndef SPLIT_MATRIX_EVENTS_SIZE
+#        define SPLIT_MATRIX_EVENTS_SIZE 8
+#    endif // SPLIT_MATRIX_EVENTS_SIZE
+#    ifndef SPLIT_MATRIX_EVENTS_WINDOW
+#        define SPLIT_MATRIX_EVENTS_WINDOW 4
+#    endif // SPLIT_MATRIX_EVENTS_WINDOW
+
+typedef struct _split_matrix_event_t {
+    uint16_t time;
+    uint8_t  row;
+    uint8_t  col : 7;
+    uint8_t  pressed : 1;
+} split_matrix_event_t;
+
+typedef struct _split_slave_matrix_events_t {
+    struct {
+        uint8_t seq;      // number of events published, wrapping
+        uint8_t checksum; // checksum of the slave matrix after the last published event
+    } head;
+    uint8_t first; // first event the master asks for
+    struct {
+        uint8_t              checksum;
+        uint8_t              seq;   // sequence number of events[0]
+        uint8_t              count; // events still buffered from seq onwards, up to the window size; 0 if overwritten
+        split_matrix_event_t events[SPLIT_MATRIX_EVENTS_WINDOW];
+    } window;
+} split_slave_matrix_events_t;
+#endif // SPLIT_MATRIX_EVENTS
+
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -109,9 +151,14 @@ typedef struct _split_mods_sync_t {
 #if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 #    include "pointing_device.h"
 typedef struct _split_slave_pointing_sync_t {
-    uint8_t        checksum;
+    uint8_t checksum;
+#    ifdef SPLIT_POINTING_FUSION
+    pointing_device_motion_t motion;
+    uint8_t                  session; // written by the master, published back in motion.session
+#    else
     report_mouse_t report;
-    uint16_t       cpi;
+#    endif // SPLIT_POINTING_FUSION
+    uint16_t cpi;
 } split_slave_pointing_sync_t;
 #endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
@@ -143,6 +190,28 @@ typedef struct _rpc_sync_info_t {
 } rpc_sync_info_t;
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+#if defined(SPLIT_TRANSPORT_ENCODING)
+// [length] [transaction id] [crc8 of the decoded payload], ahead of the encoded delta
+#    define SPLIT_ENCODING_HEADER_SIZE 3
+
+typedef struct _split_encoding_info_t {
+    uint8_t checksum;
+    struct {
+        uint8_t length;
+    } payload;
+} split_encoding_info_t;
+#endif // defined(SPLIT_TRANSPORT_ENCODING)
+
+#if defined(SPLIT_TRANSPORT_BATCHING)
+typedef struct _split_batch_info_t {
+    uint8_t checksum;
+    struct {
+        uint8_t m2s_length;
+        uint8_t s2m_length;
+    } payload;
+} split_batch_info_t;
+#endif // defined(SPLIT_TRANSPORT_BATCHING)
+
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
@@ -154,6 +223,10 @@ typedef struct _split_shared_memory_t {
 
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SPLIT_MATRIX_EVENTS
+    split_slave_matrix_events_t smatrix_events;
+#endif // SPLIT_MATRIX_EVENTS
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -222,6 +295,17 @@ typedef struct _split_shared_memory_t {
     split_slave_activity_sync_t activity_sync;
 #endif // defined(SPLIT_ACTIVITY_ENABLE)
 
+#if defined(SPLIT_TRANSPORT_ENCODING)
+    split_encoding_info_t encoding_info;
+    uint8_t               encoding_buffer[SPLIT_TRANSPORT_ENCODING_BUFFER_SIZE];
+#endif // defined(SPLIT_TRANSPORT_ENCODING)
+
+#if defined(SPLIT_TRANSPORT_BATCHING)
+    split_batch_info_t batch_info;
+    uint8_t            batch_m2s_buffer[SPLIT_BATCH_M2S_BUFFER_SIZE];
+    uint8_t            batch_s2m_buffer[SPLIT_BATCH_S2M_BUFFER_SIZE];
+#endif // defined(SPLIT_TRANSPORT_BATCHING)
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     rpc_sync_info_t rpc_info;
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
@@ -0,0 +1,110 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include <string.h>
+#include "task_scheduler.h"
+#include "deferred_exec.h"
+#include "timer.h"
+#include "util.h"
+
+typedef struct {
+    scheduled_task_t task;
+    deferred_token   token;
+    uint8_t          priority;
+    uint8_t          deferrals;
+    uint16_t         period_ms;
+    uint16_t         budget_us;
+    uint16_t         cost_us;
+} scheduler_entry_t;
+
+static scheduler_entry_t   entries[MAX_SCHEDULED_TASKS];
+static deferred_executor_t executors[TASK_PRIORITY_COUNT][MAX_SCHEDULED_TASKS];
+static uint32_t            last_execution[TASK_PRIORITY_COUNT];
+static uint32_t            loop_start     = 0;
+static uint32_t            deferral_count = 0;
+
+__attribute__((weak)) uint32_t task_scheduler_timestamp(void) {
+    return timer_read_us();
+}
+
+static uint32_t scheduler_callback(uint32_t trigger_time, void *cb_arg) {
+    scheduler_entry_t *entry = (scheduler_entry_t *)cb_arg;
+    uint32_t           start = task_scheduler_timestamp();
+
+    if (entry->priority == TASK_PRIORITY_COSMETIC && entry->deferrals < TASK_SCHEDULER_MAX_DEFERRALS) {
+        // Assume the task costs at least as much as it did last time
+        uint32_t cost = MAX(entry->budget_us, entry->cost_us);
+        if (start - loop_start + cost > TASK_SCHEDULER_LOOP_BUDGET_US) {
+            entry->deferrals++;
+            deferral_count++;
+            return 1;
+        }
+    }
+
+    entry->task();
+    entry->cost_us   = MIN(task_scheduler_timestamp() - start, UINT16_MAX);
+    entry->deferrals = 0;
+    return entry->period_ms;
+}
+
+void task_scheduler_init(void) {
+    memset(entries, 0, sizeof(entries));
+    memset(executors, 0, sizeof(executors));
+    memset(last_execution, 0, sizeof(last_execution));
+    deferral_count = 0;
+}
+
+bool task_scheduler_register(scheduled_task_t task, uint16_t period_ms, task_priority_t priority, uint16_t budget_us) {
+    if (!task || period_ms == 0 || priority >= TASK_PRIORITY_COUNT) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < MAX_SCHEDULED_TASKS; i++) {
+        scheduler_entry_t *entry = &entries[i];
+        if (entry->task == NULL) {
+            entry->priority  = priority;
+            entry->deferrals = 0;
+            entry->period_ms = period_ms;
+            entry->budget_us = budget_us;
+            entry->cost_us   = 0;
+            // Newly registered tasks are first run on the next millisecond tick
+            entry->token = defer_exec_advanced(executors[priority], MAX_SCHEDULED_TASKS, 1, scheduler_callback, entry);
+            if (entry->token == INVALID_DEFERRED_TOKEN) {
+                return false;
+            }
+            entry->task = task;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool task_scheduler_unregister(scheduled_task_t task) {
+    for (uint8_t i = 0; i < MAX_SCHEDULED_TASKS; i++) {
+        scheduler_entry_t *entry = &entries[i];
+        if (entry->task == task) {
+            cancel_deferred_exec_advanced(executors[entry->priority], MAX_SCHEDULED_TASKS, entry->token);
+            entry->task  = NULL;
+            entry->token = INVALID_DEFERRED_TOKEN;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void task_scheduler_loop_start(void) {
+    loop_start = task_scheduler_timestamp();
+}
+
+void task_scheduler_task(void) {
+    for (uint8_t priority = 0; priority < TASK_PRIORITY_COUNT; priority++) {
+        deferred_exec_advanced_task(executors[priority], MAX_SCHEDULED_TASKS, &last_execution[priority]);
+    }
+}
+
+uint32_t task_scheduler_deferral_count(void) {
+    return deferral_count;
+}
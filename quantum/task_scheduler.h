@@ -0,0 +1,91 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Time-budgeted cooperative scheduler for periodic subsystem tasks.
+
+    Matrix scanning, action processing and host reporting are still called
+    directly from keyboard_task() every loop. Everything else registers here
+    with a period, a priority and the time it expects to need per call, and
+    is run from deferred executor tables (one per priority) once it is due.
+
+    Cosmetic tasks are deferred by a millisecond at a time while the current
+    loop has already spent its budget, so lighting and displays degrade
+    before the scan rate does. A task that has been deferred
+    TASK_SCHEDULER_MAX_DEFERRALS times in a row is run regardless.
+*/
+
+#ifndef MAX_SCHEDULED_TASKS
+#    define MAX_SCHEDULED_TASKS 16
+#endif
+
+#ifndef TASK_SCHEDULER_LOOP_BUDGET_US
+#    define TASK_SCHEDULER_LOOP_BUDGET_US 1000
+#endif
+
+#ifndef TASK_SCHEDULER_MAX_DEFERRALS
+#    define TASK_SCHEDULER_MAX_DEFERRALS 8
+#endif
+
+/* Long enough that lighting and displays skip every other tick, short enough
+ * for RGB Matrix to start, render (in five passes) and flush a frame within
+ * its default 16 ms flush limit */
+#ifndef TASK_SCHEDULER_COSMETIC_PERIOD
+#    define TASK_SCHEDULER_COSMETIC_PERIOD 2
+#endif
+
+typedef enum {
+    TASK_PRIORITY_HIGH,     // always run as soon as due
+    TASK_PRIORITY_NORMAL,   // run as soon as due, after high priority tasks
+    TASK_PRIORITY_COSMETIC, // run when due and the loop is within budget
+    TASK_PRIORITY_COUNT,
+} task_priority_t;
+
+typedef void (*scheduled_task_t)(void);
+
+/**
+ * @brief Current time in microseconds, used to measure task and loop cost.
+ * Defaults to timer_read_us().
+ */
+uint32_t task_scheduler_timestamp(void);
+
+/**
+ * @brief Clears all registered tasks and statistics.
+ */
+void task_scheduler_init(void);
+
+/**
+ * @brief Registers a periodic task.
+ *
+ * @param task the function to call
+ * @param period_ms minimum interval between calls, at least 1
+ * @param priority the tier the task runs in
+ * @param budget_us expected cost of a single call
+ * @return true if the task was registered
+ */
+bool task_scheduler_register(scheduled_task_t task, uint16_t period_ms, task_priority_t priority, uint16_t budget_us);
+
+/**
+ * @brief Removes a previously registered task.
+ */
+bool task_scheduler_unregister(scheduled_task_t task);
+
+/**
+ * @brief Marks the start of a main loop iteration, against which the loop budget is measured.
+ */
+void task_scheduler_loop_start(void);
+
+/**
+ * @brief Runs every due task, highest priority first.
+ */
+void task_scheduler_task(void);
+
+/**
+ * @brief Number of times a cosmetic task was postponed because the loop was over budget.
+ */
+uint32_t task_scheduler_deferral_count(void);
@@ -235,6 +235,7 @@ __attribute__((weak)) void unicode_input_start(void) {
                 tap_code(KC_NUM_LOCK);
             }
             register_code(KC_LEFT_ALT);
+            host_flush_reports();
             wait_ms(UNICODE_TYPE_DELAY);
             tap_code(KC_KP_PLUS);
             break;
@@ -250,6 +251,7 @@ __attribute__((weak)) void unicode_input_start(void) {
             break;
     }
 
+    host_flush_reports();
     wait_ms(UNICODE_TYPE_DELAY);
 }
 
@@ -36,6 +36,7 @@
 #include "wait.h"
 #include "version.h" // for QMK_BUILDDATE used in EEPROM magic
 #include "nvm_via.h"
+#include "util.h"
 
 #if defined(SECURE_ENABLE)
 #    include "secure.h"
@@ -65,6 +66,14 @@
 #    include "led_matrix.h"
 #endif
 
+#if defined(LATENCY_STATS_ENABLE)
+#    include "latency_stats.h"
+#endif
+
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_LINK_STATS_ENABLE)
+#    include "split_link.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -357,6 +366,60 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
                     command_data[4] = value & 0xFF;
                     break;
                 }
+#if defined(LATENCY_STATS_ENABLE)
+                case id_latency_stats: {
+                    latency_summary_t summary = {0};
+                    if (command_data[1] < LATENCY_STAGE_COUNT) {
+                        latency_stats_get(command_data[1], &summary);
+                    }
+                    uint32_t values[] = {summary.count, summary.p50, summary.p99, summary.max};
+                    uint8_t  i        = 2;
+                    for (uint8_t v = 0; v < ARRAY_SIZE(values); v++) {
+                        command_data[i++] = (values[v] >> 24) & 0xFF;
+                        command_data[i++] = (values[v] >> 16) & 0xFF;
+                        command_data[i++] = (values[v] >> 8) & 0xFF;
+                        command_data[i++] = values[v] & 0xFF;
+                    }
+                    break;
+                }
+#endif
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_LINK_STATS_ENABLE)
+                case id_split_link_stats: {
+                    uint8_t i = 2;
+                    if (command_data[1] == 0xFF) {
+                        split_link_status_t status;
+                        split_link_get_status(&status);
+                        command_data[i++] = status.error_rate;
+                        command_data[i++] = status.backoff;
+                        uint32_t values[] = {status.cycles, status.failures, status.skipped};
+                        for (uint8_t v = 0; v < ARRAY_SIZE(values); v++) {
+                            command_data[i++] = (values[v] >> 24) & 0xFF;
+                            command_data[i++] = (values[v] >> 16) & 0xFF;
+                            command_data[i++] = (values[v] >> 8) & 0xFF;
+                            command_data[i++] = values[v] & 0xFF;
+                        }
+                    } else {
+                        split_link_transaction_stats_t stats;
+                        split_link_stats_get(command_data[1], &stats);
+                        uint16_t values[] = {stats.success, stats.crc_errors, stats.timeouts};
+                        for (uint8_t v = 0; v < ARRAY_SIZE(values); v++) {
+                            command_data[i++] = (values[v] >> 8) & 0xFF;
+                            command_data[i++] = values[v] & 0xFF;
+                        }
+                        for (uint8_t bucket = 0; bucket < SPLIT_LINK_STATS_BUCKETS; bucket++) {
+                            command_data[i++] = (stats.latency[bucket] >> 8) & 0xFF;
+                            command_data[i++] = stats.latency[bucket] & 0xFF;
+                        }
+                    }
+                    break;
+                }
+#endif
+#if defined(VIA_BULK_ENABLE)
+                case id_bulk_capabilities: {
+                    via_bulk_get_capabilities(&command_data[1]);
+                    break;
+                }
+#endif
                 default: {
                     // The value ID is not known
                     // Return the unhandled state
@@ -378,6 +441,18 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
                     via_set_device_indication(value);
                     break;
                 }
+#if defined(LATENCY_STATS_ENABLE)
+                case id_latency_stats: {
+                    latency_stats_reset();
+                    break;
+                }
+#endif
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_LINK_STATS_ENABLE)
+                case id_split_link_stats: {
+                    split_link_stats_reset();
+                    break;
+                }
+#endif
                 default: {
                     // The value ID is not known
                     // Return the unhandled state
@@ -467,6 +542,20 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_encoder(command_data[0], command_data[1], command_data[2] != 0, (command_data[3] << 8) | command_data[4]);
             break;
         }
+#endif
+#if defined(VIA_BULK_ENABLE)
+        case id_bulk_begin:
+        case id_bulk_data:
+        case id_bulk_ack:
+        case id_bulk_commit:
+        case id_bulk_read: {
+            // Streamed data packets are acknowledged a window at a time,
+            // and reads send their own replies
+            if (!via_bulk_command(data, length)) {
+                return;
+            }
+            break;
+        }
 #endif
         default: {
             // The command ID is not known
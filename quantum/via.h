@@ -37,6 +37,11 @@
 #    define VIA_EEPROM_CUSTOM_CONFIG_SIZE 0
 #endif
 
+// Number of raw HID reports streamed per acknowledgement by the id_bulk_* commands
+#ifndef VIA_BULK_WINDOW_SIZE
+#    define VIA_BULK_WINDOW_SIZE 8
+#endif
+
 // This is changed only when the command IDs change,
 // so VIA Configurator can detect compatible firmware.
 #define VIA_PROTOCOL_VERSION 0x000C
@@ -73,6 +78,11 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    id_bulk_begin                           = 0x16,
+    id_bulk_data                            = 0x17,
+    id_bulk_ack                             = 0x18,
+    id_bulk_commit                          = 0x19,
+    id_bulk_read                            = 0x1A,
     id_unhandled                            = 0xFF,
 };
 
@@ -82,6 +92,9 @@ enum via_keyboard_value_id {
     id_switch_matrix_state = 0x03,
     id_firmware_version    = 0x04,
     id_device_indication   = 0x05,
+    id_latency_stats       = 0x06,
+    id_split_link_stats    = 0x07,
+    id_bulk_capabilities   = 0x08,
 };
 
 enum via_channel_id {
@@ -123,6 +136,20 @@ enum via_qmk_audio_value {
     id_qmk_audio_clicky_enable = 2,
 };
 
+enum via_bulk_target {
+    id_bulk_keymap = 0,
+    id_bulk_macro  = 1,
+};
+
+enum via_bulk_status {
+    id_bulk_ok         = 0,
+    id_bulk_bad_target = 1,
+    id_bulk_bad_range  = 2,
+    id_bulk_no_session = 3,
+    id_bulk_missing    = 4,
+    id_bulk_bad_crc    = 5,
+};
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void);
@@ -153,6 +180,14 @@ void via_set_device_indication(uint8_t value);
 // Called by QMK core to process VIA-specific keycodes.
 bool process_record_via(uint16_t keycode, keyrecord_t *record);
 
+#if defined(VIA_BULK_ENABLE)
+// Handles the id_bulk_* commands, returning whether data should be sent back as the reply.
+bool via_bulk_command(uint8_t *data, uint8_t length);
+
+// Fills in the id_bulk_capabilities keyboard value: [version, window, payload].
+void via_bulk_get_capabilities(uint8_t *data);
+#endif
+
 // These are made external so that keyboard level custom value handlers can use them.
 #if defined(BACKLIGHT_ENABLE)
 void via_qmk_backlight_command(uint8_t *data, uint8_t length);
@@ -0,0 +1,249 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <string.h>
+#include "via.h"
+#include "raw_hid.h"
+#include "dynamic_keymap.h"
+#include "compiler_support.h"
+#include "util.h"
+
+#ifdef NVM_WRITE_BACK_ENABLE
+#    include "nvm_write_back.h"
+#endif
+
+/*
+    Streaming transfers of the dynamic keymap and macro buffers.
+
+    id_bulk_begin    [cmd, target, offset_hi, offset_lo, length_hi, length_lo]
+                     -> [cmd, status, window, payload]
+    id_bulk_data     [cmd, index, payload...], no reply
+    id_bulk_ack      [cmd, crc_hi, crc_lo]
+                     -> [cmd, status, position_hi, position_lo]
+    id_bulk_commit   [cmd, crc_hi, crc_lo]
+                     -> [cmd, status]
+    id_bulk_read     [cmd, target, offset_hi, offset_lo, count]
+                     -> count x [cmd, index, payload...]
+
+    The host streams up to `window` data packets, each carrying `payload`
+    bytes of the window at index * payload, then acknowledges the window
+    with its CRC. Only a complete window with a matching CRC is written, and
+    the reply's position is where the next window starts -- on any error it
+    is the start of the current one, which the host resends. The commit
+    checks the CRC of the whole transfer and flushes it to the backing store.
+
+    CRCs are CRC-16/CCITT-FALSE.
+
+    The commands are not covered by VIA_PROTOCOL_VERSION. Hosts check for
+    them by reading the id_bulk_capabilities keyboard value, which is
+    unhandled on firmware without them:
+
+    id_get_keyboard_value [cmd, id_bulk_capabilities]
+                     -> [cmd, id_bulk_capabilities, version, window, payload]
+*/
+
+#ifndef RAW_EPSIZE
+#    define RAW_EPSIZE 32
+#endif
+
+#define VIA_BULK_PAYLOAD_SIZE (RAW_EPSIZE - 2)
+
+// Bumped whenever the layout of the id_bulk_* commands changes
+#define VIA_BULK_VERSION 1
+
+STATIC_ASSERT(VIA_BULK_WINDOW_SIZE > 0 && VIA_BULK_WINDOW_SIZE <= 32, "VIA_BULK_WINDOW_SIZE must be between 1 and 32");
+
+static struct {
+    bool     active;
+    uint8_t  target;
+    uint16_t offset;
+    uint16_t length;
+    uint16_t position;
+    uint16_t crc;
+    uint32_t received;
+    uint8_t  window[VIA_BULK_WINDOW_SIZE * VIA_BULK_PAYLOAD_SIZE];
+} bulk;
+
+static uint16_t crc16_update(uint16_t crc, const uint8_t *data, uint16_t length) {
+    while (length--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static bool target_size(uint8_t target, uint16_t *size) {
+    switch (target) {
+        case id_bulk_keymap:
+            *size = dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+            return true;
+        case id_bulk_macro:
+            *size = dynamic_keymap_macro_get_buffer_size();
+            return true;
+        default:
+            return false;
+    }
+}
+
+static uint16_t window_length(void) {
+    return MIN(sizeof(bulk.window), bulk.length - bulk.position);
+}
+
+static uint8_t window_packets(void) {
+    return (window_length() + VIA_BULK_PAYLOAD_SIZE - 1) / VIA_BULK_PAYLOAD_SIZE;
+}
+
+static uint8_t bulk_begin(uint8_t *command_data) {
+    uint8_t  target = command_data[0];
+    uint16_t offset = (command_data[1] << 8) | command_data[2];
+    uint16_t length = (command_data[3] << 8) | command_data[4];
+    uint16_t size;
+
+    bulk.active = false;
+    if (!target_size(target, &size)) {
+        return id_bulk_bad_target;
+    }
+    if (length == 0 || offset > size || length > size - offset) {
+        return id_bulk_bad_range;
+    }
+
+    bulk.active   = true;
+    bulk.target   = target;
+    bulk.offset   = offset;
+    bulk.length   = length;
+    bulk.position = 0;
+    bulk.crc      = 0xFFFF;
+    bulk.received = 0;
+    return id_bulk_ok;
+}
+
+static void bulk_data(const uint8_t *command_data) {
+    uint8_t index = command_data[0];
+    if (!bulk.active || index >= window_packets()) {
+        return;
+    }
+    uint16_t start = index * VIA_BULK_PAYLOAD_SIZE;
+    memcpy(&bulk.window[start], &command_data[1], MIN(VIA_BULK_PAYLOAD_SIZE, window_length() - start));
+    bulk.received |= (uint32_t)1 << index;
+}
+
+static uint8_t bulk_ack(const uint8_t *command_data) {
+    uint16_t crc      = (command_data[0] << 8) | command_data[1];
+    uint32_t expected = ((uint64_t)1 << window_packets()) - 1;
+    uint16_t length   = window_length();
+    uint32_t received = bulk.received;
+
+    bulk.received = 0;
+    if (!bulk.active) {
+        return id_bulk_no_session;
+    }
+    if (length == 0 || received != expected) {
+        return id_bulk_missing;
+    }
+    if (crc16_update(0xFFFF, bulk.window, length) != crc) {
+        return id_bulk_bad_crc;
+    }
+
+    if (bulk.target == id_bulk_keymap) {
+        dynamic_keymap_set_buffer(bulk.offset + bulk.position, length, bulk.window);
+    } else {
+        dynamic_keymap_macro_set_buffer(bulk.offset + bulk.position, length, bulk.window);
+    }
+    bulk.crc = crc16_update(bulk.crc, bulk.window, length);
+    bulk.position += length;
+    return id_bulk_ok;
+}
+
+static uint8_t bulk_commit(const uint8_t *command_data) {
+    uint16_t crc = (command_data[0] << 8) | command_data[1];
+    if (!bulk.active) {
+        return id_bulk_no_session;
+    }
+    if (bulk.position != bulk.length) {
+        return id_bulk_missing;
+    }
+    if (bulk.crc != crc) {
+        return id_bulk_bad_crc;
+    }
+    bulk.active = false;
+#ifdef NVM_WRITE_BACK_ENABLE
+    nvm_write_back_flush();
+#endif
+    return id_bulk_ok;
+}
+
+static void bulk_read(uint8_t *data, uint8_t length) {
+    uint8_t *command_data = &data[1];
+    uint8_t  target       = command_data[0];
+    uint16_t offset       = (command_data[1] << 8) | command_data[2];
+    uint8_t  count        = MIN(command_data[3], VIA_BULK_WINDOW_SIZE);
+    uint16_t size;
+
+    if (!target_size(target, &size)) {
+        data[0] = id_unhandled;
+        raw_hid_send(data, length);
+        return;
+    }
+
+    // Reads past the end come back as zeros
+    for (uint8_t index = 0; index < count; index++) {
+        uint16_t start = offset + index * VIA_BULK_PAYLOAD_SIZE;
+        data[0]        = id_bulk_read;
+        data[1]        = index;
+        if (target == id_bulk_keymap) {
+            dynamic_keymap_get_buffer(start, VIA_BULK_PAYLOAD_SIZE, &data[2]);
+        } else {
+            dynamic_keymap_macro_get_buffer(start, VIA_BULK_PAYLOAD_SIZE, &data[2]);
+        }
+        raw_hid_send(data, length);
+    }
+}
+
+void via_bulk_get_capabilities(uint8_t *data) {
+    data[0] = VIA_BULK_VERSION;
+    data[1] = VIA_BULK_WINDOW_SIZE;
+    data[2] = VIA_BULK_PAYLOAD_SIZE;
+}
+
+bool via_bulk_command(uint8_t *data, uint8_t length) {
+    uint8_t *command_id   = &(data[0]);
+    uint8_t *command_data = &(data[1]);
+
+    // The payload size is fixed at build time, so reports must be full size
+    if (length < RAW_EPSIZE) {
+        *command_id = id_unhandled;
+        return true;
+    }
+
+    switch (*command_id) {
+        case id_bulk_begin: {
+            command_data[0] = bulk_begin(command_data);
+            command_data[1] = VIA_BULK_WINDOW_SIZE;
+            command_data[2] = VIA_BULK_PAYLOAD_SIZE;
+            return true;
+        }
+        case id_bulk_data: {
+            bulk_data(command_data);
+            return false;
+        }
+        case id_bulk_ack: {
+            command_data[0] = bulk_ack(command_data);
+            command_data[1] = bulk.position >> 8;
+            command_data[2] = bulk.position & 0xFF;
+            return true;
+        }
+        case id_bulk_commit: {
+            command_data[0] = bulk_commit(command_data);
+            return true;
+        }
+        case id_bulk_read: {
+            bulk_read(data, length);
+            return false;
+        }
+        default: {
+            *command_id = id_unhandled;
+            return true;
+        }
+    }
+}
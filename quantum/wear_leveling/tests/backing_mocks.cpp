@@ -75,6 +75,24 @@ bool MockBackingStore::erase(void) {
     return true;
 }
 
+bool MockBackingStore::erase_sector(std::uint32_t index) {
+    ++backing_erase_invoke_count;
+
+    EXPECT_TRUE((index + 1) * MOCK_BACKING_STORE_SECTOR_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Sector would result of out-of-bounds access";
+    EXPECT_FALSE(is_locked()) << "Erase was attempted without being unlocked first";
+
+    // Drop out of erase early with failure if we need to
+    if (erase_success_callback && !erase_success_callback(backing_erase_invoke_count)) {
+        return false;
+    }
+
+    std::size_t first = index * MOCK_BACKING_STORE_SECTOR_SIZE / BACKING_STORE_WRITE_SIZE;
+    for (std::size_t i = first; i < first + MOCK_BACKING_STORE_SECTOR_SIZE / BACKING_STORE_WRITE_SIZE; ++i) {
+        backing_storage[i].erase();
+    }
+    return true;
+}
+
 bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     ++backing_write_invoke_count;
 
@@ -141,6 +159,14 @@ extern "C" bool backing_store_erase(void) {
     return MockBackingStore::Instance().erase();
 }
 
+extern "C" uint32_t backing_store_sector_count(void) {
+    return WEAR_LEVELING_BACKING_SIZE / MOCK_BACKING_STORE_SECTOR_SIZE;
+}
+
+extern "C" bool backing_store_erase_sector(uint32_t index) {
+    return MockBackingStore::Instance().erase_sector(index);
+}
+
 extern "C" bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return MockBackingStore::Instance().write(address, value);
 }
@@ -21,6 +21,10 @@ using MOCK_WRITE_LOG_MAX_ENTRIES = std::integral_constant<std::size_t, 1024>;
 using BACKING_STORE_INTEGRAL_COMPLEMENT = std::integral_constant<backing_store_int_t, ((backing_store_int_t)(~(backing_store_int_t)0))>;
 // Total number of elements stored in the backing arrays
 using BACKING_STORE_ELEMENT_COUNT = std::integral_constant<std::size_t, (WEAR_LEVELING_BACKING_SIZE / sizeof(backing_store_int_t))>;
+// Size of each separately erasable sector
+#ifndef MOCK_BACKING_STORE_SECTOR_SIZE
+#    define MOCK_BACKING_STORE_SECTOR_SIZE WEAR_LEVELING_BACKING_SIZE
+#endif
 
 class MockBackingStoreElement {
    private:
@@ -159,6 +163,7 @@ class MockBackingStore {
     bool init();
     bool unlock();
     bool erase();
+    bool erase_sector(std::uint32_t index);
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
@@ -64,3 +64,19 @@ wear_leveling_8byte_SRC := \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
 	$(wear_leveling_common_INC)
+
+wear_leveling_async_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=4 \
+	-DWEAR_LEVELING_BACKING_SIZE=128 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=16 \
+	-DWEAR_LEVELING_ASYNC_CONSOLIDATION \
+	-DWEAR_LEVELING_CONSOLIDATION_STEP_SIZE=4 \
+	-DWEAR_LEVELING_CONSOLIDATION_HEADROOM=16 \
+	-DWEAR_LEVELING_DIRTY_RANGES=2 \
+	-DMOCK_BACKING_STORE_SECTOR_SIZE=16
+wear_leveling_async_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_async.cpp
+wear_leveling_async_INC := \
+	$(wear_leveling_common_INC)
@@ -0,0 +1,386 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <iterator>
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingAsync : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        std::fill(verify_data.begin(), verify_data.end(), 0);
+    }
+
+    static std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+
+    static wear_leveling_status_t test_write(const uint32_t address, const void* value, size_t length) {
+        memcpy(&verify_data[address], value, length);
+        return wear_leveling_write(address, value, length);
+    }
+
+    // Fills the write log with 2-byte multibyte entries until consolidation is scheduled, returning the status of the final write
+    static wear_leveling_status_t fill_log(void) {
+        wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+        for (uint32_t address = 0; !wear_leveling_is_consolidating(); address += 2) {
+            uint8_t value[2] = {(uint8_t)(0x40 + address), (uint8_t)(0x41 + address)};
+            status           = test_write(address % WEAR_LEVELING_LOGICAL_SIZE, value, sizeof(value));
+        }
+        return status;
+    }
+
+    static int run_to_completion(void) {
+        int steps = 0;
+        while (wear_leveling_is_consolidating()) {
+            wear_leveling_task();
+            ++steps;
+        }
+        return steps;
+    }
+
+    static void verify_readback(void) {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read back the data.";
+        EXPECT_EQ(readback, verify_data) << "Readback did not match the written data.";
+    }
+};
+
+std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> WearLevelingAsync::verify_data;
+
+// One step per sector of the other area erased, one per WEAR_LEVELING_CONSOLIDATION_STEP_SIZE bytes of consolidated
+// data, then the checksum
+static constexpr int area_size           = WEAR_LEVELING_BACKING_SIZE / 2;
+static constexpr int sector_count        = area_size / MOCK_BACKING_STORE_SECTOR_SIZE;
+static constexpr int data_steps          = WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_CONSOLIDATION_STEP_SIZE;
+static constexpr int consolidation_steps = sector_count + data_steps + 1;
+
+/**
+ * This test verifies that nearly filling the write log schedules consolidation instead of erasing inside the write.
+ */
+TEST_F(WearLevelingAsync, LogNearlyFull_ConsolidationDeferred) {
+    auto& inst = MockBackingStore::Instance();
+
+    EXPECT_EQ(fill_log(), WEAR_LEVELING_SUCCESS) << "Write that filled the log should not report consolidation";
+    EXPECT_TRUE(wear_leveling_is_consolidating()) << "Consolidation should be pending";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "No erase should happen inside the write";
+
+    uint64_t               writes_before = inst.write_invoke_count();
+    uint64_t               erases_before = inst.erase_invoke_count();
+    wear_leveling_status_t status        = WEAR_LEVELING_SUCCESS;
+    int                    steps         = 0;
+    while (wear_leveling_is_consolidating()) {
+        status = wear_leveling_task();
+        ++steps;
+        // A single sector and the 8-byte sequence number, a chunk of consolidated data, or the 8-byte checksum
+        EXPECT_LE(inst.erase_invoke_count() - erases_before, 1) << "Step erased more than one sector";
+        EXPECT_LE(inst.write_invoke_count() - writes_before, std::max(WEAR_LEVELING_CONSOLIDATION_STEP_SIZE, 8) / BACKING_STORE_WRITE_SIZE) << "Step wrote more than its budget";
+        writes_before = inst.write_invoke_count();
+        erases_before = inst.erase_invoke_count();
+    }
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Final step should report consolidation";
+    EXPECT_EQ(steps, consolidation_steps) << "Unexpected number of consolidation steps";
+    EXPECT_EQ(inst.erase_invoke_count(), sector_count) << "Consolidation should erase each sector of the other area exactly once";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Idle task should do nothing";
+
+    verify_readback();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should succeed";
+    verify_readback();
+}
+
+/**
+ * This test verifies that an entry which doesn't fit in the remainder of the log completes the consolidation in-line,
+ * rather than being truncated or held only in RAM.
+ */
+TEST_F(WearLevelingAsync, LogFull_ConsolidationCompletedInline) {
+    auto& inst = MockBackingStore::Instance();
+    fill_log();
+
+    // Single-slot entries, leaving one slot free
+    const std::size_t headroom_slots = WEAR_LEVELING_CONSOLIDATION_HEADROOM / BACKING_STORE_WRITE_SIZE;
+    for (std::size_t i = 0; i < headroom_slots - 1; ++i) {
+        uint8_t value = 0x11 + i;
+        EXPECT_EQ(test_write(9 + i, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write should succeed";
+    }
+    EXPECT_TRUE(wear_leveling_is_consolidating()) << "Consolidation should still be pending";
+
+    // This entry needs two slots
+    uint8_t pair[2] = {0x55, 0x66};
+    EXPECT_EQ(test_write(6, pair, sizeof(pair)), WEAR_LEVELING_CONSOLIDATED) << "Write should have completed the consolidation";
+    EXPECT_FALSE(wear_leveling_is_consolidating()) << "Consolidation should be complete";
+    EXPECT_TRUE((inst.storage_begin() + area_size / BACKING_STORE_WRITE_SIZE - 1)->is_erased()) << "Partial entry was written at the end of the log";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should succeed";
+    verify_readback();
+}
+
+/**
+ * This test verifies that reads are served from the cache throughout consolidation, and that writes made during it
+ * persist whether or not the consolidated data had already been written past their address.
+ */
+TEST_F(WearLevelingAsync, WritesDuringConsolidation_Persisted) {
+    fill_log();
+
+    // Erase, then the first half of the consolidated data
+    for (int i = 0; i < sector_count + data_steps / 2; ++i) {
+        wear_leveling_task();
+        verify_readback();
+    }
+
+    // Behind the write position
+    uint8_t value = 0x99;
+    EXPECT_EQ(test_write(1, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write should succeed";
+    // Ahead of the write position
+    value = 0xAA;
+    EXPECT_EQ(test_write(WEAR_LEVELING_LOGICAL_SIZE - 1, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write should succeed";
+    verify_readback();
+
+    // Power loss before the consolidation completes
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should succeed";
+    verify_readback();
+
+    run_to_completion();
+    verify_readback();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should succeed";
+    verify_readback();
+}
+
+/**
+ * This test verifies that consolidation only ever erases and writes the other area, leaving the live one intact until
+ * the other is valid, whichever of the two is live.
+ */
+TEST_F(WearLevelingAsync, LiveAreaUntouched) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (int round = 0; round < 3; ++round) {
+        SCOPED_TRACE(round);
+        fill_log();
+        std::vector<backing_store_int_t> before;
+        std::transform(inst.storage_begin(), inst.storage_end(), std::back_inserter(before), [](const MockBackingStoreElement& e) { return e.get(); });
+
+        // The area which was live is the one holding the write log that was just filled
+        const std::size_t live_first = (round % 2) * area_size / BACKING_STORE_WRITE_SIZE;
+        for (int i = 0; i < consolidation_steps - 1; ++i) {
+            wear_leveling_task();
+            for (std::size_t j = live_first; j < live_first + area_size / BACKING_STORE_WRITE_SIZE; ++j) {
+                EXPECT_EQ((inst.storage_begin() + j)->get(), before[j]) << "Live area was modified at " << j * BACKING_STORE_WRITE_SIZE;
+            }
+        }
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_CONSOLIDATED) << "Checksum step should complete the consolidation";
+
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should succeed";
+        verify_readback();
+    }
+}
+
+/**
+ * This test verifies that writes made between the last chunk and the checksum are logged once the checksum is written.
+ */
+TEST_F(WearLevelingAsync, WriteBeforeChecksum_Persisted) {
+    fill_log();
+    for (int i = 0; i < consolidation_steps - 1; ++i) {
+        wear_leveling_task();
+    }
+
+    uint8_t value = 0x77;
+    test_write(3, &value, sizeof(value));
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_CONSOLIDATED) << "Checksum step should complete the consolidation";
+    EXPECT_FALSE(wear_leveling_is_consolidating()) << "Consolidation should be complete";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should succeed";
+    verify_readback();
+}
+
+/**
+ * This test verifies that separate writes made during consolidation are logged separately, rather than as one span
+ * covering everything in between.
+ */
+TEST_F(WearLevelingAsync, SeparateWritesDuringConsolidation_LoggedSeparately) {
+    auto& inst = MockBackingStore::Instance();
+    fill_log();
+    for (int i = 0; i < consolidation_steps - 2; ++i) {
+        wear_leveling_task();
+    }
+
+    // Both behind the write position, far apart
+    uint8_t value = 0x31;
+    test_write(0, &value, sizeof(value));
+    value = 0x32;
+    test_write(WEAR_LEVELING_LOGICAL_SIZE - WEAR_LEVELING_CONSOLIDATION_STEP_SIZE - 1, &value, sizeof(value));
+    wear_leveling_task();
+
+    // The checksum, then a single-byte entry for each of the two writes
+    uint64_t writes_before = inst.write_invoke_count();
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_CONSOLIDATED) << "Checksum step should complete the consolidation";
+    EXPECT_EQ(inst.write_invoke_count() - writes_before, 8 / BACKING_STORE_WRITE_SIZE + 2) << "Unwritten bytes were logged";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should succeed";
+    verify_readback();
+}
+
+/**
+ * This test verifies that once every dirty range is in use, further writes are merged into the nearest one and still
+ * persisted.
+ */
+TEST_F(WearLevelingAsync, MoreWritesThanDirtyRanges_Persisted) {
+    auto& inst = MockBackingStore::Instance();
+    fill_log();
+    for (int i = 0; i < consolidation_steps - 2; ++i) {
+        wear_leveling_task();
+    }
+
+    // Three separate bytes, the last two end up in one range spanning the gap between them
+    const uint32_t addresses[] = {0, 2, 9};
+    for (uint32_t address : addresses) {
+        uint8_t value = 0x60 + address;
+        test_write(address, &value, sizeof(value));
+    }
+    wear_leveling_task();
+
+    uint64_t writes_before = inst.write_invoke_count();
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_CONSOLIDATED) << "Checksum step should complete the consolidation";
+    EXPECT_GT(inst.write_invoke_count() - writes_before, 8 / BACKING_STORE_WRITE_SIZE + 2) << "Merged range should have been logged";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should succeed";
+    verify_readback();
+}
+
+/**
+ * This test simulates a power loss after every step of consolidation, including a write made part-way through it, with
+ * either area live beforehand. Every completed write must survive: until the other area is valid the live one is used,
+ * from then on the other one is.
+ */
+TEST_F(WearLevelingAsync, InterruptedAtEveryStep) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (int rounds = 0; rounds < 3; ++rounds) {
+        for (int interrupt_at = 0; interrupt_at <= consolidation_steps; ++interrupt_at) {
+            SCOPED_TRACE(testing::Message() << "rounds " << rounds << ", interrupt_at " << interrupt_at);
+            inst.reset_instance();
+            wear_leveling_init();
+            std::fill(verify_data.begin(), verify_data.end(), 0);
+
+            for (int i = 0; i < rounds; ++i) {
+                fill_log();
+                wear_leveling_flush();
+            }
+            fill_log();
+            for (int i = 0; i < interrupt_at; ++i) {
+                // Once the first chunk is written, this one needs logging in the other area as well
+                if (i == sector_count + 1) {
+                    uint8_t value = 0xC3;
+                    EXPECT_EQ(test_write(1, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write should succeed";
+                }
+                wear_leveling_task();
+            }
+
+            // Power cycle
+            EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-init should succeed";
+            verify_readback();
+
+            // It works from there
+            run_to_completion();
+            uint8_t value = 0x5A;
+            test_write(5, &value, sizeof(value));
+            run_to_completion();
+            EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should succeed";
+            verify_readback();
+        }
+    }
+}
+
+/**
+ * This test verifies that a failure to commit the other area leaves the live one in use, and is retried.
+ */
+TEST_F(WearLevelingAsync, FailedCommit_Retried) {
+    auto& inst = MockBackingStore::Instance();
+    fill_log();
+    for (int i = 0; i < consolidation_steps - 1; ++i) {
+        wear_leveling_task();
+    }
+
+    inst.set_write_callback([](std::uint64_t, std::uint32_t address) { return address != area_size + WEAR_LEVELING_LOGICAL_SIZE; });
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Checksum failure should be reported";
+    EXPECT_TRUE(wear_leveling_is_consolidating()) << "Consolidation should still be pending";
+    inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+
+    uint8_t value = 0x24;
+    EXPECT_EQ(test_write(7, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write should still be logged";
+    EXPECT_EQ(run_to_completion(), consolidation_steps) << "Consolidation should have started over";
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should succeed";
+    verify_readback();
+}
+
+/**
+ * This test verifies that failed steps are retried, restarting from the erase when the area was partially written.
+ */
+TEST_F(WearLevelingAsync, InjectedFailures_Retried) {
+    auto& inst = MockBackingStore::Instance();
+    fill_log();
+
+    // Fail the second sector
+    inst.set_erase_callback([](std::uint64_t count) { return count != 2; });
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "First sector should be erased";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Erase failure should be reported";
+    EXPECT_TRUE(wear_leveling_is_consolidating()) << "Consolidation should still be pending";
+    for (int i = 1; i < sector_count; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Erase should be retried";
+    }
+    EXPECT_EQ(inst.erase_invoke_count(), sector_count + 1) << "Only the failed sector should have been erased again";
+
+    // Fail the second chunk of consolidated data
+    std::uint64_t fail_at = inst.write_invoke_count() + 1 + (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE / BACKING_STORE_WRITE_SIZE);
+    inst.set_write_callback([fail_at](std::uint64_t count, std::uint32_t) { return count != fail_at; });
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "First chunk should be written";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Write failure should be reported";
+
+    run_to_completion();
+    EXPECT_EQ(inst.erase_invoke_count(), 2 * sector_count + 1) << "Partially written area should have been erased again";
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should succeed";
+    verify_readback();
+}
+
+/**
+ * This test verifies that flushing completes a pending consolidation.
+ */
+TEST_F(WearLevelingAsync, Flush_CompletesConsolidation) {
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Nothing to flush";
+    fill_log();
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_CONSOLIDATED) << "Flush should complete the consolidation";
+    EXPECT_FALSE(wear_leveling_is_consolidating()) << "Consolidation should be complete";
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should succeed";
+    verify_readback();
+}
+
+/**
+ * This test verifies that flushing gives up on a backing store which keeps failing.
+ */
+TEST_F(WearLevelingAsync, Flush_GivesUpOnPersistentFailure) {
+    auto& inst = MockBackingStore::Instance();
+    fill_log();
+    inst.set_erase_callback([](std::uint64_t) { return false; });
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_FAILED) << "Flush should fail";
+    EXPECT_TRUE(wear_leveling_is_consolidating()) << "Consolidation should still be pending";
+}
+
+/**
+ * This test verifies that erasing abandons a pending consolidation.
+ */
+TEST_F(WearLevelingAsync, Erase_CancelsConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+    fill_log();
+    wear_leveling_task();
+    EXPECT_EQ(wear_leveling_erase(), WEAR_LEVELING_SUCCESS) << "Erase should succeed";
+    EXPECT_FALSE(wear_leveling_is_consolidating()) << "Consolidation should have been abandoned";
+
+    uint64_t erases = inst.erase_invoke_count();
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Idle task should do nothing";
+    EXPECT_EQ(inst.erase_invoke_count(), erases) << "No further erase should occur";
+
+    std::fill(verify_data.begin(), verify_data.end(), 0);
+    uint8_t value = 0x12;
+    test_write(0, &value, sizeof(value));
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should succeed";
+    verify_readback();
+}
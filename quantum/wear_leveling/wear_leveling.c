@@ -77,11 +77,34 @@
             * A new write log entry is appended to the log.
             * If the log's full, data is consolidated and the write log cleared.
 
+        With WEAR_LEVELING_ASYNC_CONSOLIDATION, the backing store is split
+        into two areas, each laid out as described below with a sequence
+        number after the hash. Only one is live at a time. Once its write log
+        is within WEAR_LEVELING_CONSOLIDATION_HEADROOM bytes of being full,
+        consolidation is scheduled, which wear_leveling_task() then performs
+        in steps against the other area:
+            * The other area is erased a sector at a time, then stamped with
+                the next sequence number.
+            * The cache is written to its consolidated data area, a chunk at a
+                time, hashing exactly the bytes that were written.
+            * Any cache changes which landed in already-written chunks are
+                appended to its write log.
+            * The hash of the data and sequence number is written, which is
+                what makes the area valid -- from then on it is the live one.
+        Writes made in the meantime are still appended to the live area's log,
+        so whichever area init picks -- the valid one with the later sequence
+        number -- holds every completed write. If the live log fills up before
+        consolidation completes, the write completes it in-line instead.
+        This relies on the driver reporting an even number of sectors, so the
+        areas can be erased separately; otherwise the whole backing store is
+        erased at once, and an interrupted consolidation loses the data.
+
     Write log structure:
 
         The first 8 bytes of the write log are a FNV1a_64 hash of the contents
         of the consolidated data area, in an attempt to detect and guard against
-        any data corruption.
+        any data corruption. With WEAR_LEVELING_ASYNC_CONSOLIDATION, the hash
+        also covers the area's sequence number, held in the following 8 bytes.
 
         The write log follows the hash:
 
@@ -162,9 +185,122 @@
 static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
+    uint32_t                                                       area_base; // start of the live area, only nonzero with WEAR_LEVELING_ASYNC_CONSOLIDATION
     bool                                                           unlocked;
 } wear_leveling;
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+/**
+ * Deferred consolidation state machine.
+ */
+typedef enum wear_leveling_consolidation_state_t {
+    CONSOLIDATION_IDLE,
+    CONSOLIDATION_ERASE,
+    CONSOLIDATION_WRITE_DATA,
+    CONSOLIDATION_WRITE_CHECKSUM,
+} wear_leveling_consolidation_state_t;
+
+/**
+ * A range of the cache, [start, end).
+ */
+typedef struct wear_leveling_range_t {
+    uint32_t start;
+    uint32_t end;
+} wear_leveling_range_t;
+
+static struct {
+    wear_leveling_consolidation_state_t state;
+    uint32_t                            sequence;    // sequence number of the live area
+    uint32_t                            erased;      // sectors of the other area erased so far
+    uint32_t                            progress;    // bytes of consolidated data written so far
+    uint64_t                            checksum;    // FNV1a_64 of the consolidated data written so far
+    bool                                committing;  // logging into the other area, which isn't valid yet
+    uint8_t                             dirty_count; // disjoint cache ranges modified after being written out
+    wear_leveling_range_t               dirty[WEAR_LEVELING_DIRTY_RANGES];
+} consolidation;
+
+/**
+ * The area being consolidated into, the one which isn't live.
+ */
+static inline uint32_t wear_leveling_consolidation_area(void) {
+    return wear_leveling.area_base == 0 ? (WEAR_LEVELING_AREA_SIZE) : 0;
+}
+
+/**
+ * (Re)starts a consolidation from the erase of the first sector.
+ */
+static void wear_leveling_consolidation_restart(void) {
+    consolidation.state       = CONSOLIDATION_ERASE;
+    consolidation.erased      = 0;
+    consolidation.progress    = 0;
+    consolidation.dirty_count = 0;
+}
+
+/**
+ * Schedules a consolidation, if one isn't already underway.
+ */
+static void wear_leveling_consolidation_start(void) {
+    if (consolidation.state == CONSOLIDATION_IDLE) {
+        wl_dprintf("Write log nearly full, scheduling consolidation\n");
+        wear_leveling_consolidation_restart();
+    }
+}
+
+/**
+ * Abandons any pending consolidation, for when the backing store is reinitialised or erased.
+ */
+static void wear_leveling_consolidation_cancel(void) {
+    consolidation.state = CONSOLIDATION_IDLE;
+}
+
+/**
+ * Records a cache modification made while consolidating. Anything not yet written out is picked up by the
+ * consolidation itself, anything before that needs to go to the other area's write log before it's made valid.
+ * Separate writes are kept as separate ranges, so only what was written gets logged; once all
+ * WEAR_LEVELING_DIRTY_RANGES are in use, a new range is merged with the one nearest to it.
+ */
+static void wear_leveling_consolidation_mark_dirty(uint32_t address, size_t length) {
+    if (address >= consolidation.progress) {
+        return;
+    }
+    uint32_t start = address;
+    uint32_t end   = address + length < consolidation.progress ? address + length : consolidation.progress;
+
+    uint8_t i = 0;
+    while (i < consolidation.dirty_count) {
+        wear_leveling_range_t *range = &consolidation.dirty[i];
+        if (range->start <= end && start <= range->end) {
+            // Overlapping or adjacent, absorb it and look again as the range has grown
+            start                  = range->start < start ? range->start : start;
+            end                    = range->end > end ? range->end : end;
+            consolidation.dirty[i] = consolidation.dirty[--consolidation.dirty_count];
+            i                      = 0;
+            continue;
+        }
+        ++i;
+    }
+
+    if (consolidation.dirty_count == (WEAR_LEVELING_DIRTY_RANGES)) {
+        uint8_t  nearest = 0;
+        uint32_t min_gap = UINT32_MAX;
+        for (i = 0; i < consolidation.dirty_count; ++i) {
+            const wear_leveling_range_t *range = &consolidation.dirty[i];
+            const uint32_t               gap   = range->start > end ? range->start - end : start - range->end;
+            if (gap < min_gap) {
+                min_gap = gap;
+                nearest = i;
+            }
+        }
+        // No other range lies in the gap to the nearest one, so the merged range stays disjoint from the rest
+        start                        = consolidation.dirty[nearest].start < start ? consolidation.dirty[nearest].start : start;
+        end                          = consolidation.dirty[nearest].end > end ? consolidation.dirty[nearest].end : end;
+        consolidation.dirty[nearest] = consolidation.dirty[--consolidation.dirty_count];
+    }
+
+    consolidation.dirty[consolidation.dirty_count++] = (wear_leveling_range_t){.start = start, .end = end};
+}
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
 /**
  * Locking helper: status
  */
@@ -198,23 +334,65 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
     return STATUS_SUCCESS;
 }
 
+/**
+ * The start of the live area's write log.
+ */
+static inline uint32_t wear_leveling_log_start(void) {
+    return wear_leveling.area_base + (WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_HEADER_SIZE);
+}
+
+/**
+ * The end of the live area's write log.
+ */
+static inline uint32_t wear_leveling_log_end(void) {
+    return wear_leveling.area_base + (WEAR_LEVELING_AREA_SIZE);
+}
+
 /**
  * Resets the cache, ensuring the write address is correctly initialised.
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = wear_leveling_log_start();
 }
 
 /**
- * Reads the consolidated data from the backing store into the cache.
+ * Reads an 8-byte header value from the backing store.
+ */
+static bool wear_leveling_read_header(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_read_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_read_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_read(address, &entry->raw64);
+#endif
+}
+
+/**
+ * Writes an 8-byte header value to the backing store.
+ * Pre-condition: this is just after an erase, so we can write directly without reading.
+ */
+static bool wear_leveling_write_header(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry->raw64);
+#endif
+}
+
+/**
+ * Reads the consolidated data of the area at the supplied address into the cache, clearing the cache if it isn't valid.
  * Does not consider the write log.
  */
-static wear_leveling_status_t wear_leveling_read_consolidated(void) {
-    wl_dprintf("Reading consolidated data\n");
+static wear_leveling_status_t wear_leveling_read_area(uint32_t base, bool *valid, uint32_t *sequence) {
+    wl_dprintf("Reading consolidated data at 0x%04X\n", (int)base);
 
+    *valid                        = false;
     wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
-    if (!backing_store_read_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+    if (!backing_store_read_bulk(base, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to read from backing store\n");
         status = WEAR_LEVELING_FAILED;
     }
@@ -223,18 +401,20 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     if (status != WEAR_LEVELING_FAILED) {
         uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
         write_log_entry_t entry;
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+        wear_leveling_read_header(base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &entry);
+        *sequence = (uint32_t)entry.raw64;
+        expected  = fnv_64a_buf(sequence, sizeof(*sequence), expected);
+#else  // WEAR_LEVELING_ASYNC_CONSOLIDATION
+        *sequence = 0;
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
         wl_dprintf("Reading checksum\n");
-#if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
-#elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
-#elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
-#endif
+        wear_leveling_read_header(base + (WEAR_LEVELING_LOGICAL_SIZE), &entry);
         // If we have a mismatch, clear the cache but do not flag a failure,
         // which will cater for the completely clean MCU case.
         if (entry.raw64 == expected) {
             wl_dprintf("Checksum matches, consolidated data is correct\n");
+            *valid = true;
         } else {
             wl_dprintf("Checksum mismatch, clearing cache\n");
             wear_leveling_clear_cache();
@@ -249,6 +429,81 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     return status;
 }
 
+/**
+ * Reads the consolidated data from the backing store into the cache, selecting the live area if there are two.
+ * Does not consider the write log.
+ */
+static wear_leveling_status_t wear_leveling_read_consolidated(void) {
+    bool     valid;
+    uint32_t sequence;
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+    // The second area first, so that the cache is left holding the first one's data unless the second is live
+    bool     other_valid;
+    uint32_t other_sequence;
+    if (wear_leveling_read_area((WEAR_LEVELING_AREA_SIZE), &other_valid, &other_sequence) == WEAR_LEVELING_FAILED) {
+        return WEAR_LEVELING_FAILED;
+    }
+    if (wear_leveling_read_area(0, &valid, &sequence) == WEAR_LEVELING_FAILED) {
+        return WEAR_LEVELING_FAILED;
+    }
+
+    // The previous area stays valid until the next consolidation erases it, so if both are the later one wins
+    wear_leveling.area_base = 0;
+    consolidation.sequence  = valid ? sequence : 0;
+    if (other_valid && (!valid || (int32_t)(other_sequence - sequence) > 0)) {
+        wear_leveling.area_base = (WEAR_LEVELING_AREA_SIZE);
+        consolidation.sequence  = other_sequence;
+        return wear_leveling_read_area((WEAR_LEVELING_AREA_SIZE), &valid, &sequence);
+    }
+    return WEAR_LEVELING_SUCCESS;
+#else  // WEAR_LEVELING_ASYNC_CONSOLIDATION
+    return wear_leveling_read_area(0, &valid, &sequence);
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+}
+
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+/**
+ * Forces a write of the current cache, into the other area.
+ * The live area stays valid until the other one is, so a power loss at any point loses nothing already written.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    wl_dprintf("Consolidating in-line\n");
+
+    // Nothing more is appended to the live log, it may end in a corrupt entry
+    wear_leveling.write_address = wear_leveling_log_end();
+    wear_leveling_consolidation_restart();
+    return wear_leveling_flush();
+}
+
+/**
+ * Potential scheduling of a consolidation.
+ * Scheduled once the write log is within WEAR_LEVELING_CONSOLIDATION_HEADROOM bytes of the end of the live area, so
+ * that writes made while consolidating can still be logged.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
+    if (wear_leveling.write_address + (WEAR_LEVELING_CONSOLIDATION_HEADROOM) >= wear_leveling_log_end()) {
+        wear_leveling_consolidation_start();
+    }
+
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Handles an entry which doesn't fit in the remainder of the write log, completing the consolidation in-line.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED if the cache, including the entry, is now consolidated
+ */
+static wear_leveling_status_t wear_leveling_log_full(void) {
+    if (consolidation.committing) {
+        // Logging into the other area, which isn't valid yet -- the consolidation is restarted
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wl_dprintf("Write log full, completing consolidation\n");
+    wear_leveling_consolidation_start();
+    return wear_leveling_flush();
+}
+#else  // WEAR_LEVELING_ASYNC_CONSOLIDATION
 /**
  * Writes the current cache to consolidated data at the beginning of the backing store.
  * Does not clear the write log.
@@ -269,24 +524,9 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
         write_log_entry_t entry;
         entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
         wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#endif
-        } while (0);
+        if (!wear_leveling_write_header((WEAR_LEVELING_LOGICAL_SIZE), &entry)) {
+            status = WEAR_LEVELING_FAILED;
+        }
     }
 
     if (lock_status == STATUS_SUCCESS) {
@@ -317,7 +557,7 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = wear_leveling_log_start();
 
     return status;
 }
@@ -330,12 +570,13 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+    if (wear_leveling.write_address >= wear_leveling_log_end()) {
         return wear_leveling_consolidate_force();
     }
 
     return WEAR_LEVELING_SUCCESS;
 }
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
 
 /**
  * Appends the supplied fixed-width entry to the write log, optionally consolidating if the log is full.
@@ -343,6 +584,11 @@ static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value) {
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+    if (wear_leveling.write_address + (BACKING_STORE_WRITE_SIZE) > wear_leveling_log_end()) {
+        return wear_leveling_log_full();
+    }
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
     bool ok = backing_store_write(wear_leveling.write_address, value);
     if (!ok) {
         wl_dprintf("Failed to write to backing store\n");
@@ -364,6 +610,20 @@ static wear_leveling_status_t wear_leveling_write_raw_multibyte(uint32_t address
         log.raw8[3 + i] = p[i];
     }
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+    // Playback expects complete entries -- rather than truncating this one at the end of the log, consolidate first
+#    if BACKING_STORE_WRITE_SIZE == 2
+    const uint32_t entry_size = length > 3 ? 8 : (length > 1 ? 6 : 4);
+#    elif BACKING_STORE_WRITE_SIZE == 4
+    const uint32_t entry_size = length > 1 ? 8 : 4;
+#    elif BACKING_STORE_WRITE_SIZE == 8
+    const uint32_t entry_size = 8;
+#    endif
+    if (wear_leveling.write_address + entry_size > wear_leveling_log_end()) {
+        return wear_leveling_log_full();
+    }
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
     // Write to the backing store. See the multi-byte log format in the documentation header at the top of the file.
     wear_leveling_status_t status;
 #if BACKING_STORE_WRITE_SIZE == 2
@@ -478,8 +738,8 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
     wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
     bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    uint32_t               address         = wear_leveling_log_start();
+    while (!cancel_playback && address < wear_leveling_log_end()) {
         backing_store_int_t value;
         bool                ok = backing_store_read(address, &value);
         if (!ok) {
@@ -618,6 +878,11 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 wear_leveling_status_t wear_leveling_init(void) {
     wl_dprintf("Init\n");
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+    // Anything still pending refers to the old cache contents
+    wear_leveling_consolidation_cancel();
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
     // Reset the cache
     wear_leveling_clear_cache();
 
@@ -662,6 +927,11 @@ wear_leveling_status_t wear_leveling_erase(void) {
 
     // Perform the erase
     bool ret = backing_store_erase();
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+    wear_leveling_consolidation_cancel();
+    wear_leveling.area_base = 0;
+    consolidation.sequence  = 0;
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
     wear_leveling_clear_cache();
 
     // Lock the backing store if we acquired the lock successfully
@@ -692,6 +962,13 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+    // Still logged in the live area below, but the other area needs it too if it's already past this address
+    if (consolidation.state != CONSOLIDATION_IDLE) {
+        wear_leveling_consolidation_mark_dirty(address, length);
+    }
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
@@ -744,6 +1021,160 @@ wear_leveling_status_t wear_leveling_read(const uint32_t address, void *value, s
     return WEAR_LEVELING_SUCCESS;
 }
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+/**
+ * Performs the next step of the consolidation. The backing store is already unlocked.
+ */
+static wear_leveling_status_t wear_leveling_consolidation_step(void) {
+    const uint32_t area = wear_leveling_consolidation_area();
+    switch (consolidation.state) {
+        case CONSOLIDATION_ERASE: {
+            // Only the other area is erased, the live one stays valid throughout
+            const uint32_t sector_count = backing_store_sector_count();
+            if (sector_count < 2 || sector_count % 2 != 0) {
+                // The areas can't be erased separately -- until the consolidation completes, nothing is valid
+                wl_dprintf("Erasing backing store\n");
+                if (!backing_store_erase()) {
+                    wl_dprintf("Failed to erase backing store\n");
+                    return WEAR_LEVELING_FAILED;
+                }
+            } else {
+                const uint32_t sector = area / ((WEAR_LEVELING_BACKING_SIZE) / sector_count) + consolidation.erased;
+                wl_dprintf("Erasing backing store sector %d\n", (int)sector);
+                if (!backing_store_erase_sector(sector)) {
+                    wl_dprintf("Failed to erase backing store\n");
+                    return WEAR_LEVELING_FAILED;
+                }
+                if (++consolidation.erased < sector_count / 2) {
+                    return WEAR_LEVELING_SUCCESS;
+                }
+            }
+
+            write_log_entry_t entry;
+            entry.raw64 = consolidation.sequence + 1;
+            wl_dprintf("Writing sequence number\n");
+            if (!wear_leveling_write_header(area + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &entry)) {
+                wl_dprintf("Failed to write sequence number\n");
+                wear_leveling_consolidation_restart();
+                return WEAR_LEVELING_FAILED;
+            }
+            consolidation.progress    = 0;
+            consolidation.checksum    = FNV1A_64_INIT;
+            consolidation.dirty_count = 0;
+            consolidation.state       = CONSOLIDATION_WRITE_DATA;
+            return WEAR_LEVELING_SUCCESS;
+        }
+
+        case CONSOLIDATION_WRITE_DATA: {
+            const uint32_t remaining = (WEAR_LEVELING_LOGICAL_SIZE) - consolidation.progress;
+            const uint32_t length    = remaining >= (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) ? (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) : remaining;
+            wl_dprintf("Writing consolidated data at 0x%04X\n", (int)consolidation.progress);
+            if (!backing_store_write_bulk(area + consolidation.progress, (backing_store_int_t *)&wear_leveling.cache[consolidation.progress], length / sizeof(backing_store_int_t))) {
+                // The area is partially written, it needs erasing again
+                wl_dprintf("Failed to write to backing store\n");
+                wear_leveling_consolidation_restart();
+                return WEAR_LEVELING_FAILED;
+            }
+            // Hash what was actually written, the cache may change before the rest is
+            consolidation.checksum = fnv_64a_buf(&wear_leveling.cache[consolidation.progress], length, consolidation.checksum);
+            consolidation.progress += length;
+            if (consolidation.progress >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                consolidation.state = CONSOLIDATION_WRITE_CHECKSUM;
+            }
+            return WEAR_LEVELING_SUCCESS;
+        }
+
+        case CONSOLIDATION_WRITE_CHECKSUM: {
+            // Whatever changed behind the write position goes to the other area's log before the checksum makes it valid
+            const uint32_t         live_base          = wear_leveling.area_base;
+            const uint32_t         live_write_address = wear_leveling.write_address;
+            wear_leveling_status_t status             = WEAR_LEVELING_SUCCESS;
+            wear_leveling.area_base                   = area;
+            wear_leveling.write_address               = wear_leveling_log_start();
+            consolidation.committing                  = true;
+            for (uint8_t i = 0; i < consolidation.dirty_count && status == WEAR_LEVELING_SUCCESS; ++i) {
+                const wear_leveling_range_t *range = &consolidation.dirty[i];
+                wl_dprintf("Logging writes made during consolidation at 0x%04X\n", (int)range->start);
+                status = wear_leveling_write_raw(range->start, &wear_leveling.cache[range->start], range->end - range->start);
+            }
+            consolidation.committing = false;
+
+            uint32_t          sequence = consolidation.sequence + 1;
+            write_log_entry_t entry;
+            entry.raw64 = fnv_64a_buf(&sequence, sizeof(sequence), consolidation.checksum);
+            if (status != WEAR_LEVELING_SUCCESS || !wear_leveling_write_header(area + (WEAR_LEVELING_LOGICAL_SIZE), &entry)) {
+                // Failed, or didn't fit in the log -- the live area is still the valid one, start over
+                wl_dprintf("Failed to complete consolidation\n");
+                wear_leveling.area_base     = live_base;
+                wear_leveling.write_address = live_write_address;
+                wear_leveling_consolidation_restart();
+                return WEAR_LEVELING_FAILED;
+            }
+            consolidation.sequence = sequence;
+            consolidation.state    = CONSOLIDATION_IDLE;
+
+            // Schedule the next one straight away if the writes made meanwhile ate into the headroom
+            wear_leveling_consolidate_if_needed();
+            return WEAR_LEVELING_CONSOLIDATED;
+        }
+
+        default:
+            return WEAR_LEVELING_SUCCESS;
+    }
+}
+
+/**
+ * Performs one step of a pending consolidation.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+    if (consolidation.state == CONSOLIDATION_IDLE) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = wear_leveling_consolidation_step();
+
+    // Lock the backing store if we acquired the lock successfully
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * Completes any pending consolidation.
+ */
+wear_leveling_status_t wear_leveling_flush(void) {
+    // Bounded, so that a backing store which keeps failing doesn't hang the caller
+    const uint32_t         max_steps = 2 * (backing_store_sector_count() + 1 + ((WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE)-1) / (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE));
+    wear_leveling_status_t status    = WEAR_LEVELING_SUCCESS;
+    for (uint32_t i = 0; i < max_steps && consolidation.state != CONSOLIDATION_IDLE; ++i) {
+        status = wear_leveling_task();
+        // Writes made during it may already have scheduled the next one, which can wait
+        if (status == WEAR_LEVELING_CONSOLIDATED) {
+            return status;
+        }
+    }
+    return consolidation.state == CONSOLIDATION_IDLE ? status : WEAR_LEVELING_FAILED;
+}
+
+/**
+ * Whether a consolidation is pending or in progress.
+ */
+bool wear_leveling_is_consolidating(void) {
+    return consolidation.state != CONSOLIDATION_IDLE;
+}
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
 /**
  * Weak implementation of bulk read, drivers can implement more optimised implementations.
  */
@@ -767,3 +1198,21 @@ __attribute__((weak)) bool backing_store_write_bulk(uint32_t address, backing_st
     }
     return true;
 }
+
+/**
+ * Weak implementation of the sector count, treating the whole backing store as one sector. Drivers which can erase
+ * part of the backing store can report their sector count, so that deferred consolidation erases a sector per step.
+ * Sectors must be the same size and together cover exactly WEAR_LEVELING_BACKING_SIZE bytes.
+ */
+__attribute__((weak)) uint32_t backing_store_sector_count(void) {
+    return 1;
+}
+
+/**
+ * Weak implementation of sector erase, which erases the whole backing store. Only used when more than one sector is
+ * reported.
+ */
+__attribute__((weak)) bool backing_store_erase_sector(uint32_t index) {
+    (void)index;
+    return backing_store_erase();
+}
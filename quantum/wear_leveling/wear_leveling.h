@@ -1,6 +1,7 @@
 // Copyright 2022 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 #pragma once
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -52,3 +53,33 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+/**
+ * Performs one step of a pending consolidation, if any.
+ *
+ * Once the write log is within WEAR_LEVELING_CONSOLIDATION_HEADROOM bytes of being full, consolidation into the other
+ * half of the backing store is deferred to this function rather than performed inside wear_leveling_write(). Each
+ * invocation performs a bounded amount of work: erasing one sector of the other half, writing
+ * WEAR_LEVELING_CONSOLIDATION_STEP_SIZE bytes of consolidated data, or committing it with its checksum. The current half
+ * stays valid until then, and writes made in the meantime are still appended to its log, so a power loss at any point
+ * keeps every completed write. If that log fills up first, the write completes the consolidation itself. Backing stores
+ * whose driver does not report an even number of sectors are erased in a single step, and are not protected.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED if consolidation completed during this call, WEAR_LEVELING_FAILED if the step
+ * failed and will be retried, otherwise WEAR_LEVELING_SUCCESS
+ */
+wear_leveling_status_t wear_leveling_task(void);
+
+/**
+ * Completes any pending consolidation before returning.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_flush(void);
+
+/**
+ * Whether a consolidation is pending or in progress.
+ */
+bool wear_leveling_is_consolidating(void);
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
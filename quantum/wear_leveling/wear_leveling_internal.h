@@ -59,20 +59,48 @@ typedef uint64_t backing_store_int_t;
         } while (0)
 #endif // WEAR_LEVELING_ASSERTS
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+#    ifndef WEAR_LEVELING_CONSOLIDATION_STEP_SIZE
+#        define WEAR_LEVELING_CONSOLIDATION_STEP_SIZE 64
+#    endif
+#    ifndef WEAR_LEVELING_DIRTY_RANGES
+#        define WEAR_LEVELING_DIRTY_RANGES 8
+#    endif
+#    ifndef WEAR_LEVELING_CONSOLIDATION_HEADROOM
+#        define WEAR_LEVELING_CONSOLIDATION_HEADROOM 64
+#    endif
+// The backing store is split into two areas, each holding consolidated data, its FNV1a_64 and sequence number, then a write log
+#    define WEAR_LEVELING_AREA_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    define WEAR_LEVELING_HEADER_SIZE 16
+#else // WEAR_LEVELING_ASYNC_CONSOLIDATION
+// The backing store holds consolidated data and its FNV1a_64, then the write log
+#    define WEAR_LEVELING_AREA_SIZE (WEAR_LEVELING_BACKING_SIZE)
+#    define WEAR_LEVELING_HEADER_SIZE 8
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
 // Compile-time validation of configurable options
 STATIC_ASSERT(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Total backing size must be at least twice the size of the logical size");
 STATIC_ASSERT(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 STATIC_ASSERT(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+STATIC_ASSERT(WEAR_LEVELING_CONSOLIDATION_STEP_SIZE > 0 && WEAR_LEVELING_CONSOLIDATION_STEP_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Consolidation step size must be a multiple of write size");
+STATIC_ASSERT(WEAR_LEVELING_DIRTY_RANGES > 0 && WEAR_LEVELING_DIRTY_RANGES <= UINT8_MAX, "Dirty range count must be between 1 and 255");
+STATIC_ASSERT(WEAR_LEVELING_BACKING_SIZE % (WEAR_LEVELING_LOGICAL_SIZE * 2) == 0, "Backing size must be a multiple of twice the logical size");
+STATIC_ASSERT(WEAR_LEVELING_AREA_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Each half of the backing size must be at least twice the size of the logical size");
+STATIC_ASSERT(WEAR_LEVELING_CONSOLIDATION_HEADROOM < WEAR_LEVELING_AREA_SIZE - WEAR_LEVELING_LOGICAL_SIZE - WEAR_LEVELING_HEADER_SIZE, "Consolidation headroom must be smaller than the write log");
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
 
 // Backing Store API, to be implemented elsewhere by flash driver etc.
-bool backing_store_init(void);
-bool backing_store_unlock(void);
-bool backing_store_erase(void);
-bool backing_store_write(uint32_t address, backing_store_int_t value);
-bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
-bool backing_store_lock(void);
-bool backing_store_read(uint32_t address, backing_store_int_t* value);
-bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
+bool     backing_store_init(void);
+bool     backing_store_unlock(void);
+bool     backing_store_erase(void);
+uint32_t backing_store_sector_count(void); // weak implementation already provided (one sector), drivers which erase in sectors can report how many
+bool     backing_store_erase_sector(uint32_t index); // weak implementation already provided (erases everything), drivers which erase in sectors can erase only the requested one
+bool     backing_store_write(uint32_t address, backing_store_int_t value);
+bool     backing_store_write_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
+bool     backing_store_lock(void);
+bool     backing_store_read(uint32_t address, backing_store_int_t* value);
+bool     backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
 
 /**
  * Helper type used to contain a write log entry.
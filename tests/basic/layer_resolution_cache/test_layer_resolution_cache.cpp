@@ -0,0 +1,149 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+
+static constexpr uint8_t TEST_LAYERS = 8;
+
+class LayerResolutionCache : public TestFixture {
+   protected:
+    /* Fill every position of every test layer, making roughly half of the upper layers transparent. */
+    void set_sparse_keymap(uint32_t seed) {
+        this->keymap.clear();
+        for (uint8_t layer = 0; layer < TEST_LAYERS; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    seed              = seed * 1103515245 + 12345;
+                    bool     opaque   = layer == 0 || ((seed >> 16) & 1);
+                    uint16_t keycode  = opaque ? KC_A + ((layer + row + col) % 26) : KC_TRNS;
+                    add_key(KeymapKey(layer, col, row, keycode));
+                }
+            }
+        }
+        layer_resolution_cache_invalidate();
+    }
+
+    /* Reference implementation: walk the whole layer stack from the top for every lookup. */
+    static uint8_t uncached_layer(keypos_t key) {
+        layer_state_t layers = layer_state | default_layer_state;
+        for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+            if ((layers & ((layer_state_t)1 << i)) && action_for_key(i, key).code != ACTION_TRANSPARENT) {
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    static void expect_matches_uncached(void) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keypos_t key = {.col = col, .row = row};
+                EXPECT_EQ(layer_switch_get_layer(key), uncached_layer(key)) << "layer_state " << layer_state << " default_layer_state " << default_layer_state << " at (" << +col << "," << +row << ")";
+            }
+        }
+    }
+};
+
+TEST_F(LayerResolutionCache, MatchesUncachedForEveryLayerState) {
+    TestDriver driver;
+    set_sparse_keymap(0x5eed);
+
+    EXPECT_NO_REPORT(driver);
+    for (layer_state_t state = 0; state < (1 << TEST_LAYERS); state++) {
+        layer_state_set(state);
+        expect_matches_uncached();
+    }
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, MatchesUncachedForEveryDefaultLayer) {
+    TestDriver driver;
+    set_sparse_keymap(0xc0ffee);
+
+    EXPECT_NO_REPORT(driver);
+    for (uint8_t layer = 0; layer < TEST_LAYERS; layer++) {
+        default_layer_set((layer_state_t)1 << layer);
+        for (layer_state_t state = 0; state < (1 << TEST_LAYERS); state += 7) {
+            layer_state_set(state);
+            expect_matches_uncached();
+        }
+    }
+    default_layer_set(1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, DirectLayerStateAssignmentIsDetected) {
+    TestDriver driver;
+    set_sparse_keymap(42);
+
+    EXPECT_NO_REPORT(driver);
+    layer_state_set(0b00000110);
+    expect_matches_uncached();
+    layer_state = 0b10100000;
+    expect_matches_uncached();
+    layer_clear();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, KeymapChangeIsPickedUpAfterKeyInvalidation) {
+    TestDriver driver;
+    set_sparse_keymap(7);
+    layer_state_set(0b11111110);
+    expect_matches_uncached();
+
+    /* Re-seed the keymap without a full invalidation, then drop every key individually as the dynamic keymap does. */
+    this->keymap.clear();
+    for (uint8_t layer = 0; layer < TEST_LAYERS; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(layer, col, row, layer == 0 ? KC_B : KC_TRNS));
+            }
+        }
+    }
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            layer_resolution_cache_invalidate_key(row, col);
+        }
+    }
+    expect_matches_uncached();
+    EXPECT_EQ(layer_switch_get_layer({.col = 0, .row = 0}), 0);
+
+    EXPECT_NO_REPORT(driver);
+    layer_clear();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, PressUsesResolvedLayer) {
+    TestDriver driver;
+    auto       key_base  = KeymapKey(0, 0, 0, KC_A);
+    auto       key_upper = KeymapKey(1, 0, 0, KC_B);
+    auto       key_trns  = KeymapKey(2, 0, 0, KC_TRNS);
+
+    set_keymap({key_base, key_upper, key_trns});
+    layer_resolution_cache_invalidate();
+
+    layer_state_set(0b110);
+    EXPECT_REPORT(driver, (KC_B));
+    key_upper.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_upper.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    layer_state_set(0b100);
+    EXPECT_REPORT(driver, (KC_A));
+    key_base.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_base.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,142 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_combos.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "process_combo.h"
+#include "keymap_introspection.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+static unsigned combo_lookups = 0;
+
+/* Override the weak introspection getters so the tests can grow the combo list and count lookups. */
+extern "C" uint16_t combo_count(void) {
+    return test_combo_count;
+}
+
+extern "C" combo_t* combo_get(uint16_t combo_idx) {
+    combo_lookups++;
+    return combo_get_raw(combo_idx);
+}
+
+class ComboKeyIndex : public TestFixture {
+   protected:
+    void SetUp() override {
+        test_combos_init();
+        test_combo_count = TEST_COMBO_MAX;
+    }
+
+    void TearDown() override {
+        test_combo_count = TEST_COMBO_MAX;
+    }
+
+    /* Number of combos looked up while feeding a single `keycode` event straight into process_combo. */
+    static unsigned lookups_for_event(uint16_t keycode, bool pressed) {
+        keyrecord_t record   = {};
+        record.event.key     = {.col = 9, .row = 3};
+        record.event.pressed = pressed;
+        record.event.type    = KEY_EVENT;
+        record.keycode       = keycode;
+        combo_lookups        = 0;
+        process_combo(keycode, &record);
+        return combo_lookups;
+    }
+
+    /* What a linear scan would find: the active combos containing `keycode`. */
+    static unsigned combos_containing(uint16_t keycode) {
+        unsigned count = 0;
+        for (uint16_t i = 0; i < test_combo_count; i++) {
+            for (const uint16_t* key = combo_get_raw(i)->keys; *key != COMBO_END; key++) {
+                if (*key == keycode) {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+};
+
+TEST_F(ComboKeyIndex, FirstAndLastCombosTrigger) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    KeymapKey  key_k(0, 2, 0, KC_K);
+    KeymapKey  key_z(0, 3, 0, KC_Z);
+    set_keymap({key_a, key_b, key_k, key_z});
+
+    /* combo 0 is A+B, combo 319 is K+Z */
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_k, key_z});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeyIndex, KeysOutsideAnyComboPassThrough) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_7(0, 0, 0, KC_7);
+    KeymapKey  key_9(0, 1, 0, KC_9);
+    set_keymap({key_7, key_9});
+
+    EXPECT_REPORT(driver, (KC_7));
+    EXPECT_REPORT(driver, (KC_7, KC_9));
+    EXPECT_REPORT(driver, (KC_9));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_7, key_9});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeyIndex, IndexFollowsComboCount) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b});
+
+    test_combo_count = 1;
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    VERIFY_AND_CLEAR(driver);
+
+    /* With no combos left the keys must pass through untouched */
+    test_combo_count = 0;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeyIndex, EventsOnlyVisitCombosWithTheirKey) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    for (uint16_t count : {10, 40, 80, 160, 320}) {
+        test_combo_count = count;
+        // The first event after a change in combo count rebuilds the index
+        lookups_for_event(KC_F1, true);
+
+        // Once for matching the event, once for clearing the combos it may have touched
+        EXPECT_EQ(lookups_for_event(KC_F1, true), 0) << count << " combos";
+        EXPECT_EQ(lookups_for_event(KC_A, false), 2 * combos_containing(KC_A)) << count << " combos";
+        EXPECT_EQ(lookups_for_event(KC_Z, false), 2 * combos_containing(KC_Z)) << count << " combos";
+    }
+    VERIFY_AND_CLEAR(driver);
+}
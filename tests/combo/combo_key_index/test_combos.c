@@ -0,0 +1,28 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+#include "test_combos.h"
+
+static const uint16_t combo_keycodes[] = {
+    KC_A, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L, KC_M, KC_N, KC_O, KC_P, KC_Q, KC_R,
+    KC_S, KC_T, KC_U, KC_V, KC_W, KC_X, KC_Y, KC_Z, KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0,
+};
+
+static uint16_t test_combo_keys[TEST_COMBO_MAX][3];
+uint16_t        test_combo_count = TEST_COMBO_MAX;
+
+combo_t key_combos[TEST_COMBO_MAX];
+
+/* Every pair of the keycodes above, in lexicographic order, as a two key combo sending KC_ESC. */
+void test_combos_init(void) {
+    uint16_t idx = 0;
+    for (uint8_t i = 0; i < ARRAY_SIZE(combo_keycodes) && idx < TEST_COMBO_MAX; i++) {
+        for (uint8_t j = i + 1; j < ARRAY_SIZE(combo_keycodes) && idx < TEST_COMBO_MAX; j++, idx++) {
+            test_combo_keys[idx][0] = combo_keycodes[i];
+            test_combo_keys[idx][1] = combo_keycodes[j];
+            test_combo_keys[idx][2] = COMBO_END;
+            key_combos[idx]         = (combo_t)COMBO(test_combo_keys[idx], KC_ESC);
+        }
+    }
+}
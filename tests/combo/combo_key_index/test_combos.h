@@ -0,0 +1,20 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+#define TEST_COMBO_MAX 320
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint16_t test_combo_count;
+
+void test_combos_init(void);
+
+#ifdef __cplusplus
+}
+#endif
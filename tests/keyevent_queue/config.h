@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define KEYEVENT_QUEUE_SIZE 4
+#define KEYEVENT_QUEUE_DRAIN_MAX 2
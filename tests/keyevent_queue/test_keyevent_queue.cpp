@@ -0,0 +1,179 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <thread>
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "keyevent_queue.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+static constexpr uint32_t PRODUCER_EVENTS = 200000;
+
+class KeyEventQueue : public TestFixture {};
+
+static keyevent_t make_sequenced_event(uint32_t sequence) {
+    keyevent_t event = {};
+    event.key.row    = (sequence >> 8) % MATRIX_ROWS;
+    event.key.col    = sequence & 0xFF;
+    event.time       = (uint16_t)sequence;
+    event.type       = KEY_EVENT;
+    event.pressed    = sequence & 1;
+    return event;
+}
+
+TEST_F(KeyEventQueue, RejectsPushWhenFull) {
+    keyevent_queue_clear();
+    for (uint32_t i = 0; i < KEYEVENT_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(keyevent_queue_push(make_sequenced_event(i)));
+    }
+    EXPECT_EQ(keyevent_queue_count(), KEYEVENT_QUEUE_SIZE);
+    EXPECT_FALSE(keyevent_queue_push(make_sequenced_event(KEYEVENT_QUEUE_SIZE)));
+
+    keyevent_t event;
+    for (uint32_t i = 0; i < KEYEVENT_QUEUE_SIZE; i++) {
+        ASSERT_TRUE(keyevent_queue_pop(&event));
+        EXPECT_EQ(event.time, i);
+    }
+    EXPECT_FALSE(keyevent_queue_pop(&event));
+    EXPECT_TRUE(keyevent_queue_is_empty());
+}
+
+TEST_F(KeyEventQueue, ConcurrentProducerKeepsOrderAndTimestamps) {
+    keyevent_queue_clear();
+
+    /* Simulated scan thread: spins on a full queue, so it is constantly under backpressure. */
+    uint32_t    producer_retries = 0;
+    std::thread producer([&producer_retries]() {
+        for (uint32_t i = 0; i < PRODUCER_EVENTS; i++) {
+            while (!keyevent_queue_push(make_sequenced_event(i))) {
+                producer_retries++;
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    keyevent_t event;
+    for (uint32_t expected = 0; expected < PRODUCER_EVENTS;) {
+        if (!keyevent_queue_pop(&event)) {
+            std::this_thread::yield();
+            continue;
+        }
+        keyevent_t reference = make_sequenced_event(expected);
+        ASSERT_EQ(event.time, reference.time) << "event " << expected << " out of order";
+        ASSERT_TRUE(KEYEQ(event.key, reference.key));
+        ASSERT_EQ(event.pressed, reference.pressed);
+        expected++;
+    }
+    producer.join();
+
+    EXPECT_TRUE(keyevent_queue_is_empty());
+    EXPECT_GT(producer_retries, 0u);
+}
+
+TEST_F(KeyEventQueue, MatrixChangesBeyondQueueSizeAreDeferredInOrder) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+    auto       key_d = KeymapKey(0, 3, 1, KC_D);
+    auto       key_e = KeymapKey(0, 4, 1, KC_E);
+    auto       key_f = KeymapKey(0, 5, 2, KC_F);
+
+    set_keymap({key_a, key_b, key_c, key_d, key_e, key_f});
+
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    key_d.press();
+    key_e.press();
+    key_f.press();
+
+    /* Only KEYEVENT_QUEUE_SIZE events fit in the first scan, and only
+     * KEYEVENT_QUEUE_DRAIN_MAX of them are processed in the same loop */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    keyboard_task();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(keyevent_queue_count(), 2);
+
+    /* The next scan queues the rest behind the backlog */
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D));
+    keyboard_task();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(keyevent_queue_count(), 2);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E, KC_F));
+    keyboard_task();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(keyevent_queue_is_empty());
+
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    key_d.release();
+    key_e.release();
+    key_f.release();
+    EXPECT_REPORT(driver, (KC_B, KC_C, KC_D, KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_C, KC_D, KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_D, KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_F));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyEventQueue, ScanTimestampsSurviveTheBacklog) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({key_a, key_b, key_c});
+
+    EXPECT_ANY_REPORT(driver).Times(3);
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    const uint16_t scanned = timer_read();
+    keyboard_task();
+
+    /* The third press waits in the queue, stamped with the scan that saw it */
+    keyevent_t event;
+    ASSERT_EQ(keyevent_queue_count(), 1);
+    ASSERT_TRUE(keyevent_queue_pop(&event));
+    EXPECT_EQ(event.time, scanned);
+    EXPECT_TRUE(KEYEQ(event.key, key_c.position));
+
+    action_exec(event);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyEventQueue, TappingStillResolvesThroughQueue) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap = KeymapKey(0, 0, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,153 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+
+extern "C" {
+#include "latency_stats.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class LatencyStats : public TestFixture {
+   public:
+    void SetUp() override {
+        latency_stats_reset();
+    }
+};
+
+TEST_F(LatencyStats, BucketsAreMonotonicAndCoverTheirValues) {
+    for (uint8_t bucket = 1; bucket < LATENCY_STATS_BUCKETS; bucket++) {
+        EXPECT_GT(latency_stats_bucket_lower_bound(bucket), latency_stats_bucket_lower_bound(bucket - 1));
+    }
+
+    for (uint32_t value : {0u, 1u, 3u, 4u, 7u, 8u, 9u, 1000u, 1023u, 1024u, 5000u, 123456u}) {
+        latency_stats_reset();
+        latency_stats_record(LATENCY_STAGE_SCAN_TO_HOST, value);
+        uint8_t bucket = 0;
+        while (!latency_stats_get_bucket(LATENCY_STAGE_SCAN_TO_HOST, bucket)) {
+            bucket++;
+        }
+        EXPECT_LE(latency_stats_bucket_lower_bound(bucket), value);
+        EXPECT_GT(latency_stats_bucket_lower_bound(bucket + 1), value);
+        // Four sub-buckets per power of two keep the relative error under 25%
+        EXPECT_LT(value - latency_stats_bucket_lower_bound(bucket), value / 4 + 1);
+    }
+}
+
+TEST_F(LatencyStats, PercentilesFollowTheDistribution) {
+    for (uint32_t i = 0; i < 98; i++) {
+        latency_stats_record(LATENCY_STAGE_SCAN_TO_HOST, 1000);
+    }
+    latency_stats_record(LATENCY_STAGE_SCAN_TO_HOST, 20000);
+    latency_stats_record(LATENCY_STAGE_SCAN_TO_HOST, 30000);
+
+    latency_summary_t summary;
+    latency_stats_get(LATENCY_STAGE_SCAN_TO_HOST, &summary);
+    EXPECT_EQ(summary.count, 100);
+    EXPECT_GE(summary.p50, 1000);
+    EXPECT_LT(summary.p50, 1250);
+    EXPECT_GE(summary.p99, 20000);
+    EXPECT_LT(summary.p99, 25000);
+    EXPECT_EQ(summary.max, 30000);
+
+    latency_stats_get(LATENCY_STAGE_HOST_TO_ENDPOINT, &summary);
+    EXPECT_EQ(summary.count, 0);
+    EXPECT_EQ(summary.p99, 0);
+}
+
+TEST_F(LatencyStats, PlainKeyIsReportedInTheSameScan) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_summary_t summary;
+    for (uint8_t stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+        latency_stats_get((latency_stage_t)stage, &summary);
+        EXPECT_EQ(summary.count, 2);
+        EXPECT_EQ(summary.max, 0);
+    }
+}
+
+TEST_F(LatencyStats, HeldModTapIsReportedAfterTappingTerm) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_summary_t summary;
+    latency_stats_get(LATENCY_STAGE_SCAN_TO_HOST, &summary);
+    EXPECT_EQ(summary.count, 2);
+    EXPECT_GE(summary.max, TAPPING_TERM * 1000);
+    EXPECT_LE(summary.max, (TAPPING_TERM + 2) * 1000);
+    const uint32_t scan_to_host = summary.max;
+
+    // The test driver sends reports straight away, so the endpoint sees them as soon as they are queued
+    latency_stats_get(LATENCY_STAGE_HOST_TO_ENDPOINT, &summary);
+    EXPECT_EQ(summary.count, 2);
+    EXPECT_EQ(summary.max, 0);
+    latency_stats_get(LATENCY_STAGE_SCAN_TO_ENDPOINT, &summary);
+    EXPECT_EQ(summary.count, 2);
+    EXPECT_EQ(summary.max, scan_to_host);
+}
+
+TEST_F(LatencyStats, EventWithoutReportIsNotChargedToTheNextOne) {
+    TestDriver driver;
+    InSequence s;
+    auto       layer_key = KeymapKey(0, 0, 0, MO(1));
+    auto       key       = KeymapKey(1, 1, 0, KC_A);
+
+    set_keymap({layer_key, key, KeymapKey(0, 1, 0, KC_B)});
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    idle_for(1000);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_summary_t summary;
+    latency_stats_get(LATENCY_STAGE_SCAN_TO_HOST, &summary);
+    EXPECT_EQ(summary.count, 1);
+    EXPECT_LE(summary.max, 1000);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,8 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/* Large analog/hall-effect style matrix, with 32-bit rows. */
+#define MATRIX_ROWS 24
+#define MATRIX_COLS 24
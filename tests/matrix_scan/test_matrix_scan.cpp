@@ -0,0 +1,138 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_matrix.h"
+
+using testing::_;
+using testing::InSequence;
+
+struct processed_event_t {
+    uint8_t row;
+    uint8_t col;
+    bool    pressed;
+
+    bool operator==(const processed_event_t& other) const {
+        return row == other.row && col == other.col && pressed == other.pressed;
+    }
+};
+
+static std::vector<processed_event_t> processed;
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t* record) {
+    processed.push_back({record->event.key.row, record->event.key.col, record->event.pressed});
+    return true;
+}
+
+class MatrixScan : public TestFixture {
+   public:
+    void SetUp() override {
+        processed.clear();
+    }
+};
+
+TEST_F(MatrixScan, ChangesInOneScanAreProcessedInMatrixOrder) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 3, 0, KC_A);
+    auto       key_b = KeymapKey(0, 20, 0, KC_B);
+    auto       key_c = KeymapKey(0, 5, 17, KC_C);
+    auto       key_d = KeymapKey(0, 23, 23, KC_D);
+
+    set_keymap({key_a, key_b, key_c, key_d});
+
+    key_d.press();
+    key_c.press();
+    key_b.press();
+    key_a.press();
+    EXPECT_REPORT(driver, (key_a.report_code));
+    EXPECT_REPORT(driver, (key_a.report_code, key_b.report_code));
+    EXPECT_REPORT(driver, (key_a.report_code, key_b.report_code, key_c.report_code));
+    EXPECT_REPORT(driver, (key_a.report_code, key_b.report_code, key_c.report_code, key_d.report_code));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    key_b.release();
+    key_d.release();
+    EXPECT_REPORT(driver, (key_a.report_code, key_c.report_code, key_d.report_code));
+    EXPECT_REPORT(driver, (key_a.report_code, key_c.report_code));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    key_a.release();
+    key_c.release();
+    EXPECT_REPORT(driver, (key_c.report_code));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixScan, UnchangedMatrixProducesNoEvents) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 12, 12, KC_NO);
+
+    set_keymap({key});
+
+    EXPECT_NO_REPORT(driver);
+    key.press();
+    for (unsigned i = 0; i < 1000; i++) {
+        keyboard_task();
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    // Only the scan that saw the press produced an event
+    ASSERT_EQ(processed.size(), 1);
+    EXPECT_EQ(processed[0], (processed_event_t{12, 12, true}));
+    key.release();
+    run_one_scan_loop();
+}
+
+TEST_F(MatrixScan, RandomChangesMatchAFullMatrixDiff) {
+    TestDriver   driver;
+    std::mt19937 rng(1);
+    bool         state[MATRIX_ROWS][MATRIX_COLS]    = {};
+    bool         previous[MATRIX_ROWS][MATRIX_COLS] = {};
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            add_key(KeymapKey(0, col, row, KC_NO));
+        }
+    }
+
+    EXPECT_NO_REPORT(driver);
+    for (unsigned scan = 0; scan < 2000; scan++) {
+        // Toggle a few random keys, sometimes none
+        for (unsigned toggles = rng() % 4; toggles > 0; toggles--) {
+            uint8_t row = rng() % MATRIX_ROWS;
+            uint8_t col = rng() % MATRIX_COLS;
+            if (state[row][col]) {
+                release_key(col, row);
+            } else {
+                press_key(col, row);
+            }
+            state[row][col] = !state[row][col];
+        }
+
+        // The reference walks every key in matrix order and compares it with the last scan
+        std::vector<processed_event_t> expected;
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (state[row][col] != previous[row][col]) {
+                    expected.push_back({row, col, state[row][col]});
+                    previous[row][col] = state[row][col];
+                }
+            }
+        }
+
+        processed.clear();
+        keyboard_task();
+        ASSERT_EQ(processed, expected) << "at scan " << scan;
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    clear_all_keys();
+    run_one_scan_loop();
+}
@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Room for eeconfig plus the scratch area used by the tests
+#define EEPROM_SIZE 1024
+
+#define NVM_WRITE_BACK_DELAY 100
@@ -0,0 +1,166 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeconfig.h"
+#include "eeprom.h"
+#include "eeprom_test.h"
+#include "nvm_write_back.h"
+#include "nvm_eeprom_write_back_internal.h"
+#include "quantum.h"
+}
+
+using testing::_;
+
+// Well clear of eeconfig, so these don't merge with anything else
+#define SCRATCH(offset) ((uint8_t *)(uintptr_t)(0x200 + (offset)))
+
+class NvmWriteBack : public TestFixture {
+   protected:
+    void SetUp() override {
+        nvm_write_back_flush();
+        eeprom_test_reset_write_count();
+    }
+};
+
+TEST_F(NvmWriteBack, RepeatedUpdatesCoalesceIntoOneWrite) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    for (uint32_t i = 1; i <= 50; i++) {
+        eeconfig_update_user(i);
+    }
+    EXPECT_TRUE(nvm_write_back_pending());
+    EXPECT_EQ(eeprom_test_get_write_count(), 0);
+
+    // Reads see the pending value
+    EXPECT_EQ(eeconfig_read_user(), 50);
+
+    idle_for(NVM_WRITE_BACK_DELAY + 1);
+    EXPECT_FALSE(nvm_write_back_pending());
+    EXPECT_EQ(eeprom_test_get_write_count(), 1);
+
+    // Nothing left in RAM, so this comes from the EEPROM
+    nvm_write_back_discard();
+    EXPECT_EQ(eeconfig_read_user(), 50);
+}
+
+TEST_F(NvmWriteBack, UnchangedUpdatesAreDropped) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    uint32_t value = eeconfig_read_user();
+    eeconfig_update_user(value);
+    EXPECT_FALSE(nvm_write_back_pending());
+    idle_for(NVM_WRITE_BACK_DELAY + 1);
+    EXPECT_EQ(eeprom_test_get_write_count(), 0);
+}
+
+TEST_F(NvmWriteBack, QuietPeriodRestartsOnEachUpdate) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    for (int i = 0; i < 5; i++) {
+        nvm_eeprom_update_byte(SCRATCH(0), 0x10 + i);
+        idle_for(NVM_WRITE_BACK_DELAY - 1);
+        EXPECT_EQ(eeprom_test_get_write_count(), 0);
+    }
+    idle_for(2);
+    EXPECT_EQ(eeprom_test_get_write_count(), 1);
+    EXPECT_EQ(eeprom_read_byte(SCRATCH(0)), 0x14);
+}
+
+TEST_F(NvmWriteBack, AdjacentAndOverlappingWritesMerge) {
+    uint8_t a[] = {1, 2, 3, 4};
+    uint8_t b[] = {5, 6, 7, 8};
+    uint8_t c[] = {9, 10};
+    nvm_eeprom_update_block(a, SCRATCH(0), sizeof(a));
+    nvm_eeprom_update_block(b, SCRATCH(8), sizeof(b));
+    // Bridges the gap between the two, and overlaps both
+    uint8_t bridge[] = {11, 12, 13, 14, 15, 16};
+    nvm_eeprom_update_block(bridge, SCRATCH(3), sizeof(bridge));
+    nvm_eeprom_update_block(c, SCRATCH(11), sizeof(c));
+
+    nvm_write_back_flush();
+    EXPECT_EQ(eeprom_test_get_write_count(), 1);
+
+    uint8_t expected[] = {1, 2, 3, 11, 12, 13, 14, 15, 16, 6, 7, 9, 10};
+    uint8_t actual[sizeof(expected)];
+    eeprom_read_block(actual, SCRATCH(0), sizeof(actual));
+    EXPECT_EQ(memcmp(actual, expected, sizeof(expected)), 0);
+}
+
+TEST_F(NvmWriteBack, FlushIsABarrier) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    nvm_eeprom_update_byte(SCRATCH(0), 0xA5);
+    nvm_eeprom_update_byte(SCRATCH(100), 0x5A);
+    nvm_write_back_flush();
+    EXPECT_FALSE(nvm_write_back_pending());
+    EXPECT_EQ(eeprom_test_get_write_count(), 2);
+    EXPECT_EQ(eeprom_read_byte(SCRATCH(0)), 0xA5);
+    EXPECT_EQ(eeprom_read_byte(SCRATCH(100)), 0x5A);
+
+    // Nothing left to do afterwards
+    nvm_write_back_flush();
+    idle_for(NVM_WRITE_BACK_DELAY + 1);
+    EXPECT_EQ(eeprom_test_get_write_count(), 2);
+}
+
+TEST_F(NvmWriteBack, OutOfRangesEvictsLeastRecentlyUsed) {
+    for (uint8_t i = 0; i < 4; i++) {
+        nvm_eeprom_update_byte(SCRATCH(i * 64), 0x20 + i);
+    }
+    // Refresh the first so the second becomes the oldest
+    nvm_eeprom_update_byte(SCRATCH(0), 0x30);
+    EXPECT_EQ(eeprom_test_get_write_count(), 0);
+
+    nvm_eeprom_update_byte(SCRATCH(4 * 64), 0x24);
+    EXPECT_EQ(eeprom_test_get_write_count(), 1);
+    EXPECT_EQ(eeprom_read_byte(SCRATCH(64)), 0x21);
+    EXPECT_NE(eeprom_read_byte(SCRATCH(0)), 0x30);
+
+    nvm_write_back_flush();
+    EXPECT_EQ(eeprom_test_get_write_count(), 5);
+    EXPECT_EQ(eeprom_read_byte(SCRATCH(0)), 0x30);
+    EXPECT_EQ(eeprom_read_byte(SCRATCH(4 * 64)), 0x24);
+}
+
+TEST_F(NvmWriteBack, LargeWritesGoStraightThrough) {
+    nvm_eeprom_update_byte(SCRATCH(10), 0x77);
+
+    uint8_t large[64];
+    memset(large, 0x42, sizeof(large));
+    nvm_eeprom_update_block(large, SCRATCH(0), sizeof(large));
+    EXPECT_EQ(eeprom_test_get_write_count(), 1);
+
+    // The pending byte was superseded, so flushing it mustn't undo the large write
+    nvm_write_back_flush();
+    EXPECT_EQ(eeprom_read_byte(SCRATCH(10)), 0x42);
+}
+
+TEST_F(NvmWriteBack, SuspendFlushes) {
+    nvm_eeprom_update_byte(SCRATCH(0), 0x99);
+    suspend_power_down_quantum();
+    EXPECT_FALSE(nvm_write_back_pending());
+    EXPECT_EQ(eeprom_read_byte(SCRATCH(0)), 0x99);
+}
+
+TEST_F(NvmWriteBack, EraseDiscardsPendingWrites) {
+    nvm_eeprom_update_byte(SCRATCH(0), 0x66);
+    eeconfig_disable();
+    EXPECT_NE(nvm_eeprom_read_byte(SCRATCH(0)), 0x66);
+    EXPECT_TRUE(eeconfig_is_disabled());
+
+    // Only the disable marker is written back
+    nvm_write_back_flush();
+    EXPECT_EQ(eeprom_test_get_write_count(), 1);
+    EXPECT_NE(eeprom_read_byte(SCRATCH(0)), 0x66);
+
+    eeconfig_init();
+    nvm_write_back_flush();
+    EXPECT_TRUE(eeconfig_is_enabled());
+}
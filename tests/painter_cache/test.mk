@@ -0,0 +1,10 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+QUANTUM_PAINTER_ENABLE = yes
+QUANTUM_PAINTER_DRIVERS = surface
+
+# Assets are built from the keyboards that ship them
+VPATH += keyboards/tzarc/djinn/graphics
+
+SRC += thintel15.qff.c lock-caps-ON.qgf.c
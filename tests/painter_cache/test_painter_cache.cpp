@@ -0,0 +1,362 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal_driver.h"
+#include "qp_draw.h"
+#include "qgf.h"
+#include "thintel15.qff.h"
+#include "lock-caps-ON.qgf.h"
+}
+
+namespace {
+
+constexpr uint16_t PANEL_WIDTH  = 240;
+constexpr uint16_t PANEL_HEIGHT = 320;
+
+// An RGB565 panel which keeps what's drawn to it, and counts how many pixels are decoded and sent
+struct mock_panel_t {
+    painter_driver_t      base;
+    uint16_t              l, t, r, b;
+    uint16_t              x, y;
+    uint32_t              pixels_decoded;
+    uint32_t              pixels_sent;
+    std::vector<uint16_t> framebuffer;
+};
+
+mock_panel_t panel;
+
+bool mock_comms_init(painter_device_t device) {
+    return true;
+}
+
+bool mock_comms_start(painter_device_t device) {
+    return true;
+}
+
+bool mock_comms_stop(painter_device_t device) {
+    return true;
+}
+
+uint32_t mock_comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
+    return byte_count;
+}
+
+const painter_comms_vtable_t mock_comms_vtable = {
+    .comms_init  = mock_comms_init,
+    .comms_start = mock_comms_start,
+    .comms_stop  = mock_comms_stop,
+    .comms_send  = mock_comms_send,
+};
+
+bool mock_panel_init(painter_device_t device, painter_rotation_t rotation) {
+    return true;
+}
+
+bool mock_panel_power(painter_device_t device, bool power_on) {
+    return true;
+}
+
+bool mock_panel_clear(painter_device_t device) {
+    return true;
+}
+
+bool mock_panel_flush(painter_device_t device) {
+    return true;
+}
+
+bool mock_panel_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    panel.l = panel.x = left;
+    panel.t = panel.y = top;
+    panel.r           = right;
+    panel.b           = bottom;
+    return true;
+}
+
+bool mock_panel_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    const uint16_t *pixels = (const uint16_t *)pixel_data;
+    for (uint32_t i = 0; i < native_pixel_count; ++i) {
+        if (panel.x < PANEL_WIDTH && panel.y < PANEL_HEIGHT) {
+            panel.framebuffer[panel.y * PANEL_WIDTH + panel.x] = pixels[i];
+        }
+        if (++panel.x > panel.r) {
+            panel.x = panel.l;
+            if (++panel.y > panel.b) {
+                panel.y = panel.t;
+            }
+        }
+    }
+    panel.pixels_sent += native_pixel_count;
+    return true;
+}
+
+bool mock_panel_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    for (int16_t i = 0; i < palette_size; ++i) {
+        hsv_t hsv         = palette[i].hsv888;
+        palette[i].rgb565 = ((uint16_t)(hsv.h ^ hsv.s) << 8) | hsv.v;
+    }
+    return true;
+}
+
+bool mock_panel_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    uint16_t *buf = (uint16_t *)target_buffer;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        buf[pixel_offset + i] = palette[palette_indices[i]].rgb565;
+    }
+    panel.pixels_decoded += pixel_count;
+    return true;
+}
+
+bool mock_panel_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    target_buffer[pixdata_offset] = pixdata_byte;
+    return true;
+}
+
+const painter_driver_vtable_t mock_panel_vtable = {
+    .init            = mock_panel_init,
+    .power           = mock_panel_power,
+    .clear           = mock_panel_clear,
+    .flush           = mock_panel_flush,
+    .viewport        = mock_panel_viewport,
+    .pixdata         = mock_panel_pixdata,
+    .palette_convert = mock_panel_palette_convert,
+    .append_pixels   = mock_panel_append_pixels,
+    .append_pixdata  = mock_panel_append_pixdata,
+};
+
+// Number of palette conversions the block decoder makes for the first frame of an RLE-compressed QGF image. Literal
+// bytes convert every pixel, while a repeated byte whose pixels all share a palette entry is converted once per span
+// and then copied.
+uint32_t image_conversions(const uint8_t *data) {
+    qp_memory_stream_t stream = qp_make_memory_stream((void *)data, sizeof(qgf_graphics_descriptor_v1_t));
+    stream.length             = qgf_get_total_size((qp_stream_t *)&stream);
+    stream.position           = 0;
+
+    uint16_t width, height, frame_count;
+    EXPECT_TRUE(qgf_read_graphics_descriptor((qp_stream_t *)&stream, &width, &height, &frame_count, NULL));
+    qgf_seek_to_frame_descriptor((qp_stream_t *)&stream, 0);
+
+    qgf_frame_v1_t        frame;
+    uint8_t               bpp;
+    bool                  has_palette, is_panel_native, is_delta;
+    painter_compression_t compression;
+    uint16_t              delay;
+    EXPECT_EQ(qp_stream_read(&frame, sizeof(frame), 1, &stream), 1u);
+    EXPECT_TRUE(qgf_parse_frame_descriptor(&frame, &bpp, &has_palette, &is_panel_native, &is_delta, &compression, &delay));
+    EXPECT_FALSE(has_palette);
+    EXPECT_EQ(compression, IMAGE_COMPRESSED_RLE);
+    qp_stream_seek(&stream, sizeof(qgf_data_v1_t), SEEK_CUR);
+
+    const uint8_t pixels_per_byte = 8 / bpp;
+    const uint8_t mask            = (1 << bpp) - 1;
+    uint32_t      pixel_count     = (uint32_t)width * height;
+    uint32_t      conversions     = 0;
+    while (pixel_count > 0) {
+        int16_t marker    = qp_stream_get(&stream);
+        bool    repeating = marker < 128;
+        uint8_t remain    = repeating ? marker : marker - 127;
+        uint8_t value     = repeating ? qp_stream_get(&stream) : 0;
+        bool    uniform   = repeating && value == (value & mask) * (0xFF / mask);
+        while (remain > 0 && pixel_count > 0) {
+            uint32_t bytes_left = (pixel_count + pixels_per_byte - 1) / pixels_per_byte;
+            uint8_t  count      = std::min<uint32_t>({remain, QP_DECODE_BLOCK_BYTES, bytes_left});
+            uint32_t span       = std::min<uint32_t>(count * pixels_per_byte, pixel_count);
+            conversions += uniform ? 1 : span;
+            if (!repeating) {
+                qp_stream_seek(&stream, count, SEEK_CUR);
+            }
+            remain -= count;
+            pixel_count -= span;
+        }
+    }
+    return conversions;
+}
+
+} // namespace
+
+class PainterCache : public ::testing::Test {
+   protected:
+    painter_device_t       device = &panel;
+    painter_font_handle_t  font   = nullptr;
+    painter_image_handle_t image  = nullptr;
+
+    void SetUp() override {
+        panel.base                       = {};
+        panel.base.driver_vtable         = &mock_panel_vtable;
+        panel.base.comms_vtable          = &mock_comms_vtable;
+        panel.base.panel_width           = PANEL_WIDTH;
+        panel.base.panel_height          = PANEL_HEIGHT;
+        panel.base.native_bits_per_pixel = 16;
+        panel.framebuffer.assign(PANEL_WIDTH * PANEL_HEIGHT, 0);
+        ASSERT_TRUE(qp_init(device, QP_ROTATION_0));
+
+        font = qp_load_font_mem(font_thintel15);
+        ASSERT_NE(font, nullptr);
+        image = qp_load_image_mem(gfx_lock_caps_ON);
+        ASSERT_NE(image, nullptr);
+        reset();
+    }
+
+    void TearDown() override {
+        // Closing the assets also drops their cache entries, so every test starts cold
+        qp_close_font(font);
+        qp_close_image(image);
+    }
+
+    void reset() {
+        panel.pixels_decoded = 0;
+        panel.pixels_sent    = 0;
+    }
+
+    std::vector<uint16_t> take_framebuffer() {
+        std::vector<uint16_t> contents = panel.framebuffer;
+        panel.framebuffer.assign(PANEL_WIDTH * PANEL_HEIGHT, 0);
+        return contents;
+    }
+};
+
+TEST_F(PainterCache, RepeatedTextSkipsDecoding) {
+    // No repeated glyphs, so every pixel is decoded once
+    int16_t width = qp_drawtext(device, 0, 0, font, "Layer: 5");
+    EXPECT_GT(width, 0);
+    EXPECT_EQ(panel.pixels_decoded, (uint32_t)width * font->line_height);
+    std::vector<uint16_t> first = take_framebuffer();
+
+    reset();
+    EXPECT_EQ(qp_drawtext(device, 0, 0, font, "Layer: 5"), width);
+    EXPECT_EQ(panel.pixels_decoded, 0u);
+    EXPECT_EQ(panel.pixels_sent, (uint32_t)width * font->line_height);
+    EXPECT_EQ(take_framebuffer(), first);
+}
+
+TEST_F(PainterCache, RepeatedGlyphsInOneStringAreDecodedOnce) {
+    int16_t glyph_width = qp_textwidth(font, "8");
+    qp_drawtext(device, 0, 0, font, "888");
+    EXPECT_EQ(panel.pixels_decoded, (uint32_t)glyph_width * font->line_height);
+}
+
+TEST_F(PainterCache, CachedGlyphsMatchAtOtherPositions) {
+    qp_drawtext(device, 10, 20, font, "WPM 123");
+    std::vector<uint16_t> expected = take_framebuffer();
+
+    qp_drawtext(device, 0, 0, font, "123 WPM");
+    take_framebuffer();
+
+    reset();
+    qp_drawtext(device, 10, 20, font, "WPM 123");
+    EXPECT_EQ(panel.pixels_decoded, 0u);
+    EXPECT_EQ(take_framebuffer(), expected);
+}
+
+TEST_F(PainterCache, ColorsAreCachedSeparately) {
+    qp_drawtext_recolor(device, 0, 0, font, "A", 0, 255, 255, 0, 0, 0);
+    std::vector<uint16_t> red = take_framebuffer();
+    uint32_t              decoded = panel.pixels_decoded;
+
+    reset();
+    qp_drawtext_recolor(device, 0, 0, font, "A", 85, 255, 255, 0, 0, 0);
+    EXPECT_EQ(panel.pixels_decoded, decoded);
+    EXPECT_NE(take_framebuffer(), red);
+
+    reset();
+    qp_drawtext_recolor(device, 0, 0, font, "A", 0, 255, 255, 0, 0, 0);
+    EXPECT_EQ(panel.pixels_decoded, 0u);
+    EXPECT_EQ(take_framebuffer(), red);
+}
+
+TEST_F(PainterCache, RepeatedImageSkipsDecoding) {
+    uint32_t pixel_count = (uint32_t)image->width * image->height;
+    EXPECT_TRUE(qp_drawimage(device, 50, 60, image));
+    EXPECT_EQ(panel.pixels_decoded, image_conversions(gfx_lock_caps_ON));
+    std::vector<uint16_t> first = take_framebuffer();
+
+    reset();
+    EXPECT_TRUE(qp_drawimage(device, 50, 60, image));
+    EXPECT_EQ(panel.pixels_decoded, 0u);
+    EXPECT_EQ(panel.pixels_sent, pixel_count);
+    EXPECT_EQ(take_framebuffer(), first);
+}
+
+TEST_F(PainterCache, LeastRecentlyUsedIsEvicted) {
+    // Each recolored copy of the image takes half of the cache
+    ASSERT_EQ((uint32_t)image->width * image->height * 2, QUANTUM_PAINTER_CACHE_SIZE / 2);
+    qp_drawimage_recolor(device, 0, 0, image, 0, 0, 255, 0, 0, 0);
+    qp_drawimage_recolor(device, 0, 0, image, 0, 255, 255, 0, 0, 0);
+    qp_drawimage_recolor(device, 0, 0, image, 0, 0, 255, 0, 0, 0);
+
+    // Needs room, so the red copy goes
+    reset();
+    qp_drawtext(device, 0, 0, font, "Base");
+    EXPECT_EQ(panel.pixels_decoded, (uint32_t)qp_textwidth(font, "Base") * font->line_height);
+
+    reset();
+    qp_drawimage_recolor(device, 0, 0, image, 0, 0, 255, 0, 0, 0);
+    EXPECT_EQ(panel.pixels_decoded, 0u);
+    qp_drawimage_recolor(device, 0, 0, image, 0, 255, 255, 0, 0, 0);
+    EXPECT_EQ(panel.pixels_decoded, image_conversions(gfx_lock_caps_ON));
+}
+
+TEST_F(PainterCache, FragmentedSpaceIsCompacted) {
+    // Fill the cache with glyphs, then free up space in the middle by closing a font
+    painter_font_handle_t other = qp_load_font_mem(font_thintel15);
+    ASSERT_NE(other, nullptr);
+    qp_drawtext(device, 0, 0, font, "abc");
+    qp_drawtext(device, 0, 0, other, "abcdefghij");
+    qp_drawtext(device, 0, 0, font, "def");
+    qp_close_font(other);
+
+    // The image only fits if the remaining glyphs are moved together
+    qp_drawimage(device, 0, 0, image);
+    take_framebuffer();
+
+    reset();
+    qp_drawtext(device, 0, 0, font, "abcdef");
+    EXPECT_EQ(panel.pixels_decoded, 0u);
+    qp_drawimage(device, 0, 0, image);
+    EXPECT_EQ(panel.pixels_decoded, 0u);
+}
+
+TEST_F(PainterCache, ClosedFontsAreDropped) {
+    qp_drawtext(device, 0, 0, font, "Base");
+    uint32_t decoded = panel.pixels_decoded;
+    qp_close_font(font);
+    font = qp_load_font_mem(font_thintel15);
+
+    reset();
+    qp_drawtext(device, 0, 0, font, "Base");
+    EXPECT_EQ(panel.pixels_decoded, decoded);
+}
+
+TEST_F(PainterCache, RepeatedDrawsOnlyDecodeWhileCold) {
+    constexpr int iterations = 200;
+    const char   *text       = "Layer: Base  WPM: 123";
+
+    auto draw = [&](bool cold) {
+        reset();
+        for (int i = 0; i < iterations; ++i) {
+            if (cold) {
+                qp_close_font(font);
+                font = qp_load_font_mem(font_thintel15);
+            }
+            qp_drawtext(device, 0, 0, font, text);
+        }
+        return take_framebuffer();
+    };
+
+    // Each distinct glyph is decoded once per draw
+    std::vector<uint16_t> cold      = draw(true);
+    uint32_t              cold_sent = panel.pixels_sent;
+    EXPECT_EQ(panel.pixels_decoded, iterations * (uint32_t)qp_textwidth(font, "Layer: BsWPM123") * font->line_height);
+
+    // Once cached, the same pixels reach the panel without decoding anything
+    std::vector<uint16_t> warm = draw(false);
+    EXPECT_EQ(panel.pixels_decoded, 0u);
+    EXPECT_EQ(panel.pixels_sent, cold_sent);
+    EXPECT_EQ(warm, cold);
+}
@@ -0,0 +1,10 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+QUANTUM_PAINTER_ENABLE = yes
+QUANTUM_PAINTER_DRIVERS = surface
+
+# Assets are built from the keyboards that ship them, shared with the painter cache test
+VPATH += keyboards/tzarc/djinn/graphics keyboards/dasky/reverb/graphics
+
+SRC += reverb.qgf.c lock-caps-ON.qgf.c
@@ -0,0 +1,377 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_draw.h"
+#include "qp_surface.h"
+#include "qgf.h"
+#include "reverb.qgf.h"
+#include "lock-caps-ON.qgf.h"
+}
+
+namespace {
+
+constexpr uint16_t SURFACE_WIDTH  = 128;
+constexpr uint16_t SURFACE_HEIGHT = 64;
+
+// Encodes data the same way as `qmk painter-convert-graphics`: runs of repeated bytes, and runs of differing bytes
+std::vector<uint8_t> rle_encode(const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> out;
+    size_t               i = 0;
+    while (i < data.size()) {
+        size_t run = 1;
+        while (i + run < data.size() && run < 127 && data[i + run] == data[i]) {
+            ++run;
+        }
+        if (run >= 2) {
+            out.push_back(run);
+            out.push_back(data[i]);
+            i += run;
+            continue;
+        }
+        size_t start = i;
+        while (i < data.size() && i - start < 128 && !(i + 1 < data.size() && data[i + 1] == data[i])) {
+            ++i;
+        }
+        if (i == start) {
+            ++i;
+        }
+        out.push_back(127 + (i - start));
+        out.insert(out.end(), data.begin() + start, data.begin() + i);
+    }
+    return out;
+}
+
+// Pixel data with long runs, so that RLE produces both kinds of run
+std::vector<uint8_t> make_pixel_data(size_t length, uint32_t seed) {
+    std::mt19937         rng(seed);
+    std::vector<uint8_t> data;
+    while (data.size() < length) {
+        uint8_t value = rng();
+        size_t  run   = (rng() % 3 == 0) ? 1 + rng() % 200 : 1;
+        for (size_t i = 0; i < run && data.size() < length; ++i) {
+            data.push_back(value);
+        }
+    }
+    return data;
+}
+
+// Palette index of pixel n in packed palette data, least significant bits first as in QGF
+uint8_t palette_index(const std::vector<uint8_t> &data, uint8_t bpp, uint32_t n) {
+    uint8_t pixels_per_byte = 8 / bpp;
+    return (data[n / pixels_per_byte] >> ((n % pixels_per_byte) * bpp)) & ((1 << bpp) - 1);
+}
+
+// The images as drawn by qp_drawimage, darkest palette entry first
+const char *const lock_caps_on_pixels[] = {
+    "                                ",
+    " #####################          ",
+    " ######################         ",
+    " #######################        ",
+    " ########################       ",
+    " #########################      ",
+    " ##########################     ",
+    " #############    ##########    ",
+    " #############    ###########   ",
+    " ############     ############  ",
+    " ############      ############ ",
+    " ############      ############ ",
+    " ############      ############ ",
+    " ############      ############ ",
+    " ###########   #   ############ ",
+    " ###########   ##   ########### ",
+    " ###########   ##   ########### ",
+    " ###########   ##   ########### ",
+    " ##########         ########### ",
+    " ##########          ########## ",
+    " ##########          ########## ",
+    " ##########   ####   ########## ",
+    " #########    ####   ########## ",
+    " #########    ####    ######### ",
+    " #########   #####    ######### ",
+    " ############################## ",
+    " ############################## ",
+    " ############################## ",
+    " ############################## ",
+    " ############################## ",
+    " ############################## ",
+    "                                ",
+};
+
+const char *const reverb_pixels[] = {
+    "                                                                                                                        ",
+    "                                                                                                                        ",
+    "                                                                                                                        ",
+    "                                                                                                                        ",
+    "   ################   ################      ##         ###     #############    ############  ###############           ",
+    "   ####################################     ###        ###     #############    ###############################         ",
+    "   ################### ################     ###        ###     #############    ############## #################        ",
+    "   ###################  ###############     ###        ###     #############    ##############  #################       ",
+    "   ###################  ###############     ###        ###     #############    ##############   #################      ",
+    "   ###################   ##############     ###        ###     #############    ##############   ##################     ",
+    "   #########    ######   #####          #######        ###    #####         ########    ######    ####   ##########     ",
+    "   ########      #####    ####          #######       ####    ####          ########      ####    ####     ########     ",
+    "   ########       ####    ####          ########      ####    ####          ########      ####    ####     #########    ",
+    "   ########       ####    ####          ########      ####    ####          ########      ####     ###      ########    ",
+    "   ########       ####    ####          ########      ####    ####          ########       ###     ###      ########    ",
+    "   ########       ####    ####          ########      ####   #####          ########       ###     ###      ########    ",
+    "   ########       ####    ####           #######      ####   #####          ########       ###     ###      ########    ",
+    "   ########        ###     ###           #######      ####   #####          ########       ###     ###      ########    ",
+    "   ########       ####    ####           #######     #####   #####          ########       ###     ###      ########    ",
+    "   ########       ####    ####           ########    #####   #####          ########       ###     ###     ########     ",
+    "   ########       ####    ####           ########    #####  ######          ########       ###     ###    #########     ",
+    "   ########       ####    ############### #######    #####  ################ #######      ####     ################     ",
+    "   ########      #####    ############### #######    #####  ################ #######      ####    ################      ",
+    "   ########     ######    ############### #######    #####  ################ #######     #####    ###############       ",
+    "   ###################   ################ #######    #####  ################ #################    ##############        ",
+    "   ###################   ################ #######    #####  ################ #################   #################      ",
+    "   ###################  #################  ######   ###### ################# #################  ###################     ",
+    "   ################### ##################  #######  ###### ################# #################  ####################    ",
+    "   ###########################             #######  ###### #######          ##########################     #########    ",
+    "   #################  ########             #######  ##############          ################# ########      #########   ",
+    "   #################  ########             #######  ##############          ################# ########       ########   ",
+    "   ######## ######### ########             #######  ##############          ######## ######## ########       ########   ",
+    "   ########  ######## ########              ######  ##############          ######## #################       ########   ",
+    "   ########  #################              ###### ###############          ########  ################       #########  ",
+    "   ########   ################              ######################          ########  ################       #########  ",
+    "   ########   ################              ######################          ########   ####### #######       ########   ",
+    "   ########    ####### #######              ######################          ########   ####### #######       ########   ",
+    "   ########    ####### #######               ############ ########          ########    ######  ######       ########   ",
+    "   ########     ######  ######               ############ ########          ########    ######  ######      #########   ",
+    "   ########     ######  ######               ############ ########          ########    ######   #####     ##########   ",
+    "   ########      #####   ################### ############ ##################    ####     #####   ###################    ",
+    "   ########      #####   ################### ############ ##################    ####     #####    ##################    ",
+    "   ########      #####    ##################  ##########  ##################    ####      ####    #################     ",
+    "   ########       ####    ##################  ##########  ##################    ####      ####     ###############      ",
+    "   ########       ####     #################  ##########  ##################    ####       ###     ##############       ",
+    "   ########        ###     #################  ##########  ##################    ####       ###     ############         ",
+    "    #######        ###      ################  #########   ##################     ###        ##      ########            ",
+    "                                                                                                                        ",
+    "                                                                                                                        ",
+    "                                                                                                                        ",
+};
+
+struct surface_t {
+    painter_device_t device;
+    uint8_t         *buffer;
+    size_t           buffer_size;
+};
+
+uint8_t rgb565_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(SURFACE_WIDTH, SURFACE_HEIGHT, 16)];
+uint8_t rgb888_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(SURFACE_WIDTH, SURFACE_HEIGHT, 24)];
+uint8_t mono1bpp_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(SURFACE_WIDTH, SURFACE_HEIGHT, 1)];
+
+surface_t rgb565;
+surface_t rgb888;
+surface_t mono1bpp;
+
+uint8_t native_bpp(const surface_t &surface) {
+    return ((painter_driver_t *)surface.device)->native_bits_per_pixel;
+}
+
+// The pixel at (x, y) as stored in the surface: the raw bytes for native formats, the bit for mono
+uint32_t read_pixel(const surface_t &surface, uint16_t x, uint16_t y) {
+    uint32_t n = (uint32_t)y * SURFACE_WIDTH + x;
+    switch (native_bpp(surface)) {
+        case 16:
+            return surface.buffer[n * 2] << 8 | surface.buffer[n * 2 + 1];
+        case 24:
+            return surface.buffer[n * 3] << 16 | surface.buffer[n * 3 + 1] << 8 | surface.buffer[n * 3 + 2];
+        default:
+            return (surface.buffer[n / 8] >> (n % 8)) & 1;
+    }
+}
+
+// The same, for native pixel data as it was streamed in
+uint32_t native_pixel(const surface_t &surface, const std::vector<uint8_t> &data, uint32_t n) {
+    return native_bpp(surface) == 16 ? data[n * 2] << 8 | data[n * 2 + 1] : data[n * 3] << 16 | data[n * 3 + 1] << 8 | data[n * 3 + 2];
+}
+
+// The value the surface stores for a colour, converted on a copy so the global palette is left alone
+uint32_t expected_pixel(const surface_t &surface, qp_pixel_t hsv) {
+    painter_driver_t *driver = (painter_driver_t *)surface.device;
+    qp_pixel_t        pixel  = hsv;
+    driver->driver_vtable->palette_convert(surface.device, 1, &pixel);
+    switch (native_bpp(surface)) {
+        case 16:
+            return ((uint8_t *)&pixel.rgb565)[0] << 8 | ((uint8_t *)&pixel.rgb565)[1];
+        case 24:
+            return pixel.rgb888.r << 16 | pixel.rgb888.g << 8 | pixel.rgb888.b;
+        default:
+            return pixel.mono;
+    }
+}
+
+qp_pixel_t palette_colour(uint8_t index) {
+    return (qp_pixel_t){.hsv888 = {(uint8_t)(index * 37), (uint8_t)(255 - index), (uint8_t)(index * 89 + 1)}};
+}
+
+void make_palette(painter_device_t device, uint8_t bpp) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    for (int i = 0; i < (1 << bpp); ++i) {
+        qp_internal_global_pixel_lookup_table[i] = palette_colour(i);
+    }
+    qp_internal_invalidate_palette();
+    driver->driver_vtable->palette_convert(device, 1 << bpp, qp_internal_global_pixel_lookup_table);
+}
+
+} // namespace
+
+class PainterCodec : public ::testing::Test {
+   protected:
+    static constexpr uint16_t LEFT = 3;
+    static constexpr uint16_t TOP  = 2;
+
+    static void SetUpTestSuite() {
+        rgb565   = {qp_make_rgb565_surface(SURFACE_WIDTH, SURFACE_HEIGHT, rgb565_buffer), rgb565_buffer, sizeof(rgb565_buffer)};
+        rgb888   = {qp_make_rgb888_surface(SURFACE_WIDTH, SURFACE_HEIGHT, rgb888_buffer), rgb888_buffer, sizeof(rgb888_buffer)};
+        mono1bpp = {qp_make_mono1bpp_surface(SURFACE_WIDTH, SURFACE_HEIGHT, mono1bpp_buffer), mono1bpp_buffer, sizeof(mono1bpp_buffer)};
+    }
+
+    void SetUp() override {
+        for (surface_t *surface : {&rgb565, &rgb888, &mono1bpp}) {
+            ASSERT_NE(surface->device, nullptr);
+            ASSERT_TRUE(qp_init(surface->device, QP_ROTATION_0));
+        }
+    }
+
+    // Decodes the pixel data into a viewport at (LEFT, TOP), with everything around it set to a marker value
+    static void decode(const surface_t &surface, uint8_t bpp, painter_compression_t compression, const std::vector<uint8_t> &encoded, uint16_t width, uint16_t height) {
+        painter_driver_t *driver = (painter_driver_t *)surface.device;
+        memset(surface.buffer, 0x5A, surface.buffer_size);
+        if (bpp <= 8) {
+            make_palette(surface.device, bpp);
+        }
+        ASSERT_TRUE(driver->driver_vtable->viewport(surface.device, LEFT, TOP, LEFT + width - 1, TOP + height - 1));
+
+        qp_memory_stream_t             stream      = qp_make_memory_stream((void *)encoded.data(), encoded.size());
+        qp_internal_byte_input_state_t input_state = {.device = surface.device, .src_stream = (qp_stream_t *)&stream};
+        ASSERT_TRUE(qp_internal_prepare_input_state(&input_state, compression));
+        ASSERT_TRUE(qp_internal_appender(surface.device, bpp, (uint32_t)width * height, &input_state));
+    }
+
+    static uint32_t untouched_pixel(const surface_t &surface) {
+        return native_bpp(surface) == 1 ? 0 : 0x5A5A5A & ((1u << native_bpp(surface)) - 1);
+    }
+
+    // Every pixel in the viewport holds the colour of its palette index, and nothing outside it was written
+    static void expect_palette_pixels(const surface_t &surface, uint8_t bpp, const std::vector<uint8_t> &data, uint16_t width, uint16_t height) {
+        uint32_t expected[256];
+        for (int i = 0; i < (1 << bpp); ++i) {
+            expected[i] = expected_pixel(surface, palette_colour(i));
+        }
+        for (uint16_t y = 0; y < SURFACE_HEIGHT; ++y) {
+            for (uint16_t x = 0; x < SURFACE_WIDTH; ++x) {
+                if (x < LEFT || y < TOP || x >= LEFT + width || y >= TOP + height) {
+                    if (native_bpp(surface) != 1) {
+                        ASSERT_EQ(read_pixel(surface, x, y), untouched_pixel(surface)) << "outside the viewport at " << x << "," << y;
+                    }
+                    continue;
+                }
+                uint8_t index = palette_index(data, bpp, (uint32_t)(y - TOP) * width + (x - LEFT));
+                ASSERT_EQ(read_pixel(surface, x, y), expected[index]) << "bpp " << (int)bpp << ", native bpp " << (int)native_bpp(surface) << " at " << x << "," << y;
+            }
+        }
+    }
+
+    static void expect_native_pixels(const surface_t &surface, const std::vector<uint8_t> &data, uint16_t width, uint16_t height) {
+        for (uint16_t y = 0; y < height; ++y) {
+            for (uint16_t x = 0; x < width; ++x) {
+                ASSERT_EQ(read_pixel(surface, LEFT + x, TOP + y), native_pixel(surface, data, (uint32_t)y * width + x)) << "at " << x << "," << y;
+            }
+        }
+    }
+
+    // Draws a QGF image and compares it against its known contents, one character per pixel
+    template <size_t N>
+    static void expect_image(const uint8_t *image_data, const char *const (&pixels)[N], const char *levels) {
+        const uint8_t steps = strlen(levels);
+        for (surface_t *surface : {&rgb565, &rgb888, &mono1bpp}) {
+            painter_image_handle_t image = qp_load_image_mem(image_data);
+            ASSERT_NE(image, nullptr);
+            ASSERT_EQ(image->height, N);
+            ASSERT_TRUE(qp_drawimage(surface->device, 4, 5, image));
+            qp_close_image(image);
+
+            for (uint16_t y = 0; y < N; ++y) {
+                ASSERT_EQ(strlen(pixels[y]), image->width);
+                for (uint16_t x = 0; x < image->width; ++x) {
+                    // qp_drawimage interpolates from black for index 0 to white for the last index
+                    uint8_t    index = strchr(levels, pixels[y][x]) - levels;
+                    qp_pixel_t grey  = {.hsv888 = {0, 0, (uint8_t)(255 * index / (steps - 1))}};
+                    ASSERT_EQ(read_pixel(*surface, 4 + x, 5 + y), expected_pixel(*surface, grey)) << "native bpp " << (int)native_bpp(*surface) << " at " << x << "," << y;
+                }
+            }
+        }
+    }
+};
+
+TEST_F(PainterCodec, PaletteUncompressed) {
+    for (uint8_t bpp : {1, 2, 4, 8}) {
+        for (surface_t *surface : {&rgb565, &rgb888, &mono1bpp}) {
+            // Odd sizes leave padding bits in the last byte
+            std::vector<uint8_t> data = make_pixel_data((61 * 37 * bpp + 7) / 8, bpp);
+            decode(*surface, bpp, IMAGE_UNCOMPRESSED, data, 61, 37);
+            expect_palette_pixels(*surface, bpp, data, 61, 37);
+        }
+    }
+}
+
+TEST_F(PainterCodec, PaletteRle) {
+    for (uint8_t bpp : {1, 2, 4, 8}) {
+        for (surface_t *surface : {&rgb565, &rgb888, &mono1bpp}) {
+            std::vector<uint8_t> data = make_pixel_data((121 * 59 * bpp + 7) / 8, 100 + bpp);
+            decode(*surface, bpp, IMAGE_COMPRESSED_RLE, rle_encode(data), 121, 59);
+            expect_palette_pixels(*surface, bpp, data, 121, 59);
+        }
+    }
+}
+
+TEST_F(PainterCodec, RleFills) {
+    // Solid runs, runs of mixed pixels within each byte, and runs crossing pixdata buffer boundaries
+    std::vector<uint8_t> data(1200, 0x00);
+    std::fill(data.begin() + 100, data.begin() + 700, 0xFF);
+    std::fill(data.begin() + 700, data.begin() + 900, 0x1B);
+    for (uint8_t bpp : {1, 2, 4, 8}) {
+        for (surface_t *surface : {&rgb565, &rgb888, &mono1bpp}) {
+            uint16_t height = 1200 * 8 / bpp / SURFACE_WIDTH;
+            height          = height > SURFACE_HEIGHT - TOP ? SURFACE_HEIGHT - TOP : height;
+            std::vector<uint8_t> trimmed(data.begin(), data.begin() + ((SURFACE_WIDTH - LEFT) * height * bpp + 7) / 8);
+            decode(*surface, bpp, IMAGE_COMPRESSED_RLE, rle_encode(trimmed), SURFACE_WIDTH - LEFT, height);
+            expect_palette_pixels(*surface, bpp, trimmed, SURFACE_WIDTH - LEFT, height);
+        }
+    }
+}
+
+TEST_F(PainterCodec, Native) {
+    std::vector<uint8_t> data = make_pixel_data(47 * 29 * 2, 7);
+    decode(rgb565, 16, IMAGE_UNCOMPRESSED, data, 47, 29);
+    expect_native_pixels(rgb565, data, 47, 29);
+    decode(rgb565, 16, IMAGE_COMPRESSED_RLE, rle_encode(data), 47, 29);
+    expect_native_pixels(rgb565, data, 47, 29);
+
+    data = make_pixel_data(47 * 29 * 3, 8);
+    decode(rgb888, 24, IMAGE_COMPRESSED_RLE, rle_encode(data), 47, 29);
+    expect_native_pixels(rgb888, data, 47, 29);
+}
+
+TEST_F(PainterCodec, TruncatedInputFails) {
+    std::vector<uint8_t> data = rle_encode(make_pixel_data(200, 9));
+    data.resize(data.size() / 2);
+    qp_memory_stream_t             stream      = qp_make_memory_stream(data.data(), data.size());
+    qp_internal_byte_input_state_t input_state = {.device = rgb565.device, .src_stream = (qp_stream_t *)&stream};
+    qp_internal_prepare_input_state(&input_state, IMAGE_COMPRESSED_RLE);
+    make_palette(rgb565.device, 8);
+    EXPECT_FALSE(qp_internal_appender(rgb565.device, 8, 200, &input_state));
+}
+
+TEST_F(PainterCodec, QgfAssets) {
+    expect_image(gfx_lock_caps_ON, lock_caps_on_pixels, " .o#");
+    expect_image(gfx_reverb, reverb_pixels, " #");
+}
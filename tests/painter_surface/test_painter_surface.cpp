@@ -0,0 +1,263 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_comms.h"
+#include "qp_internal_driver.h"
+#include "qp_surface.h"
+}
+
+namespace {
+
+constexpr uint16_t PANEL_WIDTH  = 240;
+constexpr uint16_t PANEL_HEIGHT = 320;
+
+// Command overhead for an ILI9341 viewport change: CASET + 4 bytes, RASET + 4 bytes, RAMWR
+constexpr uint32_t VIEWPORT_BYTES = 11;
+
+struct rect_t {
+    uint16_t l, t, r, b;
+    bool     operator==(const rect_t &other) const {
+        return l == other.l && t == other.t && r == other.r && b == other.b;
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const rect_t &rect) {
+    return os << "(" << rect.l << "," << rect.t << ")-(" << rect.r << "," << rect.b << ")";
+}
+
+uint32_t            bytes_sent;
+std::vector<rect_t> viewports;
+
+bool mock_comms_init(painter_device_t device) {
+    return true;
+}
+
+bool mock_comms_start(painter_device_t device) {
+    return true;
+}
+
+bool mock_comms_stop(painter_device_t device) {
+    return true;
+}
+
+uint32_t mock_comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
+    bytes_sent += byte_count;
+    return byte_count;
+}
+
+const painter_comms_vtable_t mock_comms_vtable = {
+    .comms_init  = mock_comms_init,
+    .comms_start = mock_comms_start,
+    .comms_stop  = mock_comms_stop,
+    .comms_send  = mock_comms_send,
+};
+
+bool mock_panel_init(painter_device_t device, painter_rotation_t rotation) {
+    return true;
+}
+
+bool mock_panel_power(painter_device_t device, bool power_on) {
+    return true;
+}
+
+bool mock_panel_clear(painter_device_t device) {
+    return true;
+}
+
+bool mock_panel_flush(painter_device_t device) {
+    return true;
+}
+
+bool mock_panel_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    uint8_t commands[VIEWPORT_BYTES] = {0};
+    viewports.push_back({left, top, right, bottom});
+    return qp_comms_send(device, commands, sizeof(commands)) == sizeof(commands);
+}
+
+bool mock_panel_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    uint32_t byte_count = native_pixel_count * sizeof(uint16_t);
+    return qp_comms_send(device, pixel_data, byte_count) == byte_count;
+}
+
+bool mock_panel_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    return true;
+}
+
+bool mock_panel_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    return true;
+}
+
+bool mock_panel_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    return true;
+}
+
+const painter_driver_vtable_t mock_panel_vtable = {
+    .init            = mock_panel_init,
+    .power           = mock_panel_power,
+    .clear           = mock_panel_clear,
+    .flush           = mock_panel_flush,
+    .viewport        = mock_panel_viewport,
+    .pixdata         = mock_panel_pixdata,
+    .palette_convert = mock_panel_palette_convert,
+    .append_pixels   = mock_panel_append_pixels,
+    .append_pixdata  = mock_panel_append_pixdata,
+};
+
+uint16_t         framebuffer[PANEL_WIDTH * PANEL_HEIGHT];
+painter_driver_t panel;
+painter_device_t surface;
+
+} // namespace
+
+class PainterSurface : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        panel                       = {};
+        panel.driver_vtable         = &mock_panel_vtable;
+        panel.comms_vtable          = &mock_comms_vtable;
+        panel.panel_width           = PANEL_WIDTH;
+        panel.panel_height          = PANEL_HEIGHT;
+        panel.native_bits_per_pixel = 16;
+        ASSERT_TRUE(qp_init(&panel, QP_ROTATION_0));
+
+        if (!surface) {
+            surface = qp_make_rgb565_surface(PANEL_WIDTH, PANEL_HEIGHT, framebuffer);
+        }
+        ASSERT_NE(surface, nullptr);
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+
+        // Start every test from a clean, fully transferred surface
+        ASSERT_TRUE(qp_surface_draw(surface, &panel, 0, 0, false));
+        reset();
+    }
+
+    void reset() {
+        bytes_sent = 0;
+        viewports.clear();
+    }
+
+    void set_pixel(uint16_t x, uint16_t y) {
+        uint16_t pixel = 0xFFFF;
+        ASSERT_TRUE(qp_viewport(surface, x, y, x, y));
+        ASSERT_TRUE(qp_pixdata(surface, &pixel, 1));
+    }
+
+    void fill(uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+        for (uint16_t y = t; y <= b; ++y) {
+            for (uint16_t x = l; x <= r; ++x) {
+                set_pixel(x, y);
+            }
+        }
+    }
+
+    static uint32_t transfer_bytes(const rect_t &rect) {
+        return VIEWPORT_BYTES + (rect.r - rect.l + 1) * (rect.b - rect.t + 1) * sizeof(uint16_t);
+    }
+};
+
+TEST_F(PainterSurface, InitialDrawSendsWholePanelOnce) {
+    ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+    ASSERT_TRUE(qp_surface_draw(surface, &panel, 0, 0, false));
+
+    rect_t whole = {0, 0, PANEL_WIDTH - 1, PANEL_HEIGHT - 1};
+    EXPECT_EQ(viewports, std::vector<rect_t>({whole}));
+    EXPECT_EQ(bytes_sent, transfer_bytes(whole));
+}
+
+TEST_F(PainterSurface, CleanSurfaceSendsNothing) {
+    ASSERT_TRUE(qp_surface_draw(surface, &panel, 0, 0, false));
+    EXPECT_TRUE(viewports.empty());
+    EXPECT_EQ(bytes_sent, 0u);
+}
+
+TEST_F(PainterSurface, UnchangedPixelsAreNotDirty) {
+    uint16_t pixel = 0x0000;
+    ASSERT_TRUE(qp_viewport(surface, 10, 10, 10, 10));
+    ASSERT_TRUE(qp_pixdata(surface, &pixel, 1));
+    ASSERT_TRUE(qp_surface_draw(surface, &panel, 0, 0, false));
+    EXPECT_EQ(bytes_sent, 0u);
+}
+
+TEST_F(PainterSurface, SinglePixelSendsOnlyThatPixel) {
+    set_pixel(100, 200);
+    ASSERT_TRUE(qp_surface_draw(surface, &panel, 0, 0, false));
+
+    rect_t pixel = {100, 200, 100, 200};
+    EXPECT_EQ(viewports, std::vector<rect_t>({pixel}));
+    EXPECT_EQ(bytes_sent, transfer_bytes(pixel));
+}
+
+TEST_F(PainterSurface, DistantChangesSendOnlyTheirTiles) {
+    // Opposite corners would make the bounding box the whole panel
+    set_pixel(0, 0);
+    set_pixel(PANEL_WIDTH - 1, PANEL_HEIGHT - 1);
+    ASSERT_TRUE(qp_surface_draw(surface, &panel, 0, 0, false));
+
+    EXPECT_EQ(viewports.size(), 2u);
+    EXPECT_EQ(bytes_sent, 2 * transfer_bytes({0, 0, SURFACE_DIRTY_TILE_SIZE - 1, SURFACE_DIRTY_TILE_SIZE - 1}));
+    EXPECT_LT(bytes_sent * 100, transfer_bytes({0, 0, PANEL_WIDTH - 1, PANEL_HEIGHT - 1}));
+}
+
+TEST_F(PainterSurface, AdjacentTilesMergeIntoOneRun) {
+    // A horizontal line across four tiles
+    fill(8, 40, 8 + 4 * SURFACE_DIRTY_TILE_SIZE, 40);
+    ASSERT_TRUE(qp_surface_draw(surface, &panel, 0, 0, false));
+
+    EXPECT_EQ(viewports, std::vector<rect_t>({{8, 40, 8 + 4 * SURFACE_DIRTY_TILE_SIZE, 40}}));
+}
+
+TEST_F(PainterSurface, IdenticalRunsMergeVertically) {
+    // A two-tile block spanning three tile rows, plus a separate tile to the right
+    set_pixel(2 * SURFACE_DIRTY_TILE_SIZE, 0);
+    set_pixel(4 * SURFACE_DIRTY_TILE_SIZE - 1, 3 * SURFACE_DIRTY_TILE_SIZE - 1);
+    set_pixel(2 * SURFACE_DIRTY_TILE_SIZE, SURFACE_DIRTY_TILE_SIZE);
+    set_pixel(3 * SURFACE_DIRTY_TILE_SIZE, SURFACE_DIRTY_TILE_SIZE);
+    set_pixel(3 * SURFACE_DIRTY_TILE_SIZE, 2 * SURFACE_DIRTY_TILE_SIZE);
+    set_pixel(2 * SURFACE_DIRTY_TILE_SIZE, 2 * SURFACE_DIRTY_TILE_SIZE);
+    set_pixel(3 * SURFACE_DIRTY_TILE_SIZE, 0);
+    set_pixel(6 * SURFACE_DIRTY_TILE_SIZE, 0);
+    ASSERT_TRUE(qp_surface_draw(surface, &panel, 0, 0, false));
+
+    EXPECT_EQ(viewports, std::vector<rect_t>({
+                             {2 * SURFACE_DIRTY_TILE_SIZE, 0, 4 * SURFACE_DIRTY_TILE_SIZE - 1, 3 * SURFACE_DIRTY_TILE_SIZE - 1},
+                             {6 * SURFACE_DIRTY_TILE_SIZE, 0, 6 * SURFACE_DIRTY_TILE_SIZE, SURFACE_DIRTY_TILE_SIZE - 1},
+                         }));
+}
+
+TEST_F(PainterSurface, DifferentRunsDoNotMergeVertically) {
+    // One tile, with a wider run below it
+    set_pixel(SURFACE_DIRTY_TILE_SIZE, 0);
+    fill(0, SURFACE_DIRTY_TILE_SIZE, 3 * SURFACE_DIRTY_TILE_SIZE - 1, SURFACE_DIRTY_TILE_SIZE);
+    ASSERT_TRUE(qp_surface_draw(surface, &panel, 0, 0, false));
+
+    EXPECT_EQ(viewports, std::vector<rect_t>({
+                             {SURFACE_DIRTY_TILE_SIZE, 0, 2 * SURFACE_DIRTY_TILE_SIZE - 1, SURFACE_DIRTY_TILE_SIZE - 1},
+                             {0, SURFACE_DIRTY_TILE_SIZE, 3 * SURFACE_DIRTY_TILE_SIZE - 1, SURFACE_DIRTY_TILE_SIZE},
+                         }));
+}
+
+TEST_F(PainterSurface, DrawIsOffsetOnTarget) {
+    set_pixel(5, 6);
+    ASSERT_TRUE(qp_surface_draw(surface, &panel, 20, 30, false));
+    EXPECT_EQ(viewports, std::vector<rect_t>({{25, 36, 25, 36}}));
+}
+
+TEST_F(PainterSurface, EntireSurfaceIgnoresTiles) {
+    set_pixel(5, 6);
+    ASSERT_TRUE(qp_surface_draw(surface, &panel, 0, 0, true));
+    EXPECT_EQ(viewports, std::vector<rect_t>({{0, 0, PANEL_WIDTH - 1, PANEL_HEIGHT - 1}}));
+}
+
+TEST_F(PainterSurface, DrawResetsDirtyTiles) {
+    set_pixel(5, 6);
+    ASSERT_TRUE(qp_surface_draw(surface, &panel, 0, 0, false));
+    reset();
+    ASSERT_TRUE(qp_surface_draw(surface, &panel, 0, 0, false));
+    EXPECT_EQ(bytes_sent, 0u);
+}
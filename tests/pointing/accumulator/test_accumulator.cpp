@@ -0,0 +1,207 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+using testing::_;
+using testing::Invoke;
+
+static report_mouse_t motion(int16_t x, int16_t y, int16_t h, int16_t v, uint8_t buttons) {
+    report_mouse_t mouse_report = {};
+    mouse_report.x              = x;
+    mouse_report.y              = y;
+    mouse_report.h              = h;
+    mouse_report.v              = v;
+    mouse_report.buttons        = buttons;
+    return mouse_report;
+}
+
+class PointingAccumulator : public ::testing::Test {
+   protected:
+    pointing_device_accumulator_t accumulator;
+
+    void SetUp() override {
+        pointing_device_accumulator_init(&accumulator, 1, 1);
+    }
+
+    void add(int16_t x, int16_t y, int16_t h = 0, int16_t v = 0) {
+        report_mouse_t sample = {};
+        sample.x              = x;
+        sample.y              = y;
+        sample.h              = h;
+        sample.v              = v;
+        pointing_device_accumulator_add(&accumulator, sample);
+    }
+
+    report_mouse_t take() {
+        report_mouse_t mouse_report = {};
+        return pointing_device_accumulator_take(&accumulator, mouse_report);
+    }
+};
+
+TEST_F(PointingAccumulator, SumsEveryReadUntilTaken) {
+    add(3, -2, 1, 0);
+    add(3, -2, 0, -1);
+    add(3, -2, 1, 0);
+    EXPECT_TRUE(pointing_device_accumulator_has_motion(&accumulator));
+    EXPECT_EQ(take(), motion(9, -6, 2, -1, 0));
+    EXPECT_FALSE(pointing_device_accumulator_has_motion(&accumulator));
+    EXPECT_EQ(take(), motion(0, 0, 0, 0, 0));
+}
+
+TEST_F(PointingAccumulator, TakeKeepsButtons) {
+    add(5, 0);
+    report_mouse_t mouse_report = {};
+    mouse_report.buttons        = 3;
+    mouse_report.x              = 100;
+    EXPECT_EQ(pointing_device_accumulator_take(&accumulator, mouse_report), motion(5, 0, 0, 0, 3));
+}
+
+TEST_F(PointingAccumulator, MotionBeyondOneReportIsCarried) {
+    add(100, -100);
+    add(100, -100);
+    add(100, -100);
+    EXPECT_EQ(take(), motion(MOUSE_REPORT_XY_MAX, MOUSE_REPORT_XY_MIN, 0, 0, 0));
+    EXPECT_EQ(take(), motion(MOUSE_REPORT_XY_MAX, MOUSE_REPORT_XY_MIN, 0, 0, 0));
+    EXPECT_EQ(take(), motion(300 - 2 * MOUSE_REPORT_XY_MAX, -300 - 2 * MOUSE_REPORT_XY_MIN, 0, 0, 0));
+    EXPECT_EQ(take(), motion(0, 0, 0, 0, 0));
+}
+
+TEST_F(PointingAccumulator, BacklogIsBounded) {
+    for (int i = 0; i < 10 * POINTING_DEVICE_ACCUMULATOR_MAX_REPORTS; ++i) {
+        add(MOUSE_REPORT_XY_MAX, 0, MOUSE_REPORT_HV_MAX, 0);
+    }
+    for (int i = 0; i < POINTING_DEVICE_ACCUMULATOR_MAX_REPORTS; ++i) {
+        EXPECT_EQ(take(), motion(MOUSE_REPORT_XY_MAX, 0, MOUSE_REPORT_HV_MAX, 0, 0));
+    }
+    EXPECT_EQ(take(), motion(0, 0, 0, 0, 0));
+}
+
+TEST_F(PointingAccumulator, FractionsFromScalingDownAreCarried) {
+    pointing_device_accumulator_set_scale(&accumulator, 1, 3);
+    int total = 0;
+    for (int i = 1; i <= 10; ++i) {
+        add(1, -1);
+        report_mouse_t mouse_report = take();
+        EXPECT_EQ(mouse_report.x, -mouse_report.y);
+        total += mouse_report.x;
+        EXPECT_EQ(total, i / 3) << "after read " << i;
+    }
+    // A third of a count is still pending
+    EXPECT_FALSE(pointing_device_accumulator_has_motion(&accumulator));
+    add(2, -2);
+    EXPECT_EQ(take(), motion(1, -1, 0, 0, 0));
+}
+
+TEST_F(PointingAccumulator, FractionsFromScalingUpAreCarried) {
+    pointing_device_accumulator_set_scale(&accumulator, 3, 2);
+    add(1, 0);
+    EXPECT_EQ(take(), motion(1, 0, 0, 0, 0));
+    add(1, 0);
+    EXPECT_EQ(take(), motion(2, 0, 0, 0, 0));
+}
+
+TEST_F(PointingAccumulator, ChangingScaleDropsOnlyTheFraction) {
+    pointing_device_accumulator_set_scale(&accumulator, 1, 4);
+    add(9, -9);
+    pointing_device_accumulator_set_scale(&accumulator, 1, 1);
+    EXPECT_EQ(take(), motion(2, -2, 0, 0, 0));
+    EXPECT_FALSE(pointing_device_accumulator_has_motion(&accumulator));
+}
+
+TEST_F(PointingAccumulator, NothingIsLostWithinTheBacklog) {
+    // Whatever has been emitted plus what is pending always equals the
+    // scaled sum of every read, whichever way the reads and takes interleave
+    std::mt19937 rng(1);
+    for (uint8_t denominator = 1; denominator <= 8; ++denominator) {
+        for (uint8_t numerator = 1; numerator <= 8; ++numerator) {
+            pointing_device_accumulator_init(&accumulator, numerator, denominator);
+            int64_t read = 0, sent = 0;
+            for (int i = 0; i < 1000; ++i) {
+                if (rng() % 3) {
+                    int16_t x = (int16_t)(rng() % 11) - 5;
+                    add(x, 0);
+                    read += x;
+                } else {
+                    sent += take().x;
+                }
+                ASSERT_EQ(sent * denominator + accumulator.x, read * numerator);
+            }
+            while (pointing_device_accumulator_has_motion(&accumulator)) {
+                sent += take().x;
+            }
+            ASSERT_LT(std::abs(read * numerator - sent * denominator), denominator);
+        }
+    }
+}
+
+class PointingAccumulatorTask : public TestFixture {
+   protected:
+    std::vector<report_mouse_t> reports;
+
+    void expect_reports(TestDriver &driver) {
+        EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([this](report_mouse_t &report) { reports.push_back(report); }));
+    }
+
+    int total_x() {
+        int total = 0;
+        for (auto &report : reports) {
+            total += report.x;
+        }
+        return total;
+    }
+};
+
+TEST_F(PointingAccumulatorTask, ReportsCarryEveryReadSinceThePreviousOne) {
+    TestDriver driver;
+    expect_reports(driver);
+
+    // The sensor is read on every loop, reports go out every 4ms
+    pd_set_x(10);
+    idle_for(16);
+    pd_clear_movement();
+    idle_for(8);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(total_x(), 160);
+    EXPECT_LE(reports.size(), 16 / POINTING_DEVICE_TASK_THROTTLE_MS + 2);
+    for (auto &report : reports) {
+        EXPECT_LE(report.x, 10 * (POINTING_DEVICE_TASK_THROTTLE_MS + 1));
+    }
+}
+
+TEST_F(PointingAccumulatorTask, FastMotionIsSpreadOverReports) {
+    TestDriver driver;
+    expect_reports(driver);
+
+    pd_set_x(100);
+    idle_for(4);
+    pd_clear_movement();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(total_x(), 400);
+    for (auto &report : reports) {
+        EXPECT_LE(report.x, MOUSE_REPORT_XY_MAX);
+    }
+}
+
+TEST_F(PointingAccumulatorTask, MotionScaleCarriesFractions) {
+    TestDriver driver;
+    expect_reports(driver);
+
+    pointing_device_set_motion_scale(1, 4);
+    pd_set_x(1);
+    idle_for(10);
+    pd_clear_movement();
+    idle_for(8);
+    pointing_device_set_motion_scale(1, 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(total_x(), 2);
+}
@@ -0,0 +1,40 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "connection.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class ReportCoalescingConnection : public TestFixture {};
+
+TEST_F(ReportCoalescingConnection, PreviousHostSeesKeysReleased) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    connection_set_host_noeeprom(CONNECTION_HOST_USB);
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Switching hosts releases everything on the host being left
+    EXPECT_EMPTY_REPORT(driver);
+    connection_set_host_noeeprom(CONNECTION_HOST_NONE);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
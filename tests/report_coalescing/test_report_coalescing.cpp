@@ -0,0 +1,216 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "keycode.h"
+#include "test_common.hpp"
+#include "mouse_report_util.hpp"
+
+using testing::_;
+using testing::InSequence;
+using testing::Invoke;
+
+class ReportCoalescing : public TestFixture {};
+
+static void send_mouse_motion(int8_t x, uint8_t buttons) {
+    report_mouse_t report = {};
+    report.x              = x;
+    report.buttons        = buttons;
+    host_mouse_send(&report);
+}
+
+TEST_F(ReportCoalescing, SendStringIsMerged) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string("Ab");
+    run_one_scan_loop();
+    EXPECT_REPORT_COUNTS(driver, 6, 3);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, TapWithinOneScanIsKept) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    register_code(KC_A);
+    unregister_code(KC_A);
+    run_one_scan_loop();
+    EXPECT_REPORT_COUNTS(driver, 2, 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, ChangesInOneDirectionAreMerged) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    register_code(KC_LEFT_SHIFT);
+    register_code(KC_A);
+    run_one_scan_loop();
+    EXPECT_REPORT_COUNTS(driver, 2, 1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    unregister_code(KC_A);
+    unregister_code(KC_LEFT_SHIFT);
+    run_one_scan_loop();
+    EXPECT_REPORT_COUNTS(driver, 4, 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, MatrixKeyPressesAreUnchanged) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_b.press();
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_B));
+    key_a.release();
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    key_b.release();
+    run_one_scan_loop();
+    EXPECT_REPORT_COUNTS(driver, 4, 4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, DuplicateReportsAreDropped) {
+    TestDriver        driver;
+    report_keyboard_t report = {};
+    report.keys[0]           = KC_A;
+
+    EXPECT_REPORT(driver, (KC_A)).Times(1);
+    host_keyboard_send(&report);
+    host_keyboard_send(&report);
+    run_one_scan_loop();
+    host_keyboard_send(&report);
+    run_one_scan_loop();
+    EXPECT_REPORT_COUNTS(driver, 3, 1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    report.keys[0] = KC_NO;
+    host_keyboard_send(&report);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, MouseMotionIsSummed) {
+    TestDriver driver;
+
+    EXPECT_MOUSE_REPORT(driver, (30, 0, 0, 0, 0));
+    send_mouse_motion(10, 0);
+    send_mouse_motion(10, 0);
+    send_mouse_motion(10, 0);
+    run_one_scan_loop();
+    EXPECT_REPORT_COUNTS(driver, 3, 1);
+
+    // Reports without motion or button changes don't need sending
+    send_mouse_motion(0, 0);
+    run_one_scan_loop();
+    EXPECT_REPORT_COUNTS(driver, 4, 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, MouseButtonChangesAreNotMerged) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_MOUSE_REPORT(driver, (5, 0, 0, 0, 0));
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 1));
+    EXPECT_MOUSE_REPORT(driver, (5, 0, 0, 0, 1));
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    send_mouse_motion(5, 0);
+    send_mouse_motion(0, 1);
+    send_mouse_motion(5, 1);
+    send_mouse_motion(0, 0);
+    run_one_scan_loop();
+    EXPECT_REPORT_COUNTS(driver, 4, 4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, MouseMotionIsNotMergedPastTheReportRange) {
+    TestDriver driver;
+
+    EXPECT_MOUSE_REPORT(driver, (100, 0, 0, 0, 0)).Times(2);
+    send_mouse_motion(100, 0);
+    send_mouse_motion(100, 0);
+    run_one_scan_loop();
+    EXPECT_REPORT_COUNTS(driver, 2, 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, ReportKindsKeepTheirOrder) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 1));
+    EXPECT_EMPTY_REPORT(driver);
+    register_code(KC_LEFT_CTRL);
+    send_mouse_motion(0, 1);
+    unregister_code(KC_LEFT_CTRL);
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    send_mouse_motion(0, 0);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, DelaysReachTheHost) {
+    TestDriver            driver;
+    std::vector<uint16_t> times;
+    auto                  record_time = [&](report_keyboard_t &) { times.push_back(timer_read()); };
+
+    EXPECT_REPORT(driver, (KC_A)).WillOnce(Invoke(record_time));
+    EXPECT_EMPTY_REPORT(driver).WillOnce(Invoke(record_time));
+    tap_code_delay(KC_A, 20);
+    run_one_scan_loop();
+    ASSERT_EQ(times.size(), 2u);
+    EXPECT_GE(times[1] - times[0], 20);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, DelaysInTapCode16ReachTheHost) {
+    TestDriver            driver;
+    std::vector<uint16_t> times;
+    auto                  record_time = [&](report_keyboard_t &) { times.push_back(timer_read()); };
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A)).WillOnce(Invoke(record_time));
+    EXPECT_EMPTY_REPORT(driver).WillOnce(Invoke(record_time));
+    tap_code16_delay(LSFT(KC_A), 20);
+    run_one_scan_loop();
+    ASSERT_EQ(times.size(), 2u);
+    EXPECT_GE(times[1] - times[0], 20);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, ExtraReportsDoNotOvertakeAHeldReport) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_CALL(driver, send_extra_mock(_));
+    register_code(KC_LEFT_SHIFT);
+    host_consumer_send(0x00E9);
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_CALL(driver, send_extra_mock(_));
+    unregister_code(KC_LEFT_SHIFT);
+    host_consumer_send(0);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,60 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "mouse_report_util.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class ReportCoalescingUsbFrame : public TestFixture {};
+
+static void send_mouse_motion(int8_t x) {
+    report_mouse_t report = {};
+    report.x              = x;
+    host_mouse_send(&report);
+}
+
+TEST_F(ReportCoalescingUsbFrame, ScansWithinOneFrameAreMerged) {
+    TestDriver driver;
+    InSequence s;
+    idle_for(5);
+
+    // Several scans within the same millisecond, after a report was already sent in it
+    EXPECT_REPORT(driver, (KC_A));
+    register_code(KC_A);
+    keyboard_task();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    send_mouse_motion(3);
+    keyboard_task();
+    send_mouse_motion(4);
+    keyboard_task();
+    VERIFY_AND_CLEAR(driver);
+
+    // One more scan in this frame, then the first scan of the next
+    EXPECT_MOUSE_REPORT(driver, (7, 0, 0, 0, 0));
+    idle_for(2);
+    EXPECT_REPORT_COUNTS(driver, 3, 2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    unregister_code(KC_A);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescingUsbFrame, FlushSendsWithinTheFrame) {
+    TestDriver driver;
+    idle_for(5);
+
+    EXPECT_REPORT(driver, (KC_A));
+    register_code(KC_A);
+    keyboard_task();
+    EXPECT_EMPTY_REPORT(driver);
+    unregister_code(KC_A);
+    host_flush_reports();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,110 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include "test_common.hpp"
+
+extern "C" {
+#include "task_scheduler.h"
+#include "timer.h"
+}
+
+static uint32_t    simulated_us = 0;
+static std::string call_log;
+static uint32_t    high_calls     = 0;
+static uint32_t    cosmetic_calls = 0;
+static uint32_t    high_cost_us   = 0;
+
+extern "C" uint32_t task_scheduler_timestamp(void) {
+    return timer_read_us() + simulated_us;
+}
+
+static void high_task(void) {
+    high_calls++;
+    call_log += 'H';
+    simulated_us += high_cost_us;
+}
+
+static void cosmetic_task(void) {
+    cosmetic_calls++;
+    call_log += 'C';
+}
+
+class TaskScheduler : public TestFixture {
+   public:
+    void SetUp() override {
+        simulated_us   = 0;
+        high_calls     = 0;
+        cosmetic_calls = 0;
+        high_cost_us   = 0;
+        call_log.clear();
+        task_scheduler_init();
+    }
+};
+
+TEST_F(TaskScheduler, RunsTasksAtTheirPeriod) {
+    TestDriver driver;
+    ASSERT_TRUE(task_scheduler_register(high_task, 5, TASK_PRIORITY_HIGH, 0));
+    ASSERT_TRUE(task_scheduler_register(cosmetic_task, 1, TASK_PRIORITY_COSMETIC, 100));
+
+    idle_for(50);
+
+    EXPECT_GE(high_calls, 9);
+    EXPECT_LE(high_calls, 10);
+    EXPECT_GE(cosmetic_calls, 48);
+    EXPECT_EQ(task_scheduler_deferral_count(), 0);
+}
+
+TEST_F(TaskScheduler, HigherPriorityRunsFirst) {
+    TestDriver driver;
+    ASSERT_TRUE(task_scheduler_register(cosmetic_task, 1, TASK_PRIORITY_COSMETIC, 0));
+    ASSERT_TRUE(task_scheduler_register(high_task, 1, TASK_PRIORITY_HIGH, 0));
+
+    idle_for(3);
+
+    EXPECT_EQ(call_log.substr(0, 4), "HCHC");
+}
+
+TEST_F(TaskScheduler, CosmeticTasksAreDeferredWhenOverBudget) {
+    TestDriver driver;
+    // The high priority task alone uses up more than the loop budget
+    high_cost_us = TASK_SCHEDULER_LOOP_BUDGET_US + 1;
+    ASSERT_TRUE(task_scheduler_register(high_task, 1, TASK_PRIORITY_HIGH, 0));
+    ASSERT_TRUE(task_scheduler_register(cosmetic_task, 1, TASK_PRIORITY_COSMETIC, 100));
+
+    // Registered tasks first become due on the tick after registration
+    idle_for(TASK_SCHEDULER_MAX_DEFERRALS + 2);
+    EXPECT_EQ(high_calls, TASK_SCHEDULER_MAX_DEFERRALS + 1);
+    EXPECT_EQ(task_scheduler_deferral_count(), TASK_SCHEDULER_MAX_DEFERRALS);
+
+    // Starvation guard: after too many deferrals the task runs anyway
+    EXPECT_EQ(cosmetic_calls, 1);
+
+    // With the loop back within budget, the cosmetic task runs every tick again
+    high_cost_us = 0;
+    idle_for(10);
+    EXPECT_GE(cosmetic_calls, 10);
+}
+
+TEST_F(TaskScheduler, CosmeticTaskOwnCostCountsAgainstTheBudget) {
+    TestDriver driver;
+    ASSERT_TRUE(task_scheduler_register(cosmetic_task, 1, TASK_PRIORITY_COSMETIC, TASK_SCHEDULER_LOOP_BUDGET_US + 1));
+
+    idle_for(2 * (TASK_SCHEDULER_MAX_DEFERRALS + 1) + 1);
+    EXPECT_EQ(cosmetic_calls, 2);
+    EXPECT_EQ(task_scheduler_deferral_count(), 2 * TASK_SCHEDULER_MAX_DEFERRALS);
+}
+
+TEST_F(TaskScheduler, UnregisteredTasksStopRunning) {
+    TestDriver driver;
+    EXPECT_FALSE(task_scheduler_register(high_task, 0, TASK_PRIORITY_HIGH, 0));
+    ASSERT_TRUE(task_scheduler_register(high_task, 1, TASK_PRIORITY_HIGH, 0));
+    idle_for(5);
+    EXPECT_GT(high_calls, 0);
+
+    ASSERT_TRUE(task_scheduler_unregister(high_task));
+    uint32_t calls = high_calls;
+    idle_for(5);
+    EXPECT_EQ(high_calls, calls);
+    EXPECT_FALSE(task_scheduler_unregister(high_task));
+}
@@ -31,9 +31,17 @@ uint8_t hex_digit_to_keycode(uint8_t digit) {
 }
 } // namespace
 
-TestDriver::TestDriver() : m_driver{&TestDriver::keyboard_leds, &TestDriver::send_keyboard, &TestDriver::send_nkro, &TestDriver::send_mouse, &TestDriver::send_extra} {
+TestDriver::TestDriver()
+    : m_driver{&TestDriver::keyboard_leds, &TestDriver::send_keyboard, &TestDriver::send_nkro, &TestDriver::send_mouse, &TestDriver::send_extra,
+#ifdef RAW_ENABLE
+               &TestDriver::send_raw_hid
+#endif
+      } {
     host_set_driver(&m_driver);
     m_this = this;
+#ifdef REPORT_COALESCING_ENABLE
+    host_reset_report_stats();
+#endif
 }
 
 TestDriver::~TestDriver() {
@@ -46,15 +54,18 @@ uint8_t TestDriver::keyboard_leds(void) {
 
 void TestDriver::send_keyboard(report_keyboard_t* report) {
     test_logger.trace() << *report;
+    m_this->m_report_count++;
     m_this->send_keyboard_mock(*report);
 }
 
 void TestDriver::send_nkro(report_nkro_t* report) {
+    m_this->m_report_count++;
     m_this->send_nkro_mock(*report);
 }
 
 void TestDriver::send_mouse(report_mouse_t* report) {
     test_logger.trace() << std::setw(10) << std::left << "send_mouse: (X:" << (int)report->x << ", Y:" << (int)report->y << ", H:" << (int)report->h << ", V:" << (int)report->v << ", B:" << (int)report->buttons << ")" << std::endl;
+    m_this->m_report_count++;
     m_this->send_mouse_mock(*report);
 }
 
@@ -62,6 +73,12 @@ void TestDriver::send_extra(report_extra_t* report) {
     m_this->send_extra_mock(*report);
 }
 
+#ifdef RAW_ENABLE
+void TestDriver::send_raw_hid(uint8_t* data, uint8_t length) {
+    m_this->send_raw_hid_mock(std::vector<uint8_t>(data, data + length));
+}
+#endif
+
 namespace internal {
 void expect_unicode_code_point(TestDriver& driver, uint32_t code_point) {
     testing::InSequence seq;
@@ -87,4 +104,14 @@ void expect_unicode_code_point(TestDriver& driver, uint32_t code_point) {
     EXPECT_REPORT(driver, (KC_SPACE));
     EXPECT_EMPTY_REPORT(driver);
 }
+
+#ifdef REPORT_COALESCING_ENABLE
+void expect_report_counts(const TestDriver& driver, uint32_t submitted, uint32_t sent) {
+    host_report_stats_t stats;
+    host_get_report_stats(&stats);
+    EXPECT_EQ(stats.submitted, submitted) << "reports submitted to the host layer";
+    EXPECT_EQ(stats.sent, sent) << "reports sent by the host layer";
+    EXPECT_EQ(driver.report_count(), sent) << "reports received by the driver";
+}
+#endif
 } // namespace internal
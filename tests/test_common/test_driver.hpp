@@ -18,6 +18,7 @@
 
 #include "gmock/gmock.h"
 #include <stdint.h>
+#include <vector>
 #include "host.h"
 #include "keyboard_report_util.hpp"
 extern "C" {
@@ -37,6 +38,14 @@ class TestDriver {
     MOCK_METHOD1(send_nkro_mock, void(report_nkro_t&));
     MOCK_METHOD1(send_mouse_mock, void(report_mouse_t&));
     MOCK_METHOD1(send_extra_mock, void(report_extra_t&));
+#ifdef RAW_ENABLE
+    MOCK_METHOD1(send_raw_hid_mock, void(std::vector<uint8_t>));
+#endif
+
+    /* Number of keyboard, NKRO and mouse reports received since the driver was created */
+    uint32_t report_count() const {
+        return m_report_count;
+    }
 
    private:
     static uint8_t     keyboard_leds(void);
@@ -44,8 +53,12 @@ class TestDriver {
     static void        send_nkro(report_nkro_t* report);
     static void        send_mouse(report_mouse_t* report);
     static void        send_extra(report_extra_t* report);
+#ifdef RAW_ENABLE
+    static void send_raw_hid(uint8_t* data, uint8_t length);
+#endif
     host_driver_t      m_driver;
-    uint8_t            m_leds = 0;
+    uint8_t            m_leds         = 0;
+    uint32_t           m_report_count = 0;
     static TestDriver* m_this;
 };
 
@@ -156,6 +169,17 @@ MATCHER_P(KeycodeEq, expected_keycode, "is equal to " + testing::PrintToString(e
     return false;
 }
 
+#ifdef REPORT_COALESCING_ENABLE
+/**
+ * @brief Checks how many keyboard, NKRO and mouse reports were submitted to the host layer, and how many of them
+ * reached the driver after coalescing, since the driver was created. For instance,
+ *
+ *   // Six reports produced by SEND_STRING("Ab"), merged into three.
+ *   EXPECT_REPORT_COUNTS(driver, 6, 3);
+ */
+#    define EXPECT_REPORT_COUNTS(driver, submitted, sent) internal::expect_report_counts((driver), (submitted), (sent))
+#endif
+
 /**
  * @brief Verify and clear all gmock expectations that have been setup until
  * this point.
@@ -164,4 +188,7 @@ MATCHER_P(KeycodeEq, expected_keycode, "is equal to " + testing::PrintToString(e
 
 namespace internal {
 void expect_unicode_code_point(TestDriver& driver, uint32_t code_point);
+#ifdef REPORT_COALESCING_ENABLE
+void expect_report_counts(const TestDriver& driver, uint32_t submitted, uint32_t sent);
+#endif
 } // namespace internal
@@ -0,0 +1,283 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <functional>
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom_test.h"
+#include "raw_hid.h"
+#include "via.h"
+}
+
+using testing::_;
+using testing::Invoke;
+
+#define REPORT_SIZE 32
+
+static uint16_t crc16(const uint8_t *data, size_t length, uint16_t crc = 0xFFFF) {
+    while (length--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// Plays the host side of the protocol, counting the round trips it takes
+class ViaBulk : public TestFixture {
+   protected:
+    TestDriver                        driver;
+    std::vector<std::vector<uint8_t>> replies;
+    int                               round_trips = 0;
+
+    // Hooks for simulating a lossy link: return false to drop a data packet, or true to corrupt it
+    std::function<bool(int window, int index)> deliver = nullptr;
+    std::function<bool(int window, int index)> corrupt = nullptr;
+
+    void SetUp() override {
+        EXPECT_CALL(driver, send_raw_hid_mock(_)).WillRepeatedly(Invoke([this](std::vector<uint8_t> report) { replies.push_back(report); }));
+    }
+
+    void send(std::vector<uint8_t> report) {
+        report.resize(REPORT_SIZE);
+        raw_hid_receive(report.data(), report.size());
+    }
+
+    std::vector<uint8_t> request(std::vector<uint8_t> report) {
+        replies.clear();
+        send(report);
+        round_trips++;
+        EXPECT_EQ(replies.size(), 1);
+        return replies.empty() ? std::vector<uint8_t>(REPORT_SIZE) : replies.back();
+    }
+
+    uint8_t upload(uint8_t target, uint16_t offset, const std::vector<uint8_t> &data) {
+        auto reply = request({id_bulk_begin, target, (uint8_t)(offset >> 8), (uint8_t)offset, (uint8_t)(data.size() >> 8), (uint8_t)data.size()});
+        if (reply[1] != id_bulk_ok) {
+            return reply[1];
+        }
+        size_t   window_size = reply[2] * reply[3];
+        uint8_t  payload     = reply[3];
+        uint16_t position    = 0;
+        int      window      = 0;
+        int      attempts    = 0;
+
+        while (position < data.size() && attempts++ < 100) {
+            size_t length = std::min(window_size, data.size() - position);
+            for (size_t start = 0; start < length; start += payload) {
+                int index = start / payload;
+                if (deliver && !deliver(window, index)) {
+                    continue;
+                }
+                std::vector<uint8_t> packet = {id_bulk_data, (uint8_t)index};
+                packet.insert(packet.end(), data.begin() + position + start, data.begin() + position + std::min(start + payload, length));
+                if (corrupt && corrupt(window, index)) {
+                    packet[2] ^= 0xFF;
+                }
+                replies.clear();
+                send(packet);
+                EXPECT_TRUE(replies.empty()) << "data packets are not acknowledged individually";
+            }
+            uint16_t crc = crc16(&data[position], length);
+            reply        = request({id_bulk_ack, (uint8_t)(crc >> 8), (uint8_t)crc});
+            position     = (reply[2] << 8) | reply[3];
+            window++;
+        }
+
+        uint16_t crc = crc16(data.data(), data.size());
+        reply        = request({id_bulk_commit, (uint8_t)(crc >> 8), (uint8_t)crc});
+        return reply[1];
+    }
+
+    static std::vector<uint8_t> keymap_bytes(uint16_t seed) {
+        std::vector<uint8_t> data(dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2);
+        for (size_t i = 0; i < data.size(); i += 2) {
+            uint16_t keycode = KC_A + ((i / 2 + seed) % 26);
+            data[i]          = keycode >> 8;
+            data[i + 1]      = keycode & 0xFF;
+        }
+        return data;
+    }
+
+    static std::vector<uint8_t> keymap_contents(void) {
+        std::vector<uint8_t> data(dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2);
+        dynamic_keymap_get_buffer(0, data.size(), data.data());
+        return data;
+    }
+};
+
+TEST_F(ViaBulk, ProtocolVersionUnchanged) {
+    auto reply = request({id_get_protocol_version});
+    EXPECT_EQ(reply[0], id_get_protocol_version);
+    EXPECT_EQ((reply[1] << 8) | reply[2], 0x000C);
+}
+
+TEST_F(ViaBulk, ReportsCapabilities) {
+    auto reply = request({id_get_keyboard_value, id_bulk_capabilities});
+    EXPECT_EQ(reply[0], id_get_keyboard_value);
+    EXPECT_EQ(reply[1], id_bulk_capabilities);
+    EXPECT_EQ(reply[2], 1);
+    EXPECT_EQ(reply[3], VIA_BULK_WINDOW_SIZE);
+    EXPECT_EQ(reply[4], REPORT_SIZE - 2);
+}
+
+TEST_F(ViaBulk, StreamsWholeKeymap) {
+    auto data = keymap_bytes(1);
+    EXPECT_EQ(upload(id_bulk_keymap, 0, data), id_bulk_ok);
+    EXPECT_EQ(keymap_contents(), data);
+    EXPECT_EQ(dynamic_keymap_get_keycode(15, 3, 9), (uint16_t)((data[data.size() - 2] << 8) | data[data.size() - 1]));
+
+    // Begin, one acknowledgement per window and the commit, against one per 28 bytes for id_dynamic_keymap_set_buffer
+    int windows = (data.size() + VIA_BULK_WINDOW_SIZE * (REPORT_SIZE - 2) - 1) / (VIA_BULK_WINDOW_SIZE * (REPORT_SIZE - 2));
+    EXPECT_EQ(round_trips, windows + 2);
+    EXPECT_LT(round_trips * 5, (int)(data.size() + 27) / 28);
+}
+
+TEST_F(ViaBulk, WritesOneBlockPerWindow) {
+    auto data = keymap_bytes(2);
+    eeprom_test_reset_write_count();
+    EXPECT_EQ(upload(id_bulk_keymap, 0, data), id_bulk_ok);
+    EXPECT_EQ(eeprom_test_get_write_count(), round_trips - 2);
+}
+
+TEST_F(ViaBulk, PartialRange) {
+    auto before = keymap_contents();
+    auto data   = std::vector<uint8_t>{0x00, KC_Q, 0x00, KC_W, 0x00, KC_E};
+    EXPECT_EQ(upload(id_bulk_keymap, 100, data), id_bulk_ok);
+
+    std::copy(data.begin(), data.end(), before.begin() + 100);
+    EXPECT_EQ(keymap_contents(), before);
+}
+
+TEST_F(ViaBulk, DroppedPacketIsResent) {
+    auto data    = keymap_bytes(3);
+    bool dropped = false;
+    deliver      = [&](int window, int index) {
+        if (window == 1 && index == 3 && !dropped) {
+            dropped = true;
+            return false;
+        }
+        return true;
+    };
+    EXPECT_EQ(upload(id_bulk_keymap, 0, data), id_bulk_ok);
+    EXPECT_TRUE(dropped);
+    EXPECT_EQ(keymap_contents(), data);
+}
+
+TEST_F(ViaBulk, CorruptWindowIsNotWritten) {
+    auto data      = keymap_bytes(4);
+    auto before    = keymap_contents();
+    bool checked   = false;
+    bool corrupted = false;
+    corrupt        = [&](int window, int index) {
+        if (window == 2 && index == 0) {
+            // The window before the corrupt one has been written, and the corrupt one not yet
+            size_t window_size = VIA_BULK_WINDOW_SIZE * (REPORT_SIZE - 2);
+            auto   current     = keymap_contents();
+            EXPECT_TRUE(std::equal(data.begin(), data.begin() + 2 * window_size, current.begin()));
+            EXPECT_TRUE(std::equal(before.begin() + 2 * window_size, before.begin() + 3 * window_size, current.begin() + 2 * window_size));
+            checked = true;
+        }
+        if (window == 2 && index == 1 && !corrupted) {
+            corrupted = true;
+            return true;
+        }
+        return false;
+    };
+    EXPECT_EQ(upload(id_bulk_keymap, 0, data), id_bulk_ok);
+    EXPECT_TRUE(checked);
+    EXPECT_EQ(keymap_contents(), data);
+}
+
+TEST_F(ViaBulk, RepeatedAckReportsPosition) {
+    std::vector<uint8_t> data(40, 0x11);
+    auto                 reply = request({id_bulk_begin, id_bulk_keymap, 0, 0, 0, (uint8_t)data.size()});
+    ASSERT_EQ(reply[1], id_bulk_ok);
+    send({id_bulk_data, 0, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11});
+    send({id_bulk_data, 1, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11});
+
+    uint16_t crc = crc16(data.data(), data.size());
+    reply        = request({id_bulk_ack, (uint8_t)(crc >> 8), (uint8_t)crc});
+    EXPECT_EQ(reply[1], id_bulk_ok);
+    EXPECT_EQ((reply[2] << 8) | reply[3], 40);
+
+    // As if the reply had been lost -- the host learns the window already landed
+    reply = request({id_bulk_ack, (uint8_t)(crc >> 8), (uint8_t)crc});
+    EXPECT_EQ(reply[1], id_bulk_missing);
+    EXPECT_EQ((reply[2] << 8) | reply[3], 40);
+
+    reply = request({id_bulk_commit, (uint8_t)(crc >> 8), (uint8_t)crc});
+    EXPECT_EQ(reply[1], id_bulk_ok);
+}
+
+TEST_F(ViaBulk, CommitChecksWholeTransfer) {
+    std::vector<uint8_t> data(10, 0x22);
+    auto                 reply = request({id_bulk_begin, id_bulk_keymap, 0, 0, 0, (uint8_t)data.size()});
+    ASSERT_EQ(reply[1], id_bulk_ok);
+
+    reply = request({id_bulk_commit, 0, 0});
+    EXPECT_EQ(reply[1], id_bulk_missing);
+
+    std::vector<uint8_t> packet = {id_bulk_data, 0};
+    packet.insert(packet.end(), data.begin(), data.end());
+    send(packet);
+    uint16_t crc = crc16(data.data(), data.size());
+    reply        = request({id_bulk_ack, (uint8_t)(crc >> 8), (uint8_t)crc});
+    EXPECT_EQ(reply[1], id_bulk_ok);
+
+    reply = request({id_bulk_commit, (uint8_t)(crc >> 8), (uint8_t)(crc + 1)});
+    EXPECT_EQ(reply[1], id_bulk_bad_crc);
+    reply = request({id_bulk_commit, (uint8_t)(crc >> 8), (uint8_t)crc});
+    EXPECT_EQ(reply[1], id_bulk_ok);
+
+    // The session is over
+    reply = request({id_bulk_commit, (uint8_t)(crc >> 8), (uint8_t)crc});
+    EXPECT_EQ(reply[1], id_bulk_no_session);
+    reply = request({id_bulk_ack, (uint8_t)(crc >> 8), (uint8_t)crc});
+    EXPECT_EQ(reply[1], id_bulk_no_session);
+}
+
+TEST_F(ViaBulk, RejectsBadTargetAndRange) {
+    uint16_t size = dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+
+    EXPECT_EQ(request({id_bulk_begin, 7, 0, 0, 0, 2})[1], id_bulk_bad_target);
+    EXPECT_EQ(request({id_bulk_begin, id_bulk_keymap, 0, 0, 0, 0})[1], id_bulk_bad_range);
+    uint16_t last = size - 1;
+    EXPECT_EQ(request({id_bulk_begin, id_bulk_keymap, (uint8_t)(last >> 8), (uint8_t)last, 0, 2})[1], id_bulk_bad_range);
+    last = size - 2;
+    EXPECT_EQ(request({id_bulk_begin, id_bulk_keymap, (uint8_t)(last >> 8), (uint8_t)last, 0, 2})[1], id_bulk_ok);
+}
+
+TEST_F(ViaBulk, StreamsMacros) {
+    std::vector<uint8_t> data(dynamic_keymap_macro_get_buffer_size());
+    const char           macros[] = "hello\0world";
+    std::copy(macros, macros + sizeof(macros), data.begin());
+    EXPECT_EQ(upload(id_bulk_macro, 0, data), id_bulk_ok);
+
+    std::vector<uint8_t> contents(data.size());
+    dynamic_keymap_macro_get_buffer(0, contents.size(), contents.data());
+    EXPECT_EQ(contents, data);
+}
+
+TEST_F(ViaBulk, ReadStreamsWindow) {
+    auto data = keymap_bytes(5);
+    dynamic_keymap_set_buffer(0, data.size(), data.data());
+
+    replies.clear();
+    send({id_bulk_read, id_bulk_keymap, 0, 60, 255});
+    // Clamped to a window, one report per packet
+    ASSERT_EQ(replies.size(), VIA_BULK_WINDOW_SIZE);
+    for (size_t index = 0; index < replies.size(); index++) {
+        EXPECT_EQ(replies[index][0], id_bulk_read);
+        EXPECT_EQ(replies[index][1], index);
+        EXPECT_TRUE(std::equal(replies[index].begin() + 2, replies[index].end(), data.begin() + 60 + index * (REPORT_SIZE - 2)));
+    }
+
+    replies.clear();
+    send({id_bulk_read, 9, 0, 0, 1});
+    ASSERT_EQ(replies.size(), 1);
+    EXPECT_EQ(replies[0][0], id_unhandled);
+}
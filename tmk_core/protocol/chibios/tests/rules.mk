@@ -0,0 +1,5 @@
+usb_report_queue_SRC := \
+	$(TMK_PATH)/protocol/chibios/usb_report_queue.c \
+	$(TMK_PATH)/protocol/chibios/tests/usb_report_queue_tests.cpp
+usb_report_queue_INC := \
+	$(TMK_PATH)/protocol/chibios
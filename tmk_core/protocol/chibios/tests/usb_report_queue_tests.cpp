@@ -0,0 +1,260 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "usb_report_queue.h"
+}
+
+namespace {
+
+constexpr size_t  REPORT_SIZE = 8;
+constexpr uint8_t CAPACITY    = 4;
+
+// Stands in for the USB driver: one transfer at a time, which the test completes
+struct mock_endpoint_t {
+    bool                              active       = true;
+    bool                              transmitting = false;
+    std::vector<std::vector<uint8_t>> sent;
+    std::vector<const uint8_t *>      sent_from;
+};
+
+bool mock_transmit(usb_report_queue_t *queue, uint8_t *data, size_t size) {
+    mock_endpoint_t *endpoint = (mock_endpoint_t *)queue->link;
+    if (!endpoint->active || endpoint->transmitting) {
+        return false;
+    }
+    endpoint->transmitting = true;
+    endpoint->sent.emplace_back(data, data + size);
+    endpoint->sent_from.push_back(data);
+    return true;
+}
+
+} // namespace
+
+class UsbReportQueue : public ::testing::Test {
+   protected:
+    alignas(4) uint8_t buffer[USB_REPORT_QUEUE_BUFFER_SIZE(CAPACITY, REPORT_SIZE)];
+    usb_report_queue_t queue;
+    mock_endpoint_t    endpoint;
+
+    void SetUp() override {
+        init(REPORT_SIZE);
+    }
+
+    void init(size_t report_size) {
+        usb_report_queue_init(&queue, buffer, report_size, CAPACITY, mock_transmit, &endpoint);
+        usb_report_queue_resume(&queue);
+    }
+
+    bool send(uint8_t value, size_t size = REPORT_SIZE) {
+        uint8_t *slot = usb_report_queue_acquire(&queue);
+        if (slot == nullptr) {
+            return false;
+        }
+        memset(slot, value, size);
+        usb_report_queue_commit(&queue, size);
+        return true;
+    }
+
+    // The transfer completion interrupt
+    void complete() {
+        endpoint.transmitting = false;
+        usb_report_queue_complete(&queue);
+    }
+
+    std::vector<uint8_t> report(uint8_t value, size_t size = REPORT_SIZE) {
+        return std::vector<uint8_t>(size, value);
+    }
+};
+
+TEST_F(UsbReportQueue, SlotIsSentWithoutCopying) {
+    uint8_t *slot = usb_report_queue_acquire(&queue);
+    ASSERT_NE(slot, nullptr);
+    EXPECT_EQ((uintptr_t)slot % 4, 0u);
+    memset(slot, 0x11, REPORT_SIZE);
+    usb_report_queue_commit(&queue, REPORT_SIZE);
+
+    ASSERT_EQ(endpoint.sent.size(), 1u);
+    EXPECT_EQ(endpoint.sent_from[0], slot);
+    EXPECT_EQ(endpoint.sent[0], report(0x11));
+}
+
+TEST_F(UsbReportQueue, AcquireReturnsTheSameSlotUntilCommitted) {
+    uint8_t *slot = usb_report_queue_acquire(&queue);
+    EXPECT_EQ(usb_report_queue_acquire(&queue), slot);
+    usb_report_queue_commit(&queue, REPORT_SIZE);
+    EXPECT_NE(usb_report_queue_acquire(&queue), slot);
+}
+
+TEST_F(UsbReportQueue, ReportsQueuedWhileBusyGoOutBackToBack) {
+    EXPECT_TRUE(send(1));
+    EXPECT_TRUE(send(2));
+    EXPECT_TRUE(send(3));
+    EXPECT_EQ(endpoint.sent.size(), 1u);
+
+    // Each completion starts the next report straight away
+    complete();
+    EXPECT_EQ(endpoint.sent.size(), 2u);
+    complete();
+    EXPECT_EQ(endpoint.sent.size(), 3u);
+    complete();
+    EXPECT_TRUE(usb_report_queue_is_empty(&queue));
+    EXPECT_EQ(endpoint.sent, (std::vector<std::vector<uint8_t>>{report(1), report(2), report(3)}));
+}
+
+TEST_F(UsbReportQueue, FullQueueRefusesReports) {
+    for (uint8_t i = 0; i < CAPACITY; ++i) {
+        EXPECT_TRUE(send(i));
+    }
+    EXPECT_TRUE(usb_report_queue_is_full(&queue));
+    EXPECT_EQ(usb_report_queue_acquire(&queue), nullptr);
+
+    complete();
+    EXPECT_TRUE(send(CAPACITY));
+}
+
+TEST_F(UsbReportQueue, InFlightReportIsAvailableUntilComplete) {
+    size_t size = 0;
+    EXPECT_EQ(usb_report_queue_in_flight(&queue, &size), nullptr);
+
+    send(7, 5);
+    uint8_t *data = usb_report_queue_in_flight(&queue, &size);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(std::vector<uint8_t>(data, data + size), report(7, 5));
+
+    complete();
+    EXPECT_EQ(usb_report_queue_in_flight(&queue, &size), nullptr);
+}
+
+TEST_F(UsbReportQueue, RefusedTransfersAreRetried) {
+    endpoint.active = false;
+    send(1);
+    send(2);
+    EXPECT_TRUE(endpoint.sent.empty());
+
+    // The oldest report goes first once the endpoint takes transfers again
+    endpoint.active = true;
+    send(3);
+    ASSERT_EQ(endpoint.sent.size(), 1u);
+    EXPECT_EQ(endpoint.sent[0], report(1));
+}
+
+TEST_F(UsbReportQueue, CompletionAfterResetStartsWaitingReports) {
+    send(1);
+    usb_report_queue_reset(&queue);
+
+    // The transfer from before the reset is still running
+    send(2);
+    EXPECT_EQ(endpoint.sent.size(), 1u);
+    complete();
+    ASSERT_EQ(endpoint.sent.size(), 2u);
+    EXPECT_EQ(endpoint.sent[1], report(2));
+}
+
+TEST_F(UsbReportQueue, DroppingPendingReportsKeepsTheOneInFlight) {
+    for (uint8_t i = 0; i < CAPACITY; ++i) {
+        send(i);
+    }
+    size_t   size;
+    uint8_t *in_flight = usb_report_queue_in_flight(&queue, &size);
+    usb_report_queue_drop_pending(&queue);
+
+    // Only the slot being transferred is still taken, and it isn't handed out again
+    EXPECT_EQ(usb_report_queue_in_flight(&queue, &size), in_flight);
+    for (uint8_t i = 1; i < CAPACITY; ++i) {
+        uint8_t *slot = usb_report_queue_acquire(&queue);
+        ASSERT_NE(slot, nullptr);
+        EXPECT_NE(slot, in_flight);
+        memset(slot, 0x10 + i, REPORT_SIZE);
+        usb_report_queue_commit(&queue, REPORT_SIZE);
+    }
+    EXPECT_EQ(usb_report_queue_acquire(&queue), nullptr);
+    EXPECT_EQ(std::vector<uint8_t>(in_flight, in_flight + REPORT_SIZE), report(0));
+
+    // The dropped reports never go out, the ones queued after them do
+    for (uint8_t i = 1; i < CAPACITY; ++i) {
+        complete();
+    }
+    complete();
+    ASSERT_EQ(endpoint.sent.size(), (size_t)CAPACITY);
+    EXPECT_EQ(endpoint.sent[0], report(0));
+    for (uint8_t i = 1; i < CAPACITY; ++i) {
+        EXPECT_EQ(endpoint.sent[i], report(0x10 + i));
+    }
+    EXPECT_TRUE(usb_report_queue_is_empty(&queue));
+}
+
+TEST_F(UsbReportQueue, DroppingPendingReportsWhenIdleEmptiesTheQueue) {
+    endpoint.active = false;
+    send(1);
+    send(2);
+    usb_report_queue_drop_pending(&queue);
+    EXPECT_TRUE(usb_report_queue_is_empty(&queue));
+
+    endpoint.active = true;
+    send(3);
+    ASSERT_EQ(endpoint.sent.size(), 1u);
+    EXPECT_EQ(endpoint.sent[0], report(3));
+}
+
+TEST_F(UsbReportQueue, SuspendDropsQueuedReports) {
+    send(1);
+    send(2);
+    usb_report_queue_suspend(&queue);
+    endpoint.transmitting = false;
+    EXPECT_TRUE(usb_report_queue_is_empty(&queue));
+    EXPECT_EQ(usb_report_queue_acquire(&queue), nullptr);
+    EXPECT_FALSE(send(3));
+
+    usb_report_queue_resume(&queue);
+    EXPECT_TRUE(send(4));
+    ASSERT_EQ(endpoint.sent.size(), 2u);
+    EXPECT_EQ(endpoint.sent[1], report(4));
+}
+
+TEST_F(UsbReportQueue, OddSizedReportsStayAligned) {
+    init(5);
+    for (uint8_t i = 0; i < CAPACITY; ++i) {
+        uint8_t *slot = usb_report_queue_acquire(&queue);
+        ASSERT_NE(slot, nullptr);
+        EXPECT_EQ((uintptr_t)slot % 4, 0u);
+        EXPECT_LE(slot + 5, buffer + sizeof(buffer));
+        usb_report_queue_commit(&queue, 5);
+    }
+}
+
+TEST_F(UsbReportQueue, StutteringSenderLosesNothing) {
+    // Reports are produced once per poll on average, in bursts of up to the
+    // queue capacity, and the host polls at a steady rate
+    std::mt19937         rng(1);
+    std::vector<uint8_t> expected;
+    std::vector<uint8_t> received;
+    uint8_t              next    = 0;
+    int                  backlog = 0;
+
+    for (int poll = 0; poll < 10000; ++poll) {
+        backlog += 1;
+        if (rng() % 4 == 0) {
+            while (backlog > 0 && send(next)) {
+                expected.push_back(next++);
+                backlog--;
+            }
+        }
+        if (endpoint.transmitting) {
+            received.push_back(endpoint.sent.back()[0]);
+            complete();
+        }
+    }
+    while (endpoint.transmitting) {
+        received.push_back(endpoint.sent.back()[0]);
+        complete();
+    }
+
+    EXPECT_EQ(received, expected);
+    EXPECT_TRUE(usb_report_queue_is_empty(&queue));
+}
@@ -74,6 +74,40 @@ static void obnotify(io_buffers_queue_t *bqp) {
     }
 }
 
+#if defined(USB_REPORT_QUEUE_ENABLE)
+/**
+ * @brief   Starts the transfer of a report committed to the report queue.
+ *
+ * @param[in] queue     the report queue pointer.
+ */
+static bool report_queue_transmit(usb_report_queue_t *queue, uint8_t *data, size_t size) {
+    usb_endpoint_in_t *endpoint = queue->link;
+
+    /* If the USB endpoint is not in the appropriate state then transactions
+       must not be started.*/
+    if ((usbGetDriverStateI(endpoint->config.usbp) != USB_ACTIVE) || usbGetTransmitStatusI(endpoint->config.usbp, endpoint->config.ep)) {
+        return false;
+    }
+
+    usbStartTransmitI(endpoint->config.usbp, endpoint->config.ep, data, size);
+    return true;
+}
+
+/**
+ * @brief   Whether reports sent unbuffered go through the report queue. Bulk
+ *          endpoints keep the output buffers queue, which takes care of zero
+ *          length packets.
+ */
+static inline bool uses_report_queue(usb_endpoint_in_t *endpoint) {
+    return (endpoint->ep_config.ep_mode & USB_EP_MODE_TYPE) == USB_EP_MODE_TYPE_INTR;
+}
+
+static void report_queue_suspend(usb_endpoint_in_t *endpoint) {
+    usb_report_queue_suspend(&endpoint->report_queue);
+    osalThreadDequeueAllI(&endpoint->report_waiting, MSG_RESET);
+}
+#endif
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -88,6 +122,10 @@ void usb_endpoint_in_init(usb_endpoint_in_t *endpoint) {
     }
 #endif
     obqObjectInit(&endpoint->obqueue, true, config->buffer, config->buffer_size, config->buffer_capacity, obnotify, endpoint);
+#if defined(USB_REPORT_QUEUE_ENABLE)
+    usb_report_queue_init(&endpoint->report_queue, config->buffer, config->buffer_size, config->buffer_capacity, report_queue_transmit, endpoint);
+    osalThreadQueueObjectInit(&endpoint->report_waiting);
+#endif
 }
 
 void usb_endpoint_out_init(usb_endpoint_out_t *endpoint) {
@@ -124,6 +162,9 @@ void usb_endpoint_in_stop(usb_endpoint_in_t *endpoint) {
 
     bqSuspendI(&endpoint->obqueue);
     obqResetI(&endpoint->obqueue);
+#if defined(USB_REPORT_QUEUE_ENABLE)
+    report_queue_suspend(endpoint);
+#endif
     if (endpoint->report_storage != NULL) {
         endpoint->report_storage->reset_report(endpoint->report_storage->reports);
     }
@@ -146,6 +187,9 @@ void usb_endpoint_out_stop(usb_endpoint_out_t *endpoint) {
 void usb_endpoint_in_suspend_cb(usb_endpoint_in_t *endpoint) {
     bqSuspendI(&endpoint->obqueue);
     obqResetI(&endpoint->obqueue);
+#if defined(USB_REPORT_QUEUE_ENABLE)
+    report_queue_suspend(endpoint);
+#endif
 
     if (endpoint->report_storage != NULL) {
         endpoint->report_storage->reset_report(endpoint->report_storage->reports);
@@ -159,6 +203,9 @@ void usb_endpoint_out_suspend_cb(usb_endpoint_out_t *endpoint) {
 
 void usb_endpoint_in_wakeup_cb(usb_endpoint_in_t *endpoint) {
     bqResumeX(&endpoint->obqueue);
+#if defined(USB_REPORT_QUEUE_ENABLE)
+    usb_report_queue_resume(&endpoint->report_queue);
+#endif
 }
 
 void usb_endpoint_out_wakeup_cb(usb_endpoint_out_t *endpoint) {
@@ -169,6 +216,10 @@ void usb_endpoint_in_configure_cb(usb_endpoint_in_t *endpoint) {
     usbInitEndpointI(endpoint->config.usbp, endpoint->config.ep, &endpoint->ep_config);
     obqResetI(&endpoint->obqueue);
     bqResumeX(&endpoint->obqueue);
+#if defined(USB_REPORT_QUEUE_ENABLE)
+    usb_report_queue_reset(&endpoint->report_queue);
+    usb_report_queue_resume(&endpoint->report_queue);
+#endif
 }
 
 void usb_endpoint_out_configure_cb(usb_endpoint_out_t *endpoint) {
@@ -197,6 +248,21 @@ void usb_endpoint_in_tx_complete_cb(USBDriver *usbp, usbep_t ep) {
     /* Sending succeded, so we can reset the timed out state. */
     endpoint->timed_out = false;
 
+#if defined(USB_REPORT_QUEUE_ENABLE)
+    /* Releasing the report just transmitted and starting the next one
+     * straight away, the report queue never sends zero sized packets. */
+    buffer = usb_report_queue_in_flight(&endpoint->report_queue, &n);
+    if (buffer != NULL || !usb_report_queue_is_empty(&endpoint->report_queue)) {
+        if (buffer != NULL && endpoint->report_storage != NULL) {
+            endpoint->report_storage->set_report(endpoint->report_storage->reports, buffer, n);
+        }
+        usb_report_queue_complete(&endpoint->report_queue);
+        osalThreadDequeueNextI(&endpoint->report_waiting, MSG_OK);
+        osalSysUnlockFromISR();
+        return;
+    }
+#endif
+
     /* Freeing the buffer just transmitted, if it was not a zero size packet.*/
     if (!obqIsEmptyI(&endpoint->obqueue) && usbp->epc[ep]->in_state->txsize > 0U) {
         /* Store the last send report in the endpoint to be retrieved by a
@@ -269,6 +335,18 @@ bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size
     }
     osalSysUnlock();
 
+#if defined(USB_REPORT_QUEUE_ENABLE)
+    if (!buffered && uses_report_queue(endpoint)) {
+        uint8_t *slot = usb_endpoint_in_acquire(endpoint, timeout);
+        if (slot == NULL) {
+            return false;
+        }
+        memcpy(slot, data, size);
+        usb_endpoint_in_commit(endpoint, size);
+        return true;
+    }
+#endif
+
     while (true) {
         size_t sent = obqWriteTimeout(&endpoint->obqueue, data, size, timeout);
 
@@ -315,11 +393,71 @@ bool usb_endpoint_in_is_inactive(usb_endpoint_in_t *endpoint) {
 
     osalSysLock();
     bool inactive = obqIsEmptyI(&endpoint->obqueue) && !usbGetTransmitStatusI(endpoint->config.usbp, endpoint->config.ep);
+#if defined(USB_REPORT_QUEUE_ENABLE)
+    inactive = inactive && usb_report_queue_is_empty(&endpoint->report_queue);
+#endif
     osalSysUnlock();
 
     return inactive;
 }
 
+#if defined(USB_REPORT_QUEUE_ENABLE)
+/**
+ * @brief   Returns the report queue slot to write the next report into, for
+ *          interrupt endpoints. Fill it in place and hand it to the USB driver
+ *          with `usb_endpoint_in_commit`.
+ *
+ * @details If every slot is queued, waits up to `timeout` for one to be sent.
+ *          When that times out the queued reports are dropped, as nobody is
+ *          picking them up, and the endpoint stops waiting until it sends
+ *          again. The report in flight keeps its slot, as the USB driver may
+ *          still be reading it.
+ *
+ * @return  The slot, which holds up to the endpoint size, or NULL if the
+ *          endpoint is not active or no slot became free in time.
+ */
+uint8_t *usb_endpoint_in_acquire(usb_endpoint_in_t *endpoint, sysinterval_t timeout) {
+    osalDbgCheck(endpoint != NULL);
+
+    osalSysLock();
+    if (usbGetDriverStateI(endpoint->config.usbp) != USB_ACTIVE) {
+        osalSysUnlock();
+        return NULL;
+    }
+
+    if (endpoint->timed_out && timeout != TIME_INFINITE) {
+        timeout = TIME_IMMEDIATE;
+    }
+
+    uint8_t *slot;
+    while ((slot = usb_report_queue_acquire(&endpoint->report_queue)) == NULL && !endpoint->report_queue.suspended) {
+        if (osalThreadEnqueueTimeoutS(&endpoint->report_waiting, timeout) == MSG_TIMEOUT) {
+            endpoint->timed_out = true;
+            usb_report_queue_drop_pending(&endpoint->report_queue);
+            // Still NULL with a single slot, as the transfer in flight holds it
+            slot = usb_report_queue_acquire(&endpoint->report_queue);
+            break;
+        }
+    }
+    osalSysUnlock();
+
+    return slot;
+}
+
+/**
+ * @brief   Queues the report written to the slot returned by
+ *          `usb_endpoint_in_acquire`, sending it once the reports before it
+ *          have been sent.
+ */
+void usb_endpoint_in_commit(usb_endpoint_in_t *endpoint, size_t size) {
+    osalDbgCheck((endpoint != NULL) && (size > 0U) && (size <= endpoint->config.buffer_size));
+
+    osalSysLock();
+    usb_report_queue_commit(&endpoint->report_queue, size);
+    osalSysUnlock();
+}
+#endif
+
 bool usb_endpoint_out_receive(usb_endpoint_out_t *endpoint, uint8_t *data, size_t size, sysinterval_t timeout) {
     osalDbgCheck((endpoint != NULL) && (data != NULL) && (size > 0U));
 
@@ -12,11 +12,22 @@
 #include "usb_report_handling.h"
 #include "string.h"
 #include "timer.h"
+#if defined(USB_REPORT_QUEUE_ENABLE)
+#    include "usb_report_queue.h"
+#endif
 
 #if HAL_USE_USB == FALSE
 #    error "The USB Driver requires HAL_USE_USB"
 #endif
 
+/* IN endpoint buffers back either the output buffers queue or the report
+ * queue, whichever the endpoint is used with. */
+#if defined(USB_REPORT_QUEUE_ENABLE)
+#    define USB_IN_BUFFER_SIZE(capacity, size) USB_REPORT_QUEUE_BUFFER_SIZE(capacity, size)
+#else
+#    define USB_IN_BUFFER_SIZE(capacity, size) BQ_BUFFER_SIZE(capacity, size)
+#endif
+
 /* USB Low Level driver specific endpoint fields */
 #if !defined(usb_lld_endpoint_fields)
 #    define usb_lld_endpoint_fields   \
@@ -53,7 +64,7 @@
             .ep              = ep_num,                                                                  \
             .buffer_capacity = _buffer_capacity,                                                        \
             .buffer_size     = ep_size,                                                                 \
-            .buffer          = (_Alignas(4) uint8_t[BQ_BUFFER_SIZE(_buffer_capacity, ep_size)]){0},     \
+            .buffer          = (_Alignas(4) uint8_t[USB_IN_BUFFER_SIZE(_buffer_capacity, ep_size)]){0}, \
         }                                                                                               \
     }
 
@@ -104,7 +115,7 @@
                 .ep              = ep_num,                                                                         \
                 .buffer_capacity = _buffer_capacity,                                                               \
                 .buffer_size     = ep_size,                                                                        \
-                .buffer          = (_Alignas(4) uint8_t[BQ_BUFFER_SIZE(_buffer_capacity, ep_size)]){0},            \
+                .buffer          = (_Alignas(4) uint8_t[USB_IN_BUFFER_SIZE(_buffer_capacity, ep_size)]){0},        \
             }                                                                                                      \
         }
 
@@ -166,6 +177,10 @@ typedef struct {
     usbreqhandler_t       usb_requests_cb;
     bool                  timed_out;
     usb_report_storage_t *report_storage;
+#if defined(USB_REPORT_QUEUE_ENABLE)
+    usb_report_queue_t report_queue;
+    threads_queue_t    report_waiting;
+#endif
 } usb_endpoint_in_t;
 
 typedef struct {
@@ -188,6 +203,11 @@ bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size
 void usb_endpoint_in_flush(usb_endpoint_in_t *endpoint, bool padded);
 bool usb_endpoint_in_is_inactive(usb_endpoint_in_t *endpoint);
 
+#if defined(USB_REPORT_QUEUE_ENABLE)
+uint8_t *usb_endpoint_in_acquire(usb_endpoint_in_t *endpoint, sysinterval_t timeout);
+void     usb_endpoint_in_commit(usb_endpoint_in_t *endpoint, size_t size);
+#endif
+
 void usb_endpoint_in_suspend_cb(usb_endpoint_in_t *endpoint);
 void usb_endpoint_in_wakeup_cb(usb_endpoint_in_t *endpoint);
 void usb_endpoint_in_configure_cb(usb_endpoint_in_t *endpoint);
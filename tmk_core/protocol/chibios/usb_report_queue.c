@@ -0,0 +1,122 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "usb_report_queue.h"
+
+static inline uint8_t *slot_header(usb_report_queue_t *queue, uint8_t index) {
+    return &queue->buffer[index * queue->stride];
+}
+
+static inline uint8_t *slot_data(usb_report_queue_t *queue, uint8_t index) {
+    return slot_header(queue, index) + sizeof(size_t);
+}
+
+static inline size_t slot_length(usb_report_queue_t *queue, uint8_t index) {
+    return *(size_t *)slot_header(queue, index);
+}
+
+static inline uint8_t next_index(usb_report_queue_t *queue, uint8_t index) {
+    return (index + 1 == queue->capacity) ? 0 : index + 1;
+}
+
+static void usb_report_queue_start(usb_report_queue_t *queue) {
+    if (queue->busy || queue->suspended || usb_report_queue_is_empty(queue)) {
+        return;
+    }
+    queue->busy = queue->transmit(queue, slot_data(queue, queue->tail), slot_length(queue, queue->tail));
+}
+
+void usb_report_queue_init(usb_report_queue_t *queue, uint8_t *buffer, size_t slot_size, uint8_t capacity, usb_report_queue_transmit_t transmit, void *link) {
+    queue->buffer    = buffer;
+    queue->slot_size = slot_size;
+    queue->stride    = USB_REPORT_QUEUE_SLOT_STRIDE(slot_size);
+    queue->capacity  = capacity;
+    queue->transmit  = transmit;
+    queue->link      = link;
+    queue->suspended = true;
+    usb_report_queue_reset(queue);
+}
+
+/**
+ * @brief Returns the slot to fill with the next report, or NULL if every slot
+ * is queued or the queue is suspended. Until it is committed, the same slot is
+ * returned again.
+ */
+uint8_t *usb_report_queue_acquire(usb_report_queue_t *queue) {
+    if (queue->suspended || usb_report_queue_is_full(queue)) {
+        return NULL;
+    }
+    return slot_data(queue, queue->head);
+}
+
+/**
+ * @brief Queues the acquired slot holding a report of `size` bytes, starting
+ * its transfer if the endpoint is idle.
+ */
+void usb_report_queue_commit(usb_report_queue_t *queue, size_t size) {
+    if (queue->suspended || usb_report_queue_is_full(queue)) {
+        return;
+    }
+    *(size_t *)slot_header(queue, queue->head) = size < queue->slot_size ? size : queue->slot_size;
+    queue->head                                = next_index(queue, queue->head);
+    queue->count++;
+    usb_report_queue_start(queue);
+}
+
+/**
+ * @brief Returns the slot currently being transferred, or NULL if none is.
+ */
+uint8_t *usb_report_queue_in_flight(usb_report_queue_t *queue, size_t *size) {
+    if (!queue->busy) {
+        return NULL;
+    }
+    *size = slot_length(queue, queue->tail);
+    return slot_data(queue, queue->tail);
+}
+
+/**
+ * @brief Called whenever a transfer on the endpoint completes. Releases the
+ * slot that was just transferred, if it came from this queue, and starts the
+ * next one.
+ */
+void usb_report_queue_complete(usb_report_queue_t *queue) {
+    if (queue->busy) {
+        queue->busy = false;
+        queue->tail = next_index(queue, queue->tail);
+        queue->count--;
+    }
+    usb_report_queue_start(queue);
+}
+
+/**
+ * @brief Drops every queued report. The driver must have aborted any transfer
+ * in flight.
+ */
+void usb_report_queue_reset(usb_report_queue_t *queue) {
+    queue->head  = 0;
+    queue->tail  = 0;
+    queue->count = 0;
+    queue->busy  = false;
+}
+
+/**
+ * @brief Drops every queued report except the one in flight, whose slot the
+ * driver still owns until its transfer completes.
+ */
+void usb_report_queue_drop_pending(usb_report_queue_t *queue) {
+    if (!queue->busy) {
+        usb_report_queue_reset(queue);
+        return;
+    }
+    queue->head  = next_index(queue, queue->tail);
+    queue->count = 1;
+}
+
+void usb_report_queue_suspend(usb_report_queue_t *queue) {
+    usb_report_queue_reset(queue);
+    queue->suspended = true;
+}
+
+void usb_report_queue_resume(usb_report_queue_t *queue) {
+    queue->suspended = false;
+}
@@ -0,0 +1,77 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * A ring of fixed size report slots for one IN endpoint. The sender fills the
+ * slot returned by `usb_report_queue_acquire` in place and commits it; the
+ * slot memory is then handed to the USB driver as is, without copying. When a
+ * transfer completes, the next committed slot is started straight away, so
+ * reports queued while the endpoint was busy go out back to back.
+ *
+ * Each slot holds its report length in a size_t header followed by the report
+ * data, so the data of every slot stays aligned if the buffer is.
+ *
+ * The queue itself does no locking: commit, complete and reset must not run
+ * concurrently, i.e. the sender calls them with interrupts locked and the
+ * driver from its completion interrupt. Acquire and filling the slot may run
+ * unlocked, as the driver never touches uncommitted slots.
+ */
+
+#define USB_REPORT_QUEUE_SLOT_STRIDE(size) (sizeof(size_t) + (((size_t)(size) + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1)))
+#define USB_REPORT_QUEUE_BUFFER_SIZE(capacity, size) (USB_REPORT_QUEUE_SLOT_STRIDE(size) * (size_t)(capacity))
+
+typedef struct usb_report_queue_t usb_report_queue_t;
+
+/**
+ * @brief Starts the transfer of a committed slot.
+ *
+ * @return false if the endpoint can't send right now, the slot then stays
+ * queued and is retried on the next commit.
+ */
+typedef bool (*usb_report_queue_transmit_t)(usb_report_queue_t *queue, uint8_t *data, size_t size);
+
+struct usb_report_queue_t {
+    uint8_t                    *buffer;
+    size_t                      slot_size;
+    size_t                      stride;
+    uint8_t                     capacity;
+    uint8_t                     head;  // next slot to be filled
+    uint8_t                     tail;  // oldest committed slot, in flight while busy
+    uint8_t                     count; // committed slots, including the one in flight
+    bool                        busy;
+    bool                        suspended;
+    usb_report_queue_transmit_t transmit;
+    void                       *link;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void     usb_report_queue_init(usb_report_queue_t *queue, uint8_t *buffer, size_t slot_size, uint8_t capacity, usb_report_queue_transmit_t transmit, void *link);
+uint8_t *usb_report_queue_acquire(usb_report_queue_t *queue);
+void     usb_report_queue_commit(usb_report_queue_t *queue, size_t size);
+uint8_t *usb_report_queue_in_flight(usb_report_queue_t *queue, size_t *size);
+void     usb_report_queue_complete(usb_report_queue_t *queue);
+void     usb_report_queue_reset(usb_report_queue_t *queue);
+void     usb_report_queue_drop_pending(usb_report_queue_t *queue);
+void     usb_report_queue_suspend(usb_report_queue_t *queue);
+void     usb_report_queue_resume(usb_report_queue_t *queue);
+
+static inline bool usb_report_queue_is_empty(const usb_report_queue_t *queue) {
+    return queue->count == 0;
+}
+
+static inline bool usb_report_queue_is_full(const usb_report_queue_t *queue) {
+    return queue->count == queue->capacity;
+}
+
+#ifdef __cplusplus
+}
+#endif
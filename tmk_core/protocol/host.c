@@ -16,6 +16,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <stdint.h>
+#include <string.h>
 #include "keyboard.h"
 #include "keycode.h"
 #include "action.h"
@@ -23,6 +24,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "util.h"
 #include "debug.h"
 #include "usb_device_state.h"
+#include "timer.h"
 
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
@@ -36,6 +38,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "connection.h"
 #endif
 
+#ifdef LATENCY_STATS_ENABLE
+#    include "latency_stats.h"
+#else
+#    define latency_stats_report_queued()
+#    define latency_stats_report_sent()
+#endif
+
 #ifdef BLUETOOTH_ENABLE
 #    include "bluetooth.h"
 
@@ -71,8 +80,15 @@ static host_driver_t *driver;
 static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
 
+#ifdef REPORT_COALESCING_ENABLE
+static void host_coalescing_reset(void);
+#endif
+
 void host_set_driver(host_driver_t *d) {
     driver = d;
+#ifdef REPORT_COALESCING_ENABLE
+    host_coalescing_reset();
+#endif
 }
 
 host_driver_t *host_get_driver(void) {
@@ -97,6 +113,12 @@ static void host_update_active_driver(connection_host_t current, connection_host
         clear_keyboard();
     }
 
+#    ifdef REPORT_COALESCING_ENABLE
+    // The previous host still gets the released keys, anything remembered after that was meant for it alone
+    host_flush_reports();
+    host_coalescing_reset();
+#    endif
+
     host_connect_active_driver_user(next);
     host_connect_active_driver_kb(next);
 }
@@ -174,14 +196,16 @@ led_t host_keyboard_led_state(void) {
 }
 
 /* send report */
-void host_keyboard_send(report_keyboard_t *report) {
+static void host_keyboard_send_now(report_keyboard_t *report) {
     host_driver_t *driver = host_get_active_driver();
     if (!driver || !driver->send_keyboard) return;
 
 #ifdef KEYBOARD_SHARED_EP
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
+    latency_stats_report_queued();
     (*driver->send_keyboard)(report);
+    latency_stats_report_sent();
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);
@@ -192,12 +216,14 @@ void host_keyboard_send(report_keyboard_t *report) {
     }
 }
 
-void host_nkro_send(report_nkro_t *report) {
+static void host_nkro_send_now(report_nkro_t *report) {
     host_driver_t *driver = host_get_active_driver();
     if (!driver || !driver->send_nkro) return;
 
     report->report_id = REPORT_ID_NKRO;
+    latency_stats_report_queued();
     (*driver->send_nkro)(report);
+    latency_stats_report_sent();
 
     if (debug_keyboard) {
         dprintf("nkro_report: %02X | ", report->mods);
@@ -208,7 +234,7 @@ void host_nkro_send(report_nkro_t *report) {
     }
 }
 
-void host_mouse_send(report_mouse_t *report) {
+static void host_mouse_send_now(report_mouse_t *report) {
     host_driver_t *driver = host_get_active_driver();
     if (!driver || !driver->send_mouse) return;
 
@@ -223,7 +249,260 @@ void host_mouse_send(report_mouse_t *report) {
     (*driver->send_mouse)(report);
 }
 
+#ifdef REPORT_COALESCING_ENABLE
+/* Report coalescing
+ *
+ * Keyboard, NKRO and mouse reports are held back until the end of the scan, so that reports produced by the same scan
+ * can be merged. A held back report is replaced by a newer one of the same kind only if no key, modifier or button
+ * would change state twice -- a tap within one scan still reaches the host as a press and a release, in order.
+ * Reports identical to what the host already has are dropped. Reports of different kinds are sent in the order they
+ * were produced.
+ */
+typedef enum {
+    HOST_REPORT_NONE,
+    HOST_REPORT_KEYBOARD,
+    HOST_REPORT_NKRO,
+    HOST_REPORT_MOUSE,
+} host_report_kind_t;
+
+static struct {
+    host_report_kind_t pending_kind;
+    union {
+        report_keyboard_t keyboard;
+        report_nkro_t     nkro;
+        report_mouse_t    mouse;
+    } pending;
+    // The last report of each kind the host was sent, zeroed when nothing has been sent
+    report_keyboard_t last_keyboard;
+    report_nkro_t     last_nkro;
+    report_mouse_t    last_mouse;
+#    ifdef REPORT_COALESCING_USB_FRAME
+    uint16_t last_sent_time;
+#    endif
+} coalescing;
+
+static host_report_stats_t report_stats;
+
+static void host_coalescing_reset(void) {
+    memset(&coalescing, 0, sizeof(coalescing));
+}
+
+static void host_send_pending(void) {
+    switch (coalescing.pending_kind) {
+        case HOST_REPORT_KEYBOARD:
+            host_keyboard_send_now(&coalescing.pending.keyboard);
+            coalescing.last_keyboard = coalescing.pending.keyboard;
+            break;
+        case HOST_REPORT_NKRO:
+            host_nkro_send_now(&coalescing.pending.nkro);
+            coalescing.last_nkro = coalescing.pending.nkro;
+            break;
+        case HOST_REPORT_MOUSE:
+            host_mouse_send_now(&coalescing.pending.mouse);
+            coalescing.last_mouse = coalescing.pending.mouse;
+            break;
+        default:
+            return;
+    }
+    coalescing.pending_kind = HOST_REPORT_NONE;
+    report_stats.sent++;
+#    ifdef REPORT_COALESCING_USB_FRAME
+    coalescing.last_sent_time = timer_read();
+#    endif
+}
+
+static bool keyboard_report_has_key(const report_keyboard_t *report, uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Whether going straight from the last sent report to `next` loses none of the changes made by `pending`
+static bool keyboard_reports_mergeable(const report_keyboard_t *last, const report_keyboard_t *pending, const report_keyboard_t *next) {
+    if ((last->mods ^ pending->mods) & (pending->mods ^ next->mods)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t pressed  = pending->keys[i];
+        uint8_t released = last->keys[i];
+        // A key pressed by the pending report must still be held, and one it released must still be released
+        if (pressed && !keyboard_report_has_key(last, pressed) && !keyboard_report_has_key(next, pressed)) {
+            return false;
+        }
+        if (released && !keyboard_report_has_key(pending, released) && keyboard_report_has_key(next, released)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool nkro_reports_mergeable(const report_nkro_t *last, const report_nkro_t *pending, const report_nkro_t *next) {
+    if ((last->mods ^ pending->mods) & (pending->mods ^ next->mods)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+        if ((last->bits[i] ^ pending->bits[i]) & (pending->bits[i] ^ next->bits[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool mouse_report_has_motion(const report_mouse_t *report) {
+    return report->x || report->y || report->h || report->v;
+}
+
+// Motion is summed, as long as the buttons don't change and the totals still fit in a report
+static bool mouse_reports_merge(report_mouse_t *pending, const report_mouse_t *next) {
+    if (pending->buttons != coalescing.last_mouse.buttons || next->buttons != pending->buttons) {
+        return false;
+    }
+    int32_t x = (int32_t)pending->x + next->x;
+    int32_t y = (int32_t)pending->y + next->y;
+    int32_t h = (int32_t)pending->h + next->h;
+    int32_t v = (int32_t)pending->v + next->v;
+    if (x < MOUSE_REPORT_XY_MIN || x > MOUSE_REPORT_XY_MAX || y < MOUSE_REPORT_XY_MIN || y > MOUSE_REPORT_XY_MAX || h < MOUSE_REPORT_HV_MIN || h > MOUSE_REPORT_HV_MAX || v < MOUSE_REPORT_HV_MIN || v > MOUSE_REPORT_HV_MAX) {
+        return false;
+    }
+    pending->x = x;
+    pending->y = y;
+    pending->h = h;
+    pending->v = v;
+    return true;
+}
+
+// Whether `next` tells the host nothing it doesn't already have from `current`
+static bool host_report_is_redundant(host_report_kind_t kind, const void *current, const void *next) {
+    switch (kind) {
+        case HOST_REPORT_KEYBOARD: {
+            const report_keyboard_t *a = current, *b = next;
+            return a->mods == b->mods && memcmp(a->keys, b->keys, sizeof(a->keys)) == 0;
+        }
+        case HOST_REPORT_NKRO: {
+            const report_nkro_t *a = current, *b = next;
+            return a->mods == b->mods && memcmp(a->bits, b->bits, sizeof(a->bits)) == 0;
+        }
+        case HOST_REPORT_MOUSE: {
+            const report_mouse_t *a = current, *b = next;
+            return a->buttons == b->buttons && !mouse_report_has_motion(b);
+        }
+        default:
+            return false;
+    }
+}
+
+// Decides what to do with a new report, returning true if it should become the pending report
+static bool host_coalesce(host_report_kind_t kind, const void *report, const void *last) {
+    report_stats.submitted++;
+
+    bool same_kind = coalescing.pending_kind == kind;
+    if (host_report_is_redundant(kind, same_kind ? (const void *)&coalescing.pending : last, report)) {
+        report_stats.duplicates++;
+        return false;
+    }
+
+    if (same_kind) {
+        switch (kind) {
+            case HOST_REPORT_KEYBOARD:
+                if (keyboard_reports_mergeable(last, &coalescing.pending.keyboard, report)) {
+                    report_stats.merged++;
+                    return true;
+                }
+                break;
+            case HOST_REPORT_NKRO:
+                if (nkro_reports_mergeable(last, &coalescing.pending.nkro, report)) {
+                    report_stats.merged++;
+                    return true;
+                }
+                break;
+            case HOST_REPORT_MOUSE:
+                if (mouse_reports_merge(&coalescing.pending.mouse, report)) {
+                    report_stats.merged++;
+                    return false;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    host_send_pending();
+    return true;
+}
+
+void host_flush_reports(void) {
+    host_send_pending();
+}
+
+void host_report_coalescing_task(void) {
+#    ifdef REPORT_COALESCING_USB_FRAME
+    // The host polls at most once per frame, so keep merging until the frame after the last report
+    if (coalescing.pending_kind != HOST_REPORT_NONE && timer_read() == coalescing.last_sent_time) {
+        return;
+    }
+#    endif
+    host_send_pending();
+}
+
+void host_get_report_stats(host_report_stats_t *stats) {
+    *stats = report_stats;
+}
+
+void host_reset_report_stats(void) {
+    memset(&report_stats, 0, sizeof(report_stats));
+}
+
+void host_keyboard_send(report_keyboard_t *report) {
+    host_driver_t *driver = host_get_active_driver();
+    if (!driver || !driver->send_keyboard) return;
+
+    if (host_coalesce(HOST_REPORT_KEYBOARD, report, &coalescing.last_keyboard)) {
+        coalescing.pending_kind     = HOST_REPORT_KEYBOARD;
+        coalescing.pending.keyboard = *report;
+    }
+}
+
+void host_nkro_send(report_nkro_t *report) {
+    host_driver_t *driver = host_get_active_driver();
+    if (!driver || !driver->send_nkro) return;
+
+    if (host_coalesce(HOST_REPORT_NKRO, report, &coalescing.last_nkro)) {
+        coalescing.pending_kind = HOST_REPORT_NKRO;
+        coalescing.pending.nkro = *report;
+    }
+}
+
+void host_mouse_send(report_mouse_t *report) {
+    host_driver_t *driver = host_get_active_driver();
+    if (!driver || !driver->send_mouse) return;
+
+    if (host_coalesce(HOST_REPORT_MOUSE, report, &coalescing.last_mouse)) {
+        coalescing.pending_kind  = HOST_REPORT_MOUSE;
+        coalescing.pending.mouse = *report;
+    }
+}
+#else
+static inline void host_send_pending(void) {}
+
+void host_keyboard_send(report_keyboard_t *report) {
+    host_keyboard_send_now(report);
+}
+
+void host_nkro_send(report_nkro_t *report) {
+    host_nkro_send_now(report);
+}
+
+void host_mouse_send(report_mouse_t *report) {
+    host_mouse_send_now(report);
+}
+#endif
+
+// Reports of other kinds aren't coalesced, but must not overtake a held back one
 void host_system_send(uint16_t usage) {
+    host_send_pending();
     if (usage == last_system_usage) return;
     last_system_usage = usage;
 
@@ -238,6 +517,7 @@ void host_system_send(uint16_t usage) {
 }
 
 void host_consumer_send(uint16_t usage) {
+    host_send_pending();
     if (usage == last_consumer_usage) return;
     last_consumer_usage = usage;
 
@@ -253,6 +533,7 @@ void host_consumer_send(uint16_t usage) {
 
 #ifdef JOYSTICK_ENABLE
 void host_joystick_send(joystick_t *joystick) {
+    host_send_pending();
     if (!driver) return;
 
     report_joystick_t report = {
@@ -312,6 +593,8 @@ __attribute__((weak)) void send_joystick(report_joystick_t *report) {}
 
 #ifdef DIGITIZER_ENABLE
 void host_digitizer_send(digitizer_t *digitizer) {
+    host_send_pending();
+
     report_digitizer_t report = {
 #    ifdef DIGITIZER_SHARED_EP
         .report_id = REPORT_ID_DIGITIZER,
@@ -331,6 +614,8 @@ __attribute__((weak)) void send_digitizer(report_digitizer_t *report) {}
 
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
 void host_programmable_button_send(uint32_t data) {
+    host_send_pending();
+
     report_programmable_button_t report = {
         .report_id = REPORT_ID_PROGRAMMABLE_BUTTON,
         .usage     = data,
@@ -344,6 +629,8 @@ __attribute__((weak)) void send_programmable_button(report_programmable_button_t
 
 #ifdef RAW_ENABLE
 void host_raw_hid_send(uint8_t *data, uint8_t length) {
+    host_send_pending();
+
     host_driver_t *driver = host_get_active_driver();
     if (!driver || !driver->send_raw_hid) return;
 
@@ -49,6 +49,25 @@ void    host_raw_hid_send(uint8_t *data, uint8_t length);
 uint16_t host_last_system_usage(void);
 uint16_t host_last_consumer_usage(void);
 
+#ifdef REPORT_COALESCING_ENABLE
+typedef struct {
+    uint32_t submitted;  // reports passed to host_keyboard_send(), host_nkro_send() or host_mouse_send()
+    uint32_t sent;       // reports passed on to the host driver
+    uint32_t merged;     // reports that replaced, or were added to, one not yet sent
+    uint32_t duplicates; // reports dropped as the host already had their contents
+} host_report_stats_t;
+
+/* Sends any report held back for coalescing -- call before waiting, so that the host sees the delay */
+void host_flush_reports(void);
+/* Sends any report held back for coalescing, at the end of each scan */
+void host_report_coalescing_task(void);
+
+void host_get_report_stats(host_report_stats_t *stats);
+void host_reset_report_stats(void);
+#else
+static inline void host_flush_reports(void) {}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
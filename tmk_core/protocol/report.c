@@ -21,39 +21,66 @@
 #include "debug.h"
 #include "usb_device_state.h"
 #include "util.h"
+#include <limits.h>
 #include <string.h>
 
+#ifdef NKRO_ENABLE
+// Number of keys set in nkro_report, kept up to date by add/del/clear_keys_from_report
+static uint8_t nkro_key_count = 0;
+
+// Four bytes of the NKRO bitmap as one word, with key (index << 3) in bit 0.
+// The last word is zero-padded rather than the report, whose size the host expects to match the descriptor.
+static inline uint32_t nkro_bits_word(const report_nkro_t* nkro_report, uint8_t index) {
+    uint32_t word = 0;
+    memcpy(&word, &nkro_report->bits[index], MIN(sizeof(word), (uint8_t)(NKRO_REPORT_BITS - index)));
+#    if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap32(word);
+#    endif
+    return word;
+}
+
+// Trailing zeros of a 32-bit word; int is only 16 bits wide on AVR
+#    if UINT_MAX >= UINT32_MAX
+#        define nkro_bits_ctz(word) __builtin_ctz(word)
+#    else
+#        define nkro_bits_ctz(word) __builtin_ctzl(word)
+#    endif
+#endif
+
 /** \brief has_anykey
  *
- * FIXME: Needs doc
+ * Returns the number of keys (not modifiers) held in the current report
  */
 uint8_t has_anykey(void) {
-    uint8_t  cnt = 0;
-    uint8_t* p   = keyboard_report->keys;
-    uint8_t  lp  = sizeof(keyboard_report->keys);
 #ifdef NKRO_ENABLE
     if (host_can_send_nkro() && keymap_config.nkro) {
-        p  = nkro_report->bits;
-        lp = sizeof(nkro_report->bits);
+        return nkro_key_count;
     }
 #endif
-    while (lp--) {
-        if (*p++) cnt++;
+    uint8_t cnt = 0;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (keyboard_report->keys[i]) cnt++;
     }
     return cnt;
 }
 
 /** \brief get_first_key
  *
- * FIXME: Needs doc
+ * Returns the key in the first slot of the 6KRO report. With NKRO, returns the
+ * highest key of the lowest byte of the bitmap that has any key set, or KC_NO
+ * if none is held.
  */
 uint8_t get_first_key(void) {
 #ifdef NKRO_ENABLE
     if (host_can_send_nkro() && keymap_config.nkro) {
-        uint8_t i = 0;
-        for (; i < NKRO_REPORT_BITS && !nkro_report->bits[i]; i++)
-            ;
-        return i << 3 | biton(nkro_report->bits[i]);
+        for (uint8_t i = 0; i < NKRO_REPORT_BITS; i += 4) {
+            uint32_t word = nkro_bits_word(nkro_report, i);
+            if (word) {
+                uint8_t index = i + nkro_bits_ctz(word) / 8;
+                return index << 3 | biton(nkro_report->bits[index]);
+            }
+        }
+        return KC_NO;
     }
 #endif
     return keyboard_report->keys[0];
@@ -87,7 +114,10 @@ bool is_key_pressed(uint8_t key) {
 
 /** \brief add key byte
  *
- * FIXME: Needs doc
+ * Adds a key to a 6KRO report. Keys keep the slot they were given until they
+ * are released, and a new key takes the lowest free slot, so adding or
+ * removing one key never moves the others. Keys already in the report, or
+ * added while all slots are taken, are ignored.
  */
 void add_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
     int8_t i     = 0;
@@ -109,7 +139,7 @@ void add_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
 
 /** \brief del key byte
  *
- * FIXME: Needs doc
+ * Removes a key from a 6KRO report, leaving its slot free
  */
 void del_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
     for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
@@ -122,25 +152,31 @@ void del_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
 #ifdef NKRO_ENABLE
 /** \brief add key bit
  *
- * FIXME: Needs doc
+ * Sets a key in an NKRO report, returning whether it wasn't set before
  */
-void add_key_bit(report_nkro_t* nkro_report, uint8_t code) {
+bool add_key_bit(report_nkro_t* nkro_report, uint8_t code) {
     if ((code >> 3) < NKRO_REPORT_BITS) {
+        uint8_t bits = nkro_report->bits[code >> 3];
         nkro_report->bits[code >> 3] |= 1 << (code & 7);
+        return bits != nkro_report->bits[code >> 3];
     } else {
         dprintf("add_key_bit: can't add: %02X\n", code);
+        return false;
     }
 }
 
 /** \brief del key bit
  *
- * FIXME: Needs doc
+ * Clears a key in an NKRO report, returning whether it was set before
  */
-void del_key_bit(report_nkro_t* nkro_report, uint8_t code) {
+bool del_key_bit(report_nkro_t* nkro_report, uint8_t code) {
     if ((code >> 3) < NKRO_REPORT_BITS) {
+        uint8_t bits = nkro_report->bits[code >> 3];
         nkro_report->bits[code >> 3] &= ~(1 << (code & 7));
+        return bits != nkro_report->bits[code >> 3];
     } else {
         dprintf("del_key_bit: can't del: %02X\n", code);
+        return false;
     }
 }
 #endif
@@ -152,7 +188,7 @@ void del_key_bit(report_nkro_t* nkro_report, uint8_t code) {
 void add_key_to_report(uint8_t key) {
 #ifdef NKRO_ENABLE
     if (host_can_send_nkro() && keymap_config.nkro) {
-        add_key_bit(nkro_report, key);
+        nkro_key_count += add_key_bit(nkro_report, key);
         return;
     }
 #endif
@@ -166,7 +202,7 @@ void add_key_to_report(uint8_t key) {
 void del_key_from_report(uint8_t key) {
 #ifdef NKRO_ENABLE
     if (host_can_send_nkro() && keymap_config.nkro) {
-        del_key_bit(nkro_report, key);
+        nkro_key_count -= del_key_bit(nkro_report, key);
         return;
     }
 #endif
@@ -182,6 +218,7 @@ void clear_keys_from_report(void) {
 #ifdef NKRO_ENABLE
     if (host_can_send_nkro() && keymap_config.nkro) {
         memset(nkro_report->bits, 0, sizeof(nkro_report->bits));
+        nkro_key_count = 0;
         return;
     }
 #endif
@@ -0,0 +1,230 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <random>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "report.h"
+#include "action_util.h"
+#include "keycode_config.h"
+#include "bitwise.h"
+
+static report_keyboard_t keyboard_report_storage;
+static report_nkro_t     nkro_report_storage;
+
+report_keyboard_t *keyboard_report = &keyboard_report_storage;
+report_nkro_t     *nkro_report     = &nkro_report_storage;
+keymap_config_t    keymap_config;
+
+bool host_can_send_nkro(void) {
+    return true;
+}
+}
+
+// The report functions as they were before the word-wide NKRO operations, to check against
+namespace reference {
+
+uint8_t has_anykey(const uint8_t *p, uint8_t lp) {
+    uint8_t cnt = 0;
+    while (lp--) {
+        if (*p++) cnt++;
+    }
+    return cnt;
+}
+
+uint8_t get_first_key(const report_nkro_t &report) {
+    uint8_t i = 0;
+    for (; i < NKRO_REPORT_BITS && !report.bits[i]; i++)
+        ;
+    return i << 3 | biton(report.bits[i]);
+}
+
+void add_key_byte(report_keyboard_t &report, uint8_t code) {
+    int8_t i     = 0;
+    int8_t empty = -1;
+    for (; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report.keys[i] == code) {
+            break;
+        }
+        if (empty == -1 && report.keys[i] == 0) {
+            empty = i;
+        }
+    }
+    if (i == KEYBOARD_REPORT_KEYS) {
+        if (empty != -1) {
+            report.keys[empty] = code;
+        }
+    }
+}
+
+void del_key_byte(report_keyboard_t &report, uint8_t code) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report.keys[i] == code) {
+            report.keys[i] = 0;
+        }
+    }
+}
+
+void add_key_bit(report_nkro_t &report, uint8_t code) {
+    if ((code >> 3) < NKRO_REPORT_BITS) {
+        report.bits[code >> 3] |= 1 << (code & 7);
+    }
+}
+
+void del_key_bit(report_nkro_t &report, uint8_t code) {
+    if ((code >> 3) < NKRO_REPORT_BITS) {
+        report.bits[code >> 3] &= ~(1 << (code & 7));
+    }
+}
+
+uint8_t key_count(const report_nkro_t &report) {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+        count += bitpop(report.bits[i]);
+    }
+    return count;
+}
+
+} // namespace reference
+
+class KeyboardReport : public ::testing::Test {
+   protected:
+    report_keyboard_t expected_keyboard = {};
+    report_nkro_t     expected_nkro     = {};
+
+    void TearDown() override {
+        set_nkro(true);
+        clear_keys_from_report();
+        set_nkro(false);
+        clear_keys_from_report();
+    }
+
+    void set_nkro(bool nkro) {
+        keymap_config.nkro = nkro;
+    }
+
+    void add(uint8_t code) {
+        add_key_to_report(code);
+        if (keymap_config.nkro) {
+            reference::add_key_bit(expected_nkro, code);
+        } else {
+            reference::add_key_byte(expected_keyboard, code);
+        }
+    }
+
+    void del(uint8_t code) {
+        del_key_from_report(code);
+        if (keymap_config.nkro) {
+            reference::del_key_bit(expected_nkro, code);
+        } else {
+            reference::del_key_byte(expected_keyboard, code);
+        }
+    }
+
+    void clear() {
+        clear_keys_from_report();
+        memset(expected_keyboard.keys, 0, sizeof(expected_keyboard.keys));
+        memset(expected_nkro.bits, 0, sizeof(expected_nkro.bits));
+    }
+
+    void expect_matches_reference() {
+        if (keymap_config.nkro) {
+            ASSERT_EQ(memcmp(nkro_report->bits, expected_nkro.bits, sizeof(expected_nkro.bits)), 0);
+            uint8_t count = reference::key_count(expected_nkro);
+            ASSERT_EQ(has_anykey(), count);
+            ASSERT_EQ(has_anykey() != 0, reference::has_anykey(expected_nkro.bits, sizeof(expected_nkro.bits)) != 0);
+            if (count) {
+                ASSERT_EQ(get_first_key(), reference::get_first_key(expected_nkro));
+            } else {
+                ASSERT_EQ(get_first_key(), KC_NO);
+            }
+        } else {
+            ASSERT_EQ(memcmp(keyboard_report->keys, expected_keyboard.keys, sizeof(expected_keyboard.keys)), 0);
+            ASSERT_EQ(has_anykey(), reference::has_anykey(expected_keyboard.keys, sizeof(expected_keyboard.keys)));
+            ASSERT_EQ(get_first_key(), expected_keyboard.keys[0]);
+        }
+    }
+
+    // Mostly a handful of keys, so that reports fill up and keys get released
+    // while held, with the occasional key from anywhere in the range
+    void run_random_events(uint32_t seed, uint32_t events) {
+        std::mt19937 rng(seed);
+        for (uint32_t i = 0; i < events; ++i) {
+            uint8_t  code   = (rng() % 8) ? KC_A + rng() % 12 : rng() % 256;
+            uint32_t action = rng() % 16;
+            if (action == 0) {
+                clear();
+            } else if (action <= 8) {
+                add(code);
+            } else {
+                del(code);
+            }
+            expect_matches_reference();
+            if (HasFatalFailure()) {
+                FAIL() << "event " << i << " with seed " << seed;
+            }
+        }
+    }
+};
+
+TEST_F(KeyboardReport, SixKroMatchesReference) {
+    set_nkro(false);
+    run_random_events(1, 100000);
+}
+
+TEST_F(KeyboardReport, SixKroKeysKeepTheirSlots) {
+    set_nkro(false);
+    add(KC_A);
+    add(KC_B);
+    add(KC_C);
+    del(KC_B);
+    add(KC_D);
+    EXPECT_EQ(keyboard_report->keys[0], KC_A);
+    EXPECT_EQ(keyboard_report->keys[1], KC_D);
+    EXPECT_EQ(keyboard_report->keys[2], KC_C);
+    expect_matches_reference();
+}
+
+TEST_F(KeyboardReport, NkroMatchesReference) {
+    set_nkro(true);
+    run_random_events(2, 100000);
+}
+
+TEST_F(KeyboardReport, NkroEveryKey) {
+    set_nkro(true);
+    for (uint16_t code = 0; code <= 0xFF; ++code) {
+        add(code);
+        expect_matches_reference();
+        add(code);
+        expect_matches_reference();
+        del(code);
+        expect_matches_reference();
+    }
+}
+
+TEST_F(KeyboardReport, NkroEveryPairOfKeys) {
+    set_nkro(true);
+    for (uint16_t first = 0; first < NKRO_REPORT_BITS * 8; ++first) {
+        for (uint16_t second = 0; second < NKRO_REPORT_BITS * 8; ++second) {
+            add(first);
+            add(second);
+            expect_matches_reference();
+            del(first);
+            expect_matches_reference();
+            clear();
+        }
+    }
+}
+
+TEST_F(KeyboardReport, NkroCountFollowsAllKeys) {
+    set_nkro(true);
+    for (uint16_t code = 0; code < NKRO_REPORT_BITS * 8; ++code) {
+        add(code);
+    }
+    EXPECT_EQ(has_anykey(), NKRO_REPORT_BITS * 8);
+    clear();
+    EXPECT_EQ(has_anykey(), 0);
+    EXPECT_EQ(get_first_key(), KC_NO);
+}
@@ -0,0 +1,8 @@
+report_DEFS := -DNKRO_ENABLE
+report_SRC := \
+	$(TMK_PATH)/protocol/report.c \
+	$(QUANTUM_PATH)/bitwise.c \
+	$(QUANTUM_PATH)/logging/debug.c \
+	$(TMK_PATH)/protocol/tests/report_tests.cpp
+report_INC := \
+	$(TMK_PATH)/protocol
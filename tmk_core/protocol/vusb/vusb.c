@@ -139,6 +139,9 @@ static void send_report(uint8_t endpoint, void *report, size_t size) {
  * RAW HID
  *------------------------------------------------------------------*/
 #ifdef RAW_ENABLE
+#    ifdef RAW_EPSIZE
+#        error RAW_EPSIZE cannot be changed for V-USB, raw HID reports are always 32 bytes
+#    endif
 #    define RAW_BUFFER_SIZE 32
 #    define RAW_EPSIZE 8
 